@@ -1,26 +1,307 @@
 #include "Database.h"
 #include "DbResult.h"
+#include "DatabaseOptions.h"
 #include "SchemaManager.h"
+#include "CsvImporter.h"
+#include "ComponentExporter.h"
+#include "DatasetGenerator.h"
+#include "DatabaseBackup.h"
+#include "QueryProfiler.h"
 #include "ConsoleUtils.h"
 
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
-int main() {
+namespace {
+
+void printUsage(const char* argv0)
+{
+    std::cerr
+        << "Usage:\n"
+        << "  " << argv0 << " [--db <file>]\n"
+        << "      Create or migrate the inventory database (default inventory.db).\n"
+        << "  " << argv0 << " [--db <file>] import <csv> [--threads <n>] [--batch <rows>]\n"
+        << "      [--delimiter <c>] [--add-missing] [--live-search-index]\n"
+        << "      Bulk-import components from CSV. --add-missing creates unknown\n"
+        << "      category, manufacturer and package names instead of rejecting the row.\n"
+        << "      The search index is rebuilt once after the load unless\n"
+        << "      --live-search-index keeps it updated row by row.\n"
+        << "  " << argv0 << " [--db <file>] export <file|-> [--format csv|jsonl] [--delimiter <c>]\n"
+        << "      Stream every component with its subtype attributes to CSV or\n"
+        << "      JSON Lines ('-' writes to stdout). The format defaults to jsonl\n"
+        << "      for a .jsonl file name and csv otherwise.\n"
+        << "  " << argv0 << " [--db <file>] generate <rows> [--seed <n>] [--batch <rows>]\n"
+        << "      Append synthetic components across every category. The same\n"
+        << "      seed and row count always produce the same rows (default seed 1).\n"
+        << "  " << argv0 << " [--db <file>] backup <file> [--compact]\n"
+        << "      Copy the database while other programs keep using it. --compact\n"
+        << "      writes a vacuumed copy instead (smaller, but in a single pass).\n"
+        << "\n"
+        << "  --profile <json> with any command but backup writes per-statement timings\n"
+        << "  (calls, rows, total/p50/p99 time, full-scan steps, sorts) to <json>.\n"
+        << "  --connection interactive|bulk-load|read-only-reporting picks the\n"
+        << "  connection settings (default interactive: WAL and a busy timeout, so\n"
+        << "  the CLI can run while the UI has the file open). import and generate\n"
+        << "  switch to bulk-load unless a setting is given.\n";
+}
+
+int runImport(Database& db, const std::string& csvPath, const CsvImportOptions& options,
+    bool bulkLoad)
+{
+    // Import-time pragmas: no fsync per commit, big page cache
+    DbResult res;
+    if (bulkLoad && !db.configure(DatabaseOptions::bulkLoad(), res)) {
+        std::cerr << "Failed to configure database: " << res.toString() << std::endl;
+        return 1;
+    }
+
+    CsvImporter importer(db);
+    ImportReport report;
+    bool ok = importer.importFile(csvPath, options, report, res);
+
+    std::cout << "Read " << report.rowsRead << " rows, imported " << report.rowsImported
+              << ", rejected " << report.rowsFailed << " in " << std::fixed
+              << std::setprecision(2) << report.seconds << " s ("
+              << std::setprecision(0) << report.rowsPerSecond() << " rows/s, "
+              << report.transactions << " transactions)" << std::endl;
+
+    for (const ImportRowError& error : report.errors)
+        std::cerr << csvPath << ":" << error.line << ": " << error.result.toString() << std::endl;
+    if (report.rowsFailed > static_cast<long long>(report.errors.size()))
+        std::cerr << "... " << report.rowsFailed - static_cast<long long>(report.errors.size())
+                  << " more" << std::endl;
+
+    if (!ok) {
+        std::cerr << "Import failed: " << res.toString() << std::endl;
+        return 1;
+    }
+    return report.rowsFailed > 0 ? 2 : 0;
+}
+
+int runExport(Database& db, const std::string& outPath, const ExportOptions& options)
+{
+    ComponentExporter exporter(db);
+    ExportReport report;
+    DbResult res;
+    bool ok = (outPath == "-")
+        ? exporter.exportStream(std::cout, options, report, res)
+        : exporter.exportFile(outPath, options, report, res);
+
+    if (!ok) {
+        std::cerr << "Export failed: " << res.toString() << std::endl;
+        return 1;
+    }
+
+    // Keep stdout clean when it carries the data
+    std::cerr << "Exported " << report.rowsWritten << " rows (" << report.bytesWritten
+              << " bytes) in " << std::fixed << std::setprecision(2) << report.seconds
+              << " s (" << std::setprecision(0) << report.rowsPerSecond() << " rows/s)"
+              << std::endl;
+    return 0;
+}
+
+int runGenerate(Database& db, const DatasetOptions& options, bool bulkLoad)
+{
+    DbResult res;
+    if (bulkLoad && !db.configure(DatabaseOptions::bulkLoad(), res)) {
+        std::cerr << "Failed to configure database: " << res.toString() << std::endl;
+        return 1;
+    }
+
+    DatasetGenerator generator(db);
+    DatasetReport report;
+    const bool ok = generator.generate(options, report, res);
+
+    std::cout << "Generated " << report.rows << " rows (" << report.resistors << " resistors, "
+              << report.capacitors << " capacitors, " << report.transistors << " transistors, "
+              << report.diodes << " diodes, " << report.fuses << " fuses) with seed "
+              << options.seed << " in " << std::fixed << std::setprecision(2) << report.seconds
+              << " s (" << std::setprecision(0) << report.rowsPerSecond() << " rows/s)" << std::endl;
+
+    if (!ok) {
+        std::cerr << "Generation failed: " << res.toString() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runBackup(const std::string& dbPath, const std::string& backupPath,
+    const BackupOptions& options)
+{
+    const auto started = std::chrono::steady_clock::now();
+    int lastPercent = -1;
+    DbResult res;
+    const bool ok = DatabaseBackup::copy(dbPath, backupPath, options,
+        [&](const BackupProgress& p) {
+            const int percent = p.pagesTotal > 0
+                ? static_cast<int>(100LL * p.pagesCopied / p.pagesTotal) : 100;
+            if (percent != lastPercent) {
+                std::cerr << "\rBacking up... " << percent << "%" << std::flush;
+                lastPercent = percent;
+            }
+        }, res);
+    std::cerr << std::endl;
+
+    if (!ok) {
+        std::cerr << "Backup failed: " << res.toString() << std::endl;
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "Backed up " << dbPath << " to " << backupPath << " in " << std::fixed
+              << std::setprecision(2) << seconds << " s" << std::endl;
+    return 0;
+}
+
+bool endsWith(const std::string& s, const std::string& suffix)
+{
+    return s.size() >= suffix.size()
+        && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
     // Force console to UTF-8 output
     configureConsoleUtf8();
 
+    std::string dbPath = "inventory.db";
+    std::string csvPath;
+    std::string exportPath;
+    bool importing = false;
+    bool exporting = false;
+    bool generating = false;
+    bool backingUp = false;
+    std::string backupPath;
+    BackupOptions backupOptions;
+    std::string exportFormat;
+    CsvImportOptions importOptions;
+    importOptions.deferSearchIndex = true;
+    ExportOptions exportOptions;
+    DatasetOptions datasetOptions;
+    std::string profilePath;
+    DatabaseOptions dbOptions = DatabaseOptions::interactive();
+    bool connectionChosen = false;
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        if (arg == "--db" && hasValue) {
+            dbPath = args[++i];
+        }
+        else if (arg == "import" && hasValue && !importing) {
+            importing = true;
+            csvPath = args[++i];
+        }
+        else if (arg == "export" && hasValue && !exporting) {
+            exporting = true;
+            exportPath = args[++i];
+        }
+        else if (arg == "generate" && hasValue && !generating) {
+            generating = true;
+            datasetOptions.rows = std::atoll(args[++i].c_str());
+        }
+        else if (arg == "backup" && hasValue && !backingUp) {
+            backingUp = true;
+            backupPath = args[++i];
+        }
+        else if (arg == "--compact") {
+            backupOptions.compact = true;
+        }
+        else if (arg == "--seed" && hasValue) {
+            datasetOptions.seed = std::strtoull(args[++i].c_str(), nullptr, 10);
+        }
+        else if (arg == "--format" && hasValue) {
+            exportFormat = args[++i];
+        }
+        else if (arg == "--threads" && hasValue) {
+            importOptions.parseThreads = std::atoi(args[++i].c_str());
+        }
+        else if (arg == "--batch" && hasValue) {
+            importOptions.batchRows = std::atoi(args[++i].c_str());
+            datasetOptions.batchRows = importOptions.batchRows;
+        }
+        else if (arg == "--delimiter" && hasValue && args[i + 1].size() == 1) {
+            importOptions.delimiter = args[++i][0];
+            exportOptions.delimiter = importOptions.delimiter;
+        }
+        else if (arg == "--profile" && hasValue) {
+            profilePath = args[++i];
+        }
+        else if (arg == "--connection" && hasValue
+            && DatabaseOptions::fromProfileName(args[i + 1], dbOptions)) {
+            connectionChosen = true;
+            ++i;
+        }
+        else if (arg == "--add-missing") {
+            importOptions.addMissingLookups = true;
+        }
+        else if (arg == "--live-search-index") {
+            importOptions.deferSearchIndex = false;
+        }
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((importing && exporting) || (generating && (importing || exporting))
+        || (backingUp && (importing || exporting || generating || !profilePath.empty()))) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (exportFormat.empty())
+        exportFormat = endsWith(exportPath, ".jsonl") ? "jsonl" : "csv";
+    if (exportFormat == "jsonl") {
+        exportOptions.format = ExportFormat::JsonLines;
+    }
+    else if (exportFormat != "csv") {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // DatabaseBackup reads through its own read-only connection. Opening
+    // the source here would migrate an older file before copying it.
+    if (backingUp)
+        return runBackup(dbPath, backupPath, backupOptions);
+
     DbResult res;
-    Database db("inventory.db", res);
+    Database db(dbPath, dbOptions, res);
     if (!db.isOpen()) {
         std::cerr << "Failed to open database: " << res.toString() << std::endl;
         return 1;
     }
 
+    auto profiler = profilePath.empty() ? nullptr : std::make_shared<QueryProfiler>();
+    db.setProfiler(profiler);
+
+    int status = 0;
     SchemaManager schemaMgr(db);
     if (!schemaMgr.initialize(res)) {
         std::cerr << "Failed to initialize schema: " << res.toString() << std::endl;
-        return 1;
+        status = 1;
+    }
+    else if (importing) {
+        status = runImport(db, csvPath, importOptions, !connectionChosen);
+    }
+    else if (exporting) {
+        status = runExport(db, exportPath, exportOptions);
+    }
+    else if (generating) {
+        status = runGenerate(db, datasetOptions, !connectionChosen);
     }
 
-    return 0;
+    if (profiler && !profiler->writeJsonFile(profilePath, res)) {
+        std::cerr << "Failed to write profile: " << res.toString() << std::endl;
+        return status ? status : 1;
+    }
+    return status;
 }
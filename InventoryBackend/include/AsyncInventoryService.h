@@ -0,0 +1,83 @@
+#pragma once
+
+#include "InventoryService.h"
+#include "DatabaseOptions.h"
+#include "DbResult.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Runs an InventoryService on a dedicated worker thread so callers (the
+// Qt UI) never wait on SQLite. The service is opened, used and closed
+// only on that thread; callers hand it work as tasks, which run one at a
+// time in the order they were queued. A task queued after open() sees
+// the newly opened service, so open-then-query needs no extra waiting.
+//
+// Reads that must be answered synchronously (combo box lookups, table
+// paging) can borrow a pooled read connection through readSession()
+// instead; with a WAL profile those do not wait for the worker either.
+class AsyncInventoryService {
+public:
+    // Work receives the open service, or nullptr when none is open
+    using Task = std::function<void(InventoryService*)>;
+
+    AsyncInventoryService();
+    // Finishes queued tasks, closes the service and joins the worker
+    ~AsyncInventoryService();
+
+    AsyncInventoryService(const AsyncInventoryService&) = delete;
+    AsyncInventoryService& operator=(const AsyncInventoryService&) = delete;
+
+    // Open (creating and migrating as needed) on the worker, closing any
+    // database opened before
+    std::future<DbResult> open(const std::string& path, const DatabaseOptions& options);
+
+    // Close the service on the worker. A ReadSession still out keeps its
+    // connection until released.
+    std::future<void> close();
+
+    void post(Task task);
+
+    // post() with the task's return value delivered through a future
+    template <class F>
+    auto submit(F fn) -> std::future<std::invoke_result_t<F&, InventoryService*>>
+    {
+        using R = std::invoke_result_t<F&, InventoryService*>;
+        auto task = std::make_shared<std::packaged_task<R(InventoryService*)>>(std::move(fn));
+        auto future = task->get_future();
+        post([task](InventoryService* service) { (*task)(service); });
+        return future;
+    }
+
+    // Borrow a read-only connection of the open service from any thread.
+    // Fails with SQLITE_MISUSE when no file database is open.
+    bool readSession(ReadSession& session, DbResult& result);
+
+    bool onWorkerThread() const { return std::this_thread::get_id() == worker_.get_id(); }
+
+private:
+    void enqueue(std::function<void()> job);
+    void run();
+    void setReaders(std::shared_ptr<ReaderPool> readers);
+
+    std::unique_ptr<InventoryService> service_;   // worker thread only
+
+    std::mutex queueMutex_;
+    std::condition_variable queued_;
+    std::deque<std::function<void()>> queue_;
+    bool stopping_ = false;
+
+    // Guards only the pointer: acquire() may wait, and must not hold up
+    // the worker swapping pools in open() and close()
+    std::mutex readersMutex_;
+    std::shared_ptr<ReaderPool> readers_;
+
+    std::thread worker_;   // last: starts once the members above exist
+};
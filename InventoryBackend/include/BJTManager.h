@@ -1,7 +1,9 @@
 #pragma once
 #include "Database.h"
 #include "DbResult.h"
+#include "ParametricQuery.h"
 #include "LookupItem.h"
+#include <functional>
 #include <vector>
 
 struct BJT {
@@ -27,6 +29,14 @@ public:
     bool update(const BJT& bjt, DbResult& result);
     bool remove(int componentId, DbResult& result);
     bool list(std::vector<BJT>& bjts, DbResult& result);
+
+    // Streams rows one at a time instead of filling a vector; fn returns
+    // false to stop early.
+    bool forEach(const std::function<bool(const BJT&)>& fn, DbResult& result);
+
+    // Component IDs of rows matching a parametric filter, e.g. every
+    // bjt within a value range on a given package.
+    bool find(const BJTQuery& query, std::vector<int>& componentIds, DbResult& result);
     bool listLookup(std::vector<LookupItem>& items, DbResult& result);
 
 private:
@@ -2,6 +2,7 @@
 
 #include "Database.h"
 #include "DbResult.h"
+#include "LookupManager.h"
 #include <vector>
 #include <string>
 
@@ -14,16 +15,14 @@ struct CapacitorDielectric {
     explicit CapacitorDielectric(const std::string& n) : id(0), name(n) {}
 };
 
-class CapacitorDielectricManager {
+class CapacitorDielectricManager : public LookupManager {
 public:
     explicit CapacitorDielectricManager(Database& db);
 
     bool add(const CapacitorDielectric& diel, DbResult& result);
     bool getById(int id, CapacitorDielectric& diel, DbResult& result);
+    // list and getByName are served from the LookupManager cache
     bool list(std::vector<CapacitorDielectric>& diels, DbResult& result);
     bool remove(int id, DbResult& result);
     int getByName(const std::string& name, DbResult& result);
-
-private:
-    Database& db_;
 };
@@ -2,6 +2,10 @@
 
 #include "Database.h"
 #include "DbResult.h"
+#include "ParametricQuery.h"
+#include "ComponentManager.h"
+#include <functional>
+#include <span>
 #include <vector>
 
 // Core Capacitor struct
@@ -50,11 +54,27 @@ public:
     explicit CapacitorManager(Database& db);
 
     bool add(const Capacitor& cap, DbResult& result);
+
+    // Bulk inserts in one transaction (a savepoint inside the caller's).
+    // The second overload inserts comps[i] and caps[i] together and sets
+    // caps[i].componentId from the assigned component ID.
+    bool addBatch(std::span<const Capacitor> caps, DbResult& result);
+    bool addBatch(std::span<Component> comps, std::span<Capacitor> caps, DbResult& result);
     bool getById(int id, Capacitor& cap, DbResult& result);
     bool update(const Capacitor& cap, DbResult& result);
     bool remove(int id, DbResult& result);
     bool list(std::vector<Capacitor>& caps, DbResult& result);
 
+    // Streams rows one at a time instead of filling a vector; fn returns
+    // false to stop early.
+    bool forEach(const std::function<bool(const Capacitor&)>& fn, DbResult& result);
+
+    // Component IDs of rows matching a parametric filter, e.g. every
+    // capacitor within a value range on a given package.
+    bool find(const CapacitorQuery& query, std::vector<int>& componentIds, DbResult& result);
+
 private:
+    bool insert(sqlite3_stmt* stmt, const Capacitor& cap, DbResult& result);
+
     Database& db_;
 };
@@ -2,6 +2,7 @@
 
 #include "Database.h"
 #include "DbResult.h"
+#include "LookupManager.h"
 #include <vector>
 #include <string>
 
@@ -14,16 +15,14 @@ struct CapacitorPackage {
     explicit CapacitorPackage(const std::string& n) : id(0), name(n) {}
 };
 
-class CapacitorPackageManager {
+class CapacitorPackageManager : public LookupManager {
 public:
     explicit CapacitorPackageManager(Database& db);
 
     bool add(const CapacitorPackage& pkg, DbResult& result);
     bool getById(int id, CapacitorPackage& pkg, DbResult& result);
+    // list and getByName are served from the LookupManager cache
     bool list(std::vector<CapacitorPackage>& pkgs, DbResult& result);
     bool remove(int id, DbResult& result);
     int getByName(const std::string& name, DbResult& result);
-
-private:
-    Database& db_;
 };
@@ -0,0 +1,111 @@
+#pragma once
+#include "Database.h"
+#include "DbResult.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "CapacitorManager.h"
+#include "TransistorManager.h"
+#include "BJTManager.h"
+#include "FuseManager.h"
+#include "DiodeManager.h"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Subtype rows together with the names of the lookups they reference.
+// A name is empty when the lookup ID is unset.
+struct ResistorDetails {
+    Resistor resistor;
+    std::string packageName;
+    std::string compositionName;
+};
+
+struct CapacitorDetails {
+    Capacitor capacitor;
+    std::string packageName;
+    std::string dielectricName;
+};
+
+struct TransistorDetails {
+    Transistor transistor;
+    std::optional<BJT> bjt;     // set for bipolar transistors
+    std::string typeName;
+    std::string polarityName;
+    std::string packageName;
+};
+
+struct FuseDetails {
+    Fuse fuse;
+    std::string packageName;
+    std::string typeName;
+};
+
+struct DiodeDetails {
+    Diode diode;
+    std::string packageName;
+    std::string typeName;
+    std::string polarityName;
+};
+
+// A component with its category/manufacturer names and whichever subtype
+// row it has (monostate if none).
+struct ComponentDetails {
+    using Subtype = std::variant<std::monostate, ResistorDetails, CapacitorDetails,
+        TransistorDetails, FuseDetails, DiodeDetails>;
+
+    Component component;
+    std::string categoryName;
+    std::string manufacturerName;
+    Subtype subtype;
+
+    template <typename T>
+    const T* as() const { return std::get_if<T>(&subtype); }
+};
+
+// Joins Components (alias c) to its category and manufacturer and to every
+// subtype table with its lookup names. Every join is on a primary key, so
+// each row costs a handful of b-tree probes. Shared with ComponentExporter.
+inline constexpr const char* kComponentDetailsJoinSql = R"SQL(
+     JOIN Categories cat ON cat.ID = c.CategoryID
+     LEFT JOIN Manufacturers m ON m.ID = c.ManufacturerID
+     LEFT JOIN Resistors r ON r.ComponentID = c.ID
+     LEFT JOIN ResistorPackage rp ON rp.ID = r.PackageTypeID
+     LEFT JOIN ResistorComposition rc ON rc.ID = r.CompositionID
+     LEFT JOIN Capacitors cap ON cap.ComponentID = c.ID
+     LEFT JOIN CapacitorPackage cp ON cp.ID = cap.PackageTypeID
+     LEFT JOIN CapacitorDielectric cd ON cd.ID = cap.DielectricTypeID
+     LEFT JOIN Transistors t ON t.ComponentID = c.ID
+     LEFT JOIN TransistorType tt ON tt.ID = t.TypeID
+     LEFT JOIN TransistorPolarity tpol ON tpol.ID = t.PolarityID
+     LEFT JOIN TransistorPackage tp ON tp.ID = t.PackageID
+     LEFT JOIN BJTs b ON b.ComponentID = c.ID
+     LEFT JOIN Fuses f ON f.ComponentId = c.ID
+     LEFT JOIN FusePackage fp ON fp.Id = f.PackageId
+     LEFT JOIN FuseType ft ON ft.Id = f.TypeId
+     LEFT JOIN Diodes d ON d.ComponentId = c.ID
+     LEFT JOIN DiodePackage dp ON dp.Id = d.PackageId
+     LEFT JOIN DiodeType dt ON dt.Id = d.TypeId
+     LEFT JOIN DiodePolarity dpol ON dpol.Id = d.PolarityId
+)SQL";
+
+// Reads components joined with their subtype tables and lookup names.
+// Each call is a single statement, whatever the number of IDs, so a
+// report over N parts no longer costs 1 + N subtype queries.
+class ComponentDetailsManager {
+public:
+    explicit ComponentDetailsManager(Database& db) : db_(db) {}
+
+    // SQLITE_NOTFOUND if no component has this ID
+    bool getById(int id, ComponentDetails& details, DbResult& result);
+
+    // Details for each ID that exists, in the order given. Missing IDs are
+    // skipped; repeated IDs are returned repeatedly.
+    bool getByIds(std::span<const int> ids, std::vector<ComponentDetails>& details,
+        DbResult& result);
+
+private:
+    Database& db_;
+};
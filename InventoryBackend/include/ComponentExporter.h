@@ -0,0 +1,61 @@
+#pragma once
+#include "Database.h"
+#include "DbResult.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+enum class ExportFormat
+{
+    Csv,
+    JsonLines
+};
+
+struct ExportReport {
+    long long rowsWritten = 0;
+    long long bytesWritten = 0;
+    double seconds = 0.0;
+
+    double rowsPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(rowsWritten) / seconds : 0.0;
+    }
+};
+
+struct ExportOptions {
+    ExportFormat format = ExportFormat::Csv;
+    char delimiter = ',';                // CSV only
+    bool header = true;                  // CSV only
+    std::size_t bufferBytes = 1 << 16;   // flushed to the stream when full
+};
+
+// Streaming dump of every component with its subtype attributes and
+// lookup names, in ID order.
+//
+// One statement LEFT JOINs Components with Resistors, Capacitors,
+// Transistors/BJTs, Fuses, Diodes and their lookup tables, all on primary
+// keys, and each row is formatted straight from the statement into an
+// output buffer. Nothing is collected per row, so memory stays constant
+// regardless of table size.
+//
+// CSV has one column per attribute; fields that do not apply to a row are
+// empty. Package, Tolerance, VoltageRating and LeadSpacing are shared by
+// several subtypes and appear once. Column names match CsvImporter's, but
+// re-importing an export restores only what the importer reads: the base
+// fields plus resistor and capacitor ratings, package, composition and
+// dielectric. Temperature ratings and transistor, fuse and diode
+// attributes are dropped. JSON Lines writes one object per component and
+// leaves out NULL attributes.
+class ComponentExporter {
+public:
+    explicit ComponentExporter(Database& db);
+
+    bool exportFile(const std::string& path, const ExportOptions& options,
+        ExportReport& report, DbResult& result);
+
+    bool exportStream(std::ostream& out, const ExportOptions& options,
+        ExportReport& report, DbResult& result);
+
+private:
+    Database& db_;
+};
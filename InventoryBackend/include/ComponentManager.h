@@ -1,8 +1,12 @@
 #pragma once
 #include "Database.h"
 #include "DbResult.h"
+#include <functional>
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
+#include <string_view>
 
 struct Component {
     int id;
@@ -38,16 +42,102 @@ struct Component {
     }
 };
 
+// Borrowed view of a Components row, handed out by forEachView. The text
+// fields point into SQLite's row buffer and are only valid inside the
+// callback; call toComponent() to keep a copy.
+struct ComponentView {
+    int id = 0;
+    int categoryId = 0;
+    std::string_view partNumber;
+    int manufacturerId = 0;
+    std::string_view description;
+    std::string_view notes;
+    int quantity = 0;
+    std::string_view datasheetLink;
+    std::string_view createdOn;
+    std::string_view modifiedOn;
+
+    Component toComponent() const;
+};
+
+// Sort key for paged listing. Both orders are served by an index
+// (rowid, idx_Components_PartNumber) and break ties on ID.
+enum class ComponentOrder { ById, ByPartNumber };
+
+// Keyset position for listPage. A default cursor starts at the first row;
+// each call moves it past the last row returned, so paging deep into the
+// table costs the same as the first page (no OFFSET scan).
+struct ComponentPageCursor {
+    ComponentOrder order = ComponentOrder::ById;
+    int lastId = 0;
+    std::string lastPartNumber;
+    bool atEnd = false;   // set once a page comes back short
+};
+
+// Selects components for removeWhere. Set fields are ANDed; at least one
+// must be set, so an empty filter cannot purge the whole table.
+struct ComponentFilter {
+    std::optional<int> categoryId;
+    std::optional<int> manufacturerId;
+    std::optional<int> maxQuantity;   // Quantity <= maxQuantity
+    std::string modifiedBefore;       // ModifiedOn < this ("YYYY-MM-DD[ HH:MM:SS]")
+
+    bool empty() const {
+        return !categoryId && !manufacturerId && !maxQuantity && modifiedBefore.empty();
+    }
+};
+
 class ComponentManager {
 public:
     explicit ComponentManager(Database& db) : db_(db) {}
 
+    // add() and update() write the stored row's generated fields (ID,
+    // CreatedOn, ModifiedOn) back into comp, so it can be shown as-is.
     bool add(Component& comp, DbResult& result);
+
+    // Inserts all components in a single transaction and writes the
+    // assigned IDs back into comps. Nothing is kept if any row fails;
+    // inside a caller's transaction only the batch's savepoint is undone.
+    bool addBatch(std::span<Component> comps, DbResult& result);
     bool getById(int id, Component& comp, DbResult& result);
-    bool update(const Component& comp, DbResult& result);
+    bool update(Component& comp, DbResult& result);
     bool remove(int id, DbResult& result);
+
+    // Delete many components and, through ON DELETE CASCADE, their subtype
+    // rows in one transaction and one DELETE statement. The IDs are staged
+    // in a temp table first, so the cascade and search-index triggers run
+    // inside a single statement instead of one autocommit per ID. Unknown
+    // IDs are skipped; removed receives the number of components deleted.
+    bool removeMany(std::span<const int> ids, long long& removed, DbResult& result);
+    bool removeWhere(const ComponentFilter& filter, long long& removed, DbResult& result);
+
     bool list(std::vector<Component>& comps, DbResult& result);
 
+    // Stream rows in ID order without materializing the table. fn returns
+    // false to stop early. forEach reuses one Component (so its strings
+    // keep their capacity); forEachView copies no text at all.
+    bool forEach(const std::function<bool(const Component&)>& fn, DbResult& result);
+    bool forEachView(const std::function<bool(const ComponentView&)>& fn, DbResult& result);
+
+    // Fetch up to pageSize rows after cursor into page (replacing its
+    // contents) and advance cursor.
+    bool listPage(ComponentPageCursor& cursor, int pageSize,
+        std::vector<Component>& page, DbResult& result);
+
+    // Full-text search over part number, description and notes, best
+    // matches first (bm25, part number weighted highest). Every word in
+    // query must match the start of a token: "lm31 regul" finds
+    // "LM317T adjustable regulator". Returns at most limit rows.
+    bool search(const std::string& query, int limit,
+        std::vector<Component>& comps, DbResult& result);
+
+    // All components with the given part number (case-insensitive)
+    bool findByPartNumber(const std::string& partNumber,
+        std::vector<Component>& comps, DbResult& result);
+
 private:
+    bool insert(sqlite3_stmt* stmt, Component& comp, DbResult& result);
+    bool removeStaged(long long& removed, DbResult& result);
+
     Database& db_;
 };
@@ -0,0 +1,112 @@
+#pragma once
+#include "Database.h"
+#include "DbResult.h"
+#include "CategoryManager.h"
+#include "ManufacturerManager.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "ResistorPackageManager.h"
+#include "ResistorCompositionManager.h"
+#include "CapacitorManager.h"
+#include "CapacitorPackageManager.h"
+#include "CapacitorDielectricManager.h"
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+// Per-row failure codes. Database errors on a row keep their SQLite code
+// in the same DbResult::code, so these start at 1000: no SQLite result
+// code, primary or extended, has a low byte of 232-236.
+enum class ImportError
+{
+    None = 0,
+    MissingColumn = 1000,   // header lacks a required column (fatal)
+    MissingField = 1001,    // required value empty on a row
+    InvalidNumber = 1002,   // Quantity or a rating did not parse
+    UnknownLookup = 1003,   // category/manufacturer/package name not found
+    MalformedRecord = 1004  // unterminated quote
+};
+
+struct ImportRowError {
+    int line;            // 1-based line where the record starts
+    DbResult result;
+};
+
+struct ImportReport {
+    long long rowsRead = 0;
+    long long rowsImported = 0;
+    long long rowsFailed = 0;
+    int transactions = 0;           // batches committed
+    double seconds = 0.0;           // wall time, parse to last commit
+
+    // First CsvImportOptions::maxRecordedErrors failures, by line
+    std::vector<ImportRowError> errors;
+
+    double rowsPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(rowsRead) / seconds : 0.0;
+    }
+};
+
+struct CsvImportOptions {
+    int parseThreads = 0;            // 0 = hardware threads - 2, at least 1
+    int chunkRows = 2048;            // records per unit of parse work
+    int queueChunks = 8;             // chunks buffered between stages
+    int batchRows = 20000;           // rows per committed transaction
+    bool addMissingLookups = false;  // create unknown lookup names instead of failing the row
+    bool deferSearchIndex = false;   // suspend the ComponentsFts triggers, rebuild once at the end
+    char delimiter = ',';
+    std::size_t maxRecordedErrors = 1000;
+};
+
+// Bulk import of component rows from CSV.
+//
+// The first record is a header; columns are matched by name, ignoring
+// case, and unknown columns are skipped:
+//
+//     PartNumber, Category        required
+//     Manufacturer, Description, Notes, Quantity, DatasheetLink
+//     Resistance, Tolerance, PowerRating, Composition     (Resistor rows)
+//     Capacitance, VoltageRating, Dielectric              (Capacitor rows)
+//     Package                     resistor or capacitor package by category
+//
+// Ratings accept an SI prefix and unit ("4.7k", "100nF", "0.25W").
+//
+// The calling thread splits the input into records and hands chunks to a
+// pool of parse threads, which convert and validate them against a
+// snapshot of the lookup tables. A single writer thread owns the
+// connection and commits rows in large transactions through the
+// managers' cached insert statements. Both hand-offs are bounded queues,
+// and a parse thread waits rather than finish a chunk more than
+// queueChunks ahead of the writer, so memory stays flat however large
+// the file is. Rows are written in file order.
+//
+// A bad row is recorded in the report and skipped; only I/O, header and
+// commit failures abort the import (rolling back the open batch).
+//
+// The full-text triggers dominate insert cost. For a load that is large
+// relative to the table, deferSearchIndex drops them for the duration
+// and rebuilds ComponentsFts in one pass afterwards (see SchemaManager).
+class CsvImporter {
+public:
+    explicit CsvImporter(Database& db);
+
+    bool importFile(const std::string& path, const CsvImportOptions& options,
+        ImportReport& report, DbResult& result);
+
+    bool importStream(std::istream& in, const CsvImportOptions& options,
+        ImportReport& report, DbResult& result);
+
+private:
+    Database& db_;
+    ComponentManager components_;
+    CategoryManager categories_;
+    ManufacturerManager manufacturers_;
+    ResistorManager resistors_;
+    ResistorPackageManager resistorPackages_;
+    ResistorCompositionManager resistorCompositions_;
+    CapacitorManager capacitors_;
+    CapacitorPackageManager capacitorPackages_;
+    CapacitorDielectricManager capacitorDielectrics_;
+};
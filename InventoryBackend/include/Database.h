@@ -1,14 +1,30 @@
 #pragma once
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <sqlite3.h>
 #include "DbResult.h"
+#include "StatementCache.h"
+#include "DatabaseOptions.h"
+
+class QueryProfiler;
 
 class Database {
 public:
     Database(const std::string& filename, DbResult& result);
+    Database(const std::string& filename, const DatabaseOptions& options, DbResult& result);
     ~Database();
 
     bool isOpen() const;
+    bool isReadOnly() const { return options_.readOnly; }
+    const DatabaseOptions& options() const { return options_; }
+
+    // Apply the pragmas of an options profile to the open connection, e.g.
+    // to switch into bulk-load settings for an import. Journal mode cannot
+    // change inside a transaction; readOnly only takes effect at open.
+    bool configure(const DatabaseOptions& options, DbResult& result);
 
     // Execute a SQL statement (no results expected)
     bool exec(const std::string& sql, DbResult& result);
@@ -19,14 +35,69 @@ public:
     // Finalize a prepared statement
     void finalize(sqlite3_stmt* stmt);
 
+    // Prepare a statement through the connection's LRU statement cache.
+    // The handle resets the statement and returns it to the cache when it
+    // goes out of scope, so hot queries are only parsed once.
+    bool prepareCached(const std::string& sql, CachedStatement& stmt, DbResult& result);
+
+    // Step stmt to completion, calling onRow for every result row. onRow
+    // returns false to stop early. A step error is reported in result.
+    bool stepRows(sqlite3_stmt* stmt, const std::function<bool(sqlite3_stmt*)>& onRow,
+        DbResult& result);
+    StatementCache& statementCache() { return stmtCache_; }
+
+    // Record every statement run on this connection into profiler (see
+    // QueryProfiler), or stop recording with nullptr. Costs two clock
+    // reads per statement and a counter per result row while attached. Attach
+    // only while no statement of this connection is running.
+    void setProfiler(std::shared_ptr<QueryProfiler> profiler);
+    QueryProfiler* profiler() const { return profiler_.get(); }
+
+    // PRAGMA data_version: changes whenever another connection commits to
+    // the database file, but not for this connection's own writes.
+    bool dataVersion(long long& version, DbResult& result);
+
+    // Generation counter for in-process caches of table contents (see
+    // LookupManager). data_version cannot see this connection's own
+    // writes, so code that changes cached tables calls invalidateCaches();
+    // rolling back a Transaction does so as well.
+    unsigned long long cacheGeneration() const { return cacheGeneration_; }
+    void invalidateCaches() { ++cacheGeneration_; }
+
+    // True while a transaction is open on this connection
+    bool inTransaction() const { return db_ && sqlite3_get_autocommit(db_) == 0; }
+    int transactionDepth() const { return transactionDepth_; }
+
+    // Identifies the read snapshot of the outermost open Transaction guard,
+    // or 0 if there is none or it has not read yet. While this stays the
+    // same, other connections' commits cannot become visible, so caches
+    // validated under it need no data_version check.
+    unsigned long long snapshotSerial() const;
+
     sqlite3* handle() const { return db_; }
     int lastInsertId() const;
     bool tableExists(const std::string& tableName) const;
+    bool indexExists(const std::string& indexName) const;
 	bool columnExists(const std::string& tableName, const std::string& columnName) const;
     int getMaxSchemaVersion() const;
 	int countRows(const std::string& tableName, const std::string& whereClause) const;
 	bool rowExists(const std::string& tableName, const std::string& condition, DbResult& result);
 
 private:
+    friend class Transaction;
+
+    static int traceHook(unsigned type, void* context, void* p, void* x);
+
     sqlite3* db_;
+    DatabaseOptions options_;
+    StatementCache stmtCache_;
+    int transactionDepth_ = 0;   // open Transaction guards
+    unsigned long long transactionSerial_ = 0;   // outermost guards opened
+    unsigned long long cacheGeneration_ = 0;
+    std::shared_ptr<QueryProfiler> profiler_;
+    struct ProfiledRun {
+        std::chrono::steady_clock::time_point started;
+        long long rows = 0;
+    };
+    std::unordered_map<sqlite3_stmt*, ProfiledRun> profiledRuns_;   // statements mid-run
 };
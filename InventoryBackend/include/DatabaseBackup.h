@@ -0,0 +1,58 @@
+#pragma once
+#include "DbResult.h"
+
+#include <chrono>
+#include <functional>
+#include <stop_token>
+#include <string>
+
+struct BackupProgress {
+    int pagesCopied = 0;
+    int pagesTotal = 0;
+};
+
+// Called on the backup's thread after every step
+using BackupProgressFn = std::function<void(const BackupProgress&)>;
+
+struct BackupOptions {
+    // Pages copied per sqlite3_backup_step; 256 is 1 MiB at the default
+    // 4 KiB page size
+    int pagesPerStep = 256;
+
+    // Sleep between steps, leaving disk and CPU to the writers
+    std::chrono::milliseconds pause{ 5 };
+
+    // Write a VACUUMed copy (VACUUM INTO) instead of copying pages: a
+    // smaller, defragmented file, but in one pass with no pauses and
+    // progress only at the end
+    bool compact = false;
+
+    // Request cancellation from any thread; the backup stops after its
+    // current step with SQLITE_INTERRUPT
+    std::stop_token cancel;
+};
+
+// Online copy of a database file that other connections keep reading and
+// writing.
+//
+// The copy is taken through a read-only connection of its own. In WAL
+// mode it holds one read transaction for the whole copy, so the file is
+// a consistent snapshot and commits by writers neither wait for it nor
+// restart it (the WAL cannot be checkpointed past that snapshot until
+// the copy ends). In rollback-journal mode writers get the file back
+// between steps, and a commit in between makes SQLite restart the copy.
+//
+// The copy is written to "<destPath>.partial" and renamed to destPath
+// only when complete, so a cancelled or failed backup never leaves a
+// truncated file under the real name.
+class DatabaseBackup {
+public:
+    static bool copy(const std::string& sourcePath, const std::string& destPath,
+        const BackupOptions& options, const BackupProgressFn& progress, DbResult& result);
+
+private:
+    static bool copyPages(const std::string& sourcePath, const std::string& partialPath,
+        const BackupOptions& options, const BackupProgressFn& progress, DbResult& result);
+    static bool vacuumInto(const std::string& sourcePath, const std::string& partialPath,
+        const BackupOptions& options, const BackupProgressFn& progress, DbResult& result);
+};
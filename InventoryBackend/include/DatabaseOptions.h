@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+
+// Connection settings applied when a Database is opened.
+// A default-constructed DatabaseOptions leaves every SQLite default alone;
+// the named profiles below are the tuned configurations we actually run.
+struct DatabaseOptions {
+    enum class JournalMode { Default, Delete, Wal, Memory, Off };
+    enum class Synchronous { Default, Off, Normal, Full };
+    enum class TempStore { Default, File, Memory };
+
+    JournalMode journalMode = JournalMode::Default;
+    Synchronous synchronous = Synchronous::Default;
+    TempStore tempStore = TempStore::Default;
+    long long mmapSize = -1;     // bytes, -1 = SQLite default
+    int cacheSizeKiB = 0;        // page cache size, 0 = SQLite default
+    int busyTimeoutMs = 0;       // wait this long on SQLITE_BUSY, 0 = fail fast
+    bool readOnly = false;       // open SQLITE_OPEN_READONLY + query_only
+
+    // WAL, synchronous=NORMAL, memory-mapped reads and a busy timeout so
+    // the UI can read while another connection writes.
+    static DatabaseOptions interactive();
+
+    // WAL with synchronous=OFF and a large page cache for importers.
+    // Trades durability of the last commits on power loss for speed.
+    static DatabaseOptions bulkLoad();
+
+    // Read-only connection with a large mmap window for report queries.
+    static DatabaseOptions readOnlyReporting();
+
+    // Resolves "interactive", "bulk-load" or "read-only-reporting".
+    static bool fromProfileName(const std::string& name, DatabaseOptions& options);
+};
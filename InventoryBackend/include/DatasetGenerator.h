@@ -0,0 +1,59 @@
+#pragma once
+#include "Database.h"
+#include "DbResult.h"
+
+#include <cstdint>
+
+// Share of generated rows per category, as relative weights
+struct DatasetMix {
+    int resistors = 40;
+    int capacitors = 30;
+    int transistors = 10;
+    int diodes = 12;
+    int fuses = 8;
+};
+
+struct DatasetOptions {
+    long long rows = 1000;
+    std::uint64_t seed = 1;
+    DatasetMix mix;
+    int batchRows = 20000;           // rows per committed transaction
+    bool deferSearchIndex = true;    // suspend the ComponentsFts triggers, rebuild once at the end
+};
+
+struct DatasetReport {
+    long long rows = 0;
+    long long resistors = 0;
+    long long capacitors = 0;
+    long long transistors = 0;
+    long long diodes = 0;
+    long long fuses = 0;
+    int transactions = 0;
+    double seconds = 0.0;
+
+    double rowsPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0;
+    }
+};
+
+// Synthetic inventory for tests, benchmarks and scale testing.
+//
+// Every row is a component with its subtype row: E24 resistors from 1 ohm
+// to 10M, E6 capacitors from 1 pF to 1000 uF with a dielectric and
+// package to match the value, BJTs and MOSFETs, diodes by type and fuses
+// on the standard current series, spread over the seeded manufacturers
+// and lookup tables. Part numbers are unique within one run.
+//
+// Output depends only on the seed, the mix and the row count: the same
+// options give the same rows and IDs on every platform (no std::
+// distributions, whose results are implementation-defined). Rows are
+// written through the managers, batchRows per transaction.
+class DatasetGenerator {
+public:
+    explicit DatasetGenerator(Database& db) : db_(db) {}
+
+    bool generate(const DatasetOptions& options, DatasetReport& report, DbResult& result);
+
+private:
+    Database& db_;
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <cctype>
+#include <cstdio>
 #include <ctime>
 #include <sqlite3.h>
 
@@ -29,6 +31,57 @@ inline std::string safeColumnText(sqlite3_stmt* stmt, int colIndex) {
     return text ? reinterpret_cast<const char*>(text) : "";
 }
 
+// Borrowing variant of safeColumnText. The view points into SQLite's
+// buffer and is only valid until the statement is stepped or reset.
+inline std::string_view safeColumnView(sqlite3_stmt* stmt, int colIndex) {
+    const unsigned char* text = sqlite3_column_text(stmt, colIndex);
+    if (!text) return {};
+    return { reinterpret_cast<const char*>(text),
+        static_cast<std::size_t>(sqlite3_column_bytes(stmt, colIndex)) };
+}
+
+// Binds a lookup foreign key, or NULL when unset (id <= 0), so optional
+// lookups do not trip the FK check.
+inline void bindOptionalId(sqlite3_stmt* stmt, int index, int id) {
+    if (id > 0)
+        sqlite3_bind_int(stmt, index, id);
+    else
+        sqlite3_bind_null(stmt, index);
+}
+
+// Case-fold the way COLLATE NOCASE compares: ASCII letters only, so
+// in-memory name maps agree with SQLite on what matches.
+inline std::string foldNoCase(std::string_view s)
+{
+    std::string folded(s);
+    for (char& c : folded) {
+        if (c >= 'A' && c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
+    }
+    return folded;
+}
+
+// Three-way comparison in COLLATE NOCASE order: bytes compared unsigned
+// after folding ASCII letters, a prefix before the longer string. For
+// in-memory lists that must sort the way SQLite returns them.
+inline int compareNoCase(std::string_view a, std::string_view b)
+{
+    const std::size_t n = a.size() < b.size() ? a.size() : b.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        unsigned char ca = static_cast<unsigned char>(a[i]);
+        unsigned char cb = static_cast<unsigned char>(b[i]);
+        if (ca >= 'A' && ca <= 'Z')
+            ca = static_cast<unsigned char>(ca - 'A' + 'a');
+        if (cb >= 'A' && cb <= 'Z')
+            cb = static_cast<unsigned char>(cb - 'A' + 'a');
+        if (ca != cb)
+            return ca < cb ? -1 : 1;
+    }
+    if (a.size() == b.size())
+        return 0;
+    return a.size() < b.size() ? -1 : 1;
+}
+
 inline std::string normalizeWhitespace(const std::string& s)
 {
     std::string result;
@@ -54,3 +107,29 @@ inline std::string normalizeWhitespace(const std::string& s)
 
     return result;
 }
+
+// Append value to out as a quoted JSON string: quotes, backslashes and
+// control characters escaped, other bytes (UTF-8 included) copied as is.
+inline void appendJsonString(std::string& out, std::string_view value)
+{
+    out.push_back('"');
+    for (const char ch : value) {
+        switch (ch) {
+        case '"':  out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(ch));
+                out.append(escaped);
+            }
+            else {
+                out.push_back(ch);
+            }
+        }
+    }
+    out.push_back('"');
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "Database.h"
 #include "DbResult.h"
+#include "ParametricQuery.h"
+#include <functional>
 #include <vector>
 
 struct Fuse {
@@ -32,6 +34,14 @@ public:
     bool remove(int componentId, DbResult& res);
     bool list(std::vector<Fuse>& fuses, DbResult& res);
 
+    // Streams rows one at a time instead of filling a vector; fn returns
+    // false to stop early.
+    bool forEach(const std::function<bool(const Fuse&)>& fn, DbResult& res);
+
+    // Component IDs of rows matching a parametric filter, e.g. every
+    // fuse within a value range on a given package.
+    bool find(const FuseQuery& query, std::vector<int>& componentIds, DbResult& res);
+
 private:
     Database& db_;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ComponentManager.h"
+#include "ComponentDetailsManager.h"
 #include "CategoryManager.h"
 #include "ManufacturerManager.h"
 #include "ResistorManager.h"
@@ -9,7 +10,15 @@
 #include "CapacitorManager.h"
 #include "CapacitorPackageManager.h"
 #include "CapacitorDielectricManager.h"
+#include "StockLedger.h"
+#include "StatsManager.h"
+#include "Transaction.h"
+#include "ReaderPool.h"
+#include "DatabaseOptions.h"
+#include "QueryProfiler.h"
+#include "DatabaseBackup.h"
 
+#include <future>
 #include <memory>
 #include <string>
 
@@ -21,10 +30,24 @@ public:
     static std::unique_ptr<InventoryService>
         open(const std::string& path, DbResult& result);
 
+    // Open with a connection profile. A read-only profile skips migrations
+    // and fails if the file does not already hold an inventory schema.
+    // A new database starts with the typical-inventory planner statistics
+    // of SchemaManager::seedPlannerStats() until it is first analyzed.
+    static std::unique_ptr<InventoryService>
+        open(const std::string& path, const DatabaseOptions& options, DbResult& result);
+
     static std::unique_ptr<InventoryService>
         create(const std::string& path, DbResult& result);
 
+    // Runs PRAGMA optimize on a writable database before closing it
+    ~InventoryService();
+
+    InventoryService(const InventoryService&) = delete;
+    InventoryService& operator=(const InventoryService&) = delete;
+
     ComponentManager& components() { return componentMgr_; }
+    ComponentDetailsManager& componentDetails() { return componentDetailsMgr_; }
 	CategoryManager& categories() { return categoryMgr_; }
 	ManufacturerManager& manufacturers() { return manufacturerMgr_; }
 	ResistorManager& resistors() { return resistorMgr_; }
@@ -33,16 +56,66 @@ public:
     CapacitorManager& capacitors() { return capacitorManager_; }
     CapacitorPackageManager& capacitorPackages() { return capacitorPackageMgr_; }
     CapacitorDielectricManager& capacitorDielectrics() { return capacitorDielectricMgr_; }
+    StockLedger& stock() { return stockLedger_; }
+    StatsManager& stats() { return statsMgr_; }
     Database& database() { return *db_; }
 
+    // Groups writes made through any of the managers above into one
+    // atomic unit (a savepoint if a transaction is already open).
+    Transaction transaction(DbResult& result,
+        Transaction::Mode mode = Transaction::Mode::Immediate);
+
+    // The managers above share one connection and belong to the thread
+    // that opened the service. Other threads borrow a pooled read-only
+    // connection with its own managers instead, e.g. for reports or
+    // search while the UI thread writes. Open the service with a WAL
+    // profile (DatabaseOptions::interactive) so readers and the writer
+    // do not block each other. Fails for in-memory databases, which
+    // other connections cannot see.
+    bool readSession(ReadSession& session, DbResult& result);
+
+    // Replace the reader pool (default: one reader per hardware thread,
+    // DatabaseOptions::readOnlyReporting). Sessions still out keep the old
+    // pool until they are released.
+    void configureReaders(int maxReaders, const DatabaseOptions& options);
+
+    // nullptr for in-memory databases
+    std::shared_ptr<ReaderPool> readers() const { return readers_; }
+
+    // Online backup of the database file to path (see DatabaseBackup),
+    // run on a thread of its own with its own connection so neither this
+    // service nor other writers wait for it. The future's destructor
+    // waits for the backup, so keep it until done; cancel through
+    // options.cancel. Fails for in-memory databases.
+    std::future<DbResult> backupTo(const std::string& path,
+        BackupProgressFn progress = {}, BackupOptions options = {});
+
+    // Re-sample planner statistics (SchemaManager::analyzePlannerStats).
+    // Imports, the dataset generator and large bulk deletes already do
+    // this; call it after other mass changes made through the managers.
+    bool analyzePlannerStats(DbResult& result);
+
+    // Statement profiling on the writer and every pooled reader, switchable
+    // at runtime. Stats accumulate in profiler() across enable/disable
+    // cycles until profiler()->reset(); null until first enabled. Call on
+    // the service's thread with no statement running.
+    void setProfiling(bool enabled);
+    bool isProfiling() const { return db_->profiler() != nullptr; }
+    QueryProfiler* profiler() { return profiler_.get(); }
+
 private:
-    explicit InventoryService(std::unique_ptr<Database> db);
+    InventoryService(std::unique_ptr<Database> db, const std::string& path);
 
     static std::unique_ptr<InventoryService>
-        openInternal(const std::string& path, DbResult& result);
+        openInternal(const std::string& path, const DatabaseOptions& options,
+            DbResult& result);
 
     std::unique_ptr<Database> db_;
+    std::string path_;
+    std::shared_ptr<ReaderPool> readers_;
+    std::shared_ptr<QueryProfiler> profiler_;
     ComponentManager componentMgr_;
+    ComponentDetailsManager componentDetailsMgr_;
     CategoryManager categoryMgr_;
     ManufacturerManager manufacturerMgr_;
     ResistorManager resistorMgr_;
@@ -51,4 +124,6 @@ private:
 	CapacitorManager capacitorManager_;
     CapacitorPackageManager capacitorPackageMgr_;
 	CapacitorDielectricManager capacitorDielectricMgr_;
+    StockLedger stockLedger_;
+    StatsManager statsMgr_;
 };
@@ -1,12 +1,22 @@
 #pragma once
 
+#include "LookupItem.h"
+
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Database;
 class DbResult;
-struct LookupItem;
 
+// Base for managers of simple ID/Name lookup tables.
+//
+// Reads are served from an in-memory copy of the table that is loaded on
+// first use and reloaded when PRAGMA data_version or the connection's
+// cache generation moves. data_version is only stepped once per
+// transaction snapshot (Database::snapshotSerial), so an import resolving
+// names row by row inside its batches does a hash probe instead of a
+// query; outside a transaction every call still steps it.
 class LookupManager {
 public:
     virtual ~LookupManager() = default;
@@ -15,9 +25,30 @@ public:
     bool addByName(const std::string& name, DbResult& result);
     int  getIdByName(const std::string& name, DbResult& result);
 
+    // Name of the row with this ID; SQLITE_NOTFOUND if there is none
+    bool getNameById(int id, std::string& name, DbResult& result);
+
 protected:
     LookupManager(Database& db, const char* tableName);
 
+    // Subclasses call this after writing the table themselves
+    void invalidateCache();
+
     Database& db_;
     const char* tableName_;
+
+private:
+    struct Cache {
+        bool loaded = false;
+        long long dataVersion = 0;
+        unsigned long long generation = 0;
+        unsigned long long snapshot = 0;                    // validated under
+        std::vector<LookupItem> items;                      // ORDER BY Name
+        std::unordered_map<int, std::size_t> indexById;     // into items
+        std::unordered_map<std::string, int> idByFoldedName;
+    };
+
+    bool ensureCache(DbResult& result);
+
+    Cache cache_;
 };
@@ -0,0 +1,137 @@
+#pragma once
+#include "Database.h"
+#include "DbResult.h"
+#include <string>
+#include <vector>
+
+// Filterable attributes per component family. Numeric fields take range
+// bounds (atLeast/atMost/between); lookup fields (Package, Type, ...)
+// take a lookup-table ID or name.
+enum class ResistorField {
+    Resistance, Tolerance, PowerRating, VoltageRating, LeadSpacing,
+    Package, Composition
+};
+
+enum class CapacitorField {
+    Capacitance, VoltageRating, Tolerance, Esr, LeakageCurrent,
+    Package, Dielectric
+};
+
+enum class DiodeField {
+    ForwardVoltage, MaxCurrent, MaxReverseVoltage, ReverseLeakage,
+    Package, Type, Polarity
+};
+
+enum class FuseField {
+    CurrentRating, VoltageRating,
+    Package, Type
+};
+
+enum class BJTField {
+    VceMax, IcMax, PdMax, Hfe, Ft
+};
+
+// Where a field lives in the schema. lookupTable is null for numeric
+// columns.
+struct ParametricColumn {
+    const char* column;
+    const char* lookupTable;
+};
+
+ParametricColumn parametricColumn(ResistorField field);
+ParametricColumn parametricColumn(CapacitorField field);
+ParametricColumn parametricColumn(DiodeField field);
+ParametricColumn parametricColumn(FuseField field);
+ParametricColumn parametricColumn(BJTField field);
+
+// Subtype table searched for each field enum
+const char* parametricTable(ResistorField);
+const char* parametricTable(CapacitorField);
+const char* parametricTable(DiodeField);
+const char* parametricTable(FuseField);
+const char* parametricTable(BJTField);
+
+// Untyped core shared by every ParametricQuery: collects predicates and
+// compiles them into one parameterized SELECT over the subtype table.
+class ParametricQueryBase {
+public:
+    // Full SELECT statement this query runs (for logging and query plans)
+    std::string sql() const;
+
+    // Component IDs of every matching row, in no particular order
+    bool run(Database& db, std::vector<int>& componentIds, DbResult& result) const;
+
+protected:
+    explicit ParametricQueryBase(const char* table) : table_(table) {}
+
+    void addBound(ParametricColumn col, const char* op, double value);
+    void addLookupId(ParametricColumn col, int id);
+    void addLookupName(ParametricColumn col, const std::string& name);
+    void setLimit(int limit) { limit_ = limit; }
+
+private:
+    struct Predicate {
+        enum class Kind { Real, Integer, Text };
+
+        std::string sql;      // e.g. "Resistance >= ?"
+        Kind kind;
+        double real;
+        int integer;
+        std::string text;
+    };
+
+    const char* table_;
+    std::vector<Predicate> predicates_;
+    int limit_ = 0;           // 0 = no limit
+    std::string error_;       // first misuse (e.g. range on a lookup field)
+};
+
+// Typed builder. Predicates are ANDed; bounds are inclusive.
+//
+//     ResistorQuery q;
+//     q.between(ResistorField::Resistance, 9.5e3, 10.5e3)
+//      .atMost(ResistorField::Tolerance, 1.0)
+//      .atLeast(ResistorField::PowerRating, 0.25)
+//      .is(ResistorField::Package, "0805");
+//     resistorMgr.find(q, ids, result);
+template <typename Field>
+class ParametricQuery : public ParametricQueryBase {
+public:
+    ParametricQuery() : ParametricQueryBase(parametricTable(Field{})) {}
+
+    ParametricQuery& atLeast(Field field, double value) {
+        addBound(parametricColumn(field), ">=", value);
+        return *this;
+    }
+
+    ParametricQuery& atMost(Field field, double value) {
+        addBound(parametricColumn(field), "<=", value);
+        return *this;
+    }
+
+    ParametricQuery& between(Field field, double min, double max) {
+        return atLeast(field, min).atMost(field, max);
+    }
+
+    // Lookup fields only
+    ParametricQuery& is(Field field, int lookupId) {
+        addLookupId(parametricColumn(field), lookupId);
+        return *this;
+    }
+
+    ParametricQuery& is(Field field, const std::string& lookupName) {
+        addLookupName(parametricColumn(field), lookupName);
+        return *this;
+    }
+
+    ParametricQuery& limit(int maxRows) {
+        setLimit(maxRows);
+        return *this;
+    }
+};
+
+using ResistorQuery = ParametricQuery<ResistorField>;
+using CapacitorQuery = ParametricQuery<CapacitorField>;
+using DiodeQuery = ParametricQuery<DiodeField>;
+using FuseQuery = ParametricQuery<FuseField>;
+using BJTQuery = ParametricQuery<BJTField>;
@@ -0,0 +1,80 @@
+#pragma once
+#include "DbResult.h"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Aggregated cost of one SQL text (parameters unexpanded, so every call of
+// a prepared statement lands in the same entry)
+struct QueryStats {
+    std::string sql;
+    long long calls = 0;
+    long long rows = 0;            // result rows stepped
+    double totalMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    long long fullScanSteps = 0;   // SQLITE_STMTSTATUS_FULLSCAN_STEP
+    long long sorts = 0;           // SQLITE_STMTSTATUS_SORT
+    long long autoIndexes = 0;     // SQLITE_STMTSTATUS_AUTOINDEX
+    long long vmSteps = 0;         // SQLITE_STMTSTATUS_VM_STEP
+
+    double meanMs() const { return calls > 0 ? totalMs / static_cast<double>(calls) : 0.0; }
+};
+
+// Per-statement timing collected from the sqlite3_trace_v2 profile hook
+// of every Database it is attached to (Database::setProfiler). One
+// profiler may be shared by several connections, e.g. a service's writer
+// and its pooled readers; recording and snapshots are thread-safe.
+//
+// Each finished statement run adds its wall time, result rows and the
+// sqlite3_stmt_status counters. Full-scan steps, sorts and automatic
+// indexes are the usual signs of a missing index. Percentiles come from a
+// log-scale histogram (eight buckets per doubling), within about 5%.
+class QueryProfiler {
+public:
+    QueryProfiler() = default;
+
+    QueryProfiler(const QueryProfiler&) = delete;
+    QueryProfiler& operator=(const QueryProfiler&) = delete;
+
+    // Called by the trace hook when a statement run completes
+    void record(const char* sql, std::int64_t nanoseconds, long long rows,
+        long long fullScanSteps, long long sorts, long long autoIndexes, long long vmSteps);
+
+    // Current totals, most total time first
+    std::vector<QueryStats> snapshot() const;
+
+    void reset();
+
+    // {"queries": [{"sql": ..., "calls": ..., ...}, ...]} in snapshot order
+    static void writeJson(std::ostream& out, const std::vector<QueryStats>& stats);
+    bool writeJsonFile(const std::string& path, DbResult& result) const;
+
+private:
+    // Bucket b covers [2^(b/8), 2^((b+1)/8)) microseconds; the first
+    // bucket takes everything under a microsecond
+    static constexpr int kBuckets = 8 * 36;
+
+    struct Entry {
+        long long calls = 0;
+        long long rows = 0;
+        std::int64_t totalNs = 0;
+        std::int64_t maxNs = 0;
+        long long fullScanSteps = 0;
+        long long sorts = 0;
+        long long autoIndexes = 0;
+        long long vmSteps = 0;
+        std::array<std::uint32_t, kBuckets> histogram{};
+    };
+
+    static double percentileMs(const Entry& entry, double fraction);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Database.h"
+#include "DbResult.h"
+#include "DatabaseOptions.h"
+#include "QueryProfiler.h"
+#include "ComponentManager.h"
+#include "ComponentDetailsManager.h"
+#include "CategoryManager.h"
+#include "ManufacturerManager.h"
+#include "ResistorManager.h"
+#include "ResistorPackageManager.h"
+#include "ResistorCompositionManager.h"
+#include "CapacitorManager.h"
+#include "CapacitorPackageManager.h"
+#include "CapacitorDielectricManager.h"
+#include "StatsManager.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class ReaderPool;
+
+// A read-only connection with its own set of managers. Statement and
+// lookup caches live on the connection, so they stay warm across the
+// sessions that borrow it.
+class ReadConnection {
+public:
+    ReadConnection(const std::string& path, const DatabaseOptions& options, DbResult& result);
+
+    ReadConnection(const ReadConnection&) = delete;
+    ReadConnection& operator=(const ReadConnection&) = delete;
+
+    bool isOpen() const { return db_.isOpen(); }
+
+    ComponentManager& components() { return componentMgr_; }
+    ComponentDetailsManager& componentDetails() { return componentDetailsMgr_; }
+    CategoryManager& categories() { return categoryMgr_; }
+    ManufacturerManager& manufacturers() { return manufacturerMgr_; }
+    ResistorManager& resistors() { return resistorMgr_; }
+    ResistorPackageManager& resistorPackages() { return resistorPackageMgr_; }
+    ResistorCompositionManager& resistorCompositions() { return resistorCompositionMgr_; }
+    CapacitorManager& capacitors() { return capacitorMgr_; }
+    CapacitorPackageManager& capacitorPackages() { return capacitorPackageMgr_; }
+    CapacitorDielectricManager& capacitorDielectrics() { return capacitorDielectricMgr_; }
+    StatsManager& stats() { return statsMgr_; }
+    Database& database() { return db_; }
+
+private:
+    Database db_;
+    ComponentManager componentMgr_;
+    ComponentDetailsManager componentDetailsMgr_;
+    CategoryManager categoryMgr_;
+    ManufacturerManager manufacturerMgr_;
+    ResistorManager resistorMgr_;
+    ResistorPackageManager resistorPackageMgr_;
+    ResistorCompositionManager resistorCompositionMgr_;
+    CapacitorManager capacitorMgr_;
+    CapacitorPackageManager capacitorPackageMgr_;
+    CapacitorDielectricManager capacitorDielectricMgr_;
+    StatsManager statsMgr_;
+};
+
+// Exclusive loan of a pooled ReadConnection to one thread. Returns the
+// connection to the pool when destroyed; an empty session (failed or
+// moved-from acquire) holds nothing. A session shares ownership of its
+// pool, so it stays valid after the service drops or replaces the pool.
+class ReadSession {
+public:
+    ReadSession() = default;
+    ~ReadSession();
+
+    ReadSession(ReadSession&& other) noexcept;
+    ReadSession& operator=(ReadSession&& other) noexcept;
+    ReadSession(const ReadSession&) = delete;
+    ReadSession& operator=(const ReadSession&) = delete;
+
+    explicit operator bool() const { return conn_ != nullptr; }
+    ReadConnection& operator*() const { return *conn_; }
+    ReadConnection* operator->() const { return conn_; }
+
+    // Hand the connection back early
+    void release();
+
+private:
+    friend class ReaderPool;
+    ReadSession(std::shared_ptr<ReaderPool> pool, ReadConnection* conn)
+        : pool_(std::move(pool)), conn_(conn) {}
+
+    std::shared_ptr<ReaderPool> pool_;
+    ReadConnection* conn_ = nullptr;
+};
+
+// Up to maxReaders read-only connections to one database file, opened on
+// demand and reused. Any thread may acquire a session; each session is
+// used by one thread at a time, so no connection is ever shared.
+//
+// With the writer in WAL mode (DatabaseOptions::interactive) readers see
+// the last committed state and neither blocks the other. Each query sees
+// a consistent snapshot; wrap several in a Deferred Transaction on the
+// session's database to share one.
+//
+// Always owned through a shared_ptr (std::make_shared): sessions keep the
+// pool and its connections alive until the last one is released.
+class ReaderPool : public std::enable_shared_from_this<ReaderPool> {
+public:
+    ReaderPool(std::string path, int maxReaders, const DatabaseOptions& options);
+
+    ReaderPool(const ReaderPool&) = delete;
+    ReaderPool& operator=(const ReaderPool&) = delete;
+
+    // Borrow a connection, opening one if all are busy and the limit
+    // allows, otherwise waiting for one to be returned.
+    bool acquire(ReadSession& session, DbResult& result);
+
+    // Like acquire, but fails with SQLITE_BUSY instead of waiting
+    bool tryAcquire(ReadSession& session, DbResult& result);
+
+    int maxReaders() const { return maxReaders_; }
+    int openConnections() const;
+
+    // Profile the pooled connections into profiler (nullptr stops). Each
+    // connection picks the change up the next time it is acquired.
+    void setProfiler(std::shared_ptr<QueryProfiler> profiler);
+
+private:
+    friend class ReadSession;
+
+    bool acquireImpl(ReadSession& session, bool wait, DbResult& result);
+    void release(ReadConnection* conn);
+    static void attachProfiler(ReadConnection& conn, const std::shared_ptr<QueryProfiler>& profiler);
+
+    const std::string path_;
+    const int maxReaders_;
+    const DatabaseOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable returned_;
+    std::vector<std::unique_ptr<ReadConnection>> connections_;
+    std::vector<ReadConnection*> idle_;
+    int opening_ = 0;   // slots reserved by threads opening a connection
+    std::shared_ptr<QueryProfiler> profiler_;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "Database.h"
 #include "DbResult.h"
+#include "LookupManager.h"
 #include <vector>
 #include <string>
 
@@ -12,17 +13,15 @@ struct ResistorComposition {
     explicit ResistorComposition(const std::string& n) : id(0), name(n) {}
 };
 
-class ResistorCompositionManager {
+class ResistorCompositionManager : public LookupManager {
 public:
-    explicit ResistorCompositionManager(Database& db) : db_(db) {}
+    explicit ResistorCompositionManager(Database& db) : LookupManager(db, "ResistorComposition") {}
 
     bool add(const ResistorComposition& comp, DbResult& result);
     bool getById(int id, ResistorComposition& comp, DbResult& result);
     bool update(const ResistorComposition& comp, DbResult& result);
     bool remove(int id, DbResult& result);
+    // list and getByName are served from the LookupManager cache
     bool list(std::vector<ResistorComposition>& comps, DbResult& result);
     int getByName(const std::string& name, DbResult& result);
-
-private:
-    Database& db_;
 };
@@ -1,6 +1,10 @@
 #pragma once
 #include "Database.h"
 #include "DbResult.h"
+#include "ParametricQuery.h"
+#include "ComponentManager.h"
+#include <functional>
+#include <span>
 #include <vector>
 
 struct Resistor {
@@ -82,11 +86,27 @@ public:
     ResistorManager(Database& db) : db_(db) {}
 
     bool add(const Resistor& r, DbResult& result);
+
+    // Bulk inserts in one transaction (a savepoint inside the caller's).
+    // The second overload inserts comps[i] and resistors[i] together and
+    // sets resistors[i].componentId from the assigned component ID.
+    bool addBatch(std::span<const Resistor> resistors, DbResult& result);
+    bool addBatch(std::span<Component> comps, std::span<Resistor> resistors, DbResult& result);
     bool getByComponentId(int compId, Resistor& r, DbResult& result);
     bool update(const Resistor& r, DbResult& result);
     bool remove(int compId, DbResult& result);
     bool list(std::vector<Resistor>& resistors, DbResult& result);
 
+    // Streams rows one at a time instead of filling a vector; fn returns
+    // false to stop early.
+    bool forEach(const std::function<bool(const Resistor&)>& fn, DbResult& result);
+
+    // Component IDs of rows matching a parametric filter, e.g. every
+    // resistor within a value range on a given package.
+    bool find(const ResistorQuery& query, std::vector<int>& componentIds, DbResult& result);
+
 private:
+    bool insert(sqlite3_stmt* stmt, const Resistor& r, DbResult& result);
+
     Database& db_;
 };
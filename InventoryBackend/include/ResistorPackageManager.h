@@ -1,6 +1,7 @@
 #pragma once
 #include "Database.h"
 #include "DbResult.h"
+#include "LookupManager.h"
 #include <vector>
 #include <string>
 
@@ -12,17 +13,15 @@ struct ResistorPackage {
     ResistorPackage(const std::string& n) : id(0), name(n) {}
 };
 
-class ResistorPackageManager {
+class ResistorPackageManager : public LookupManager {
 public:
-    ResistorPackageManager(Database& db) : db_(db) {}
+    ResistorPackageManager(Database& db) : LookupManager(db, "ResistorPackage") {}
 
     bool add(const ResistorPackage& pkg, DbResult& result);
     bool getById(int id, ResistorPackage& pkg, DbResult& result);
     bool update(const ResistorPackage& pkg, DbResult& result);
     bool remove(int id, DbResult& result);
+    // list and getByName are served from the LookupManager cache
     bool list(std::vector<ResistorPackage>& pkgs, DbResult& result);
     int getByName(const std::string& name, DbResult& result);
-
-private:
-    Database& db_;
 };
@@ -2,14 +2,66 @@
 #include "Database.h"
 #include "DbResult.h"
 
+#include <string>
+
 class SchemaManager {
 public:
     explicit SchemaManager(Database& db) : db_(db) {}
 
     // Creates tables if missing and upgrades schema if needed.
-    // Safe to call for both new and existing databases.
+    // Safe to call for both new and existing databases. A current
+    // database costs one header read (PRAGMA user_version); pending
+    // migrations are applied in a single transaction, and any failure
+    // rolls all of them back.
     bool initialize(DbResult& result);
 
+    // For bulk loads: drop the triggers that keep ComponentsFts in sync,
+    // then recreate them and rebuild the index in one pass. Rebuilding
+    // once is several times cheaper than firing the trigger per row.
+    // Search results are stale in between.
+    //
+    // The suspension is recorded in SearchIndexSuspension under an owner
+    // token. The load calls touchSearchIndexSuspension() inside every
+    // batch it commits so other connections can see it is still running.
+    bool suspendSearchIndex(DbResult& result);
+    bool touchSearchIndexSuspension(DbResult& result);
+    bool resumeSearchIndex(DbResult& result);
+
+    // Repair after a load that never resumed: recreates the triggers and
+    // rebuilds the index only if the suspension's heartbeat is over a
+    // minute old (or the triggers are gone without one). A running load
+    // is left alone. Not part of initialize(): it costs a sqlite_master
+    // lookup, so callers run it once when opening a file for writing.
+    bool recoverSearchIndex(DbResult& result);
+
+    // Planner statistics (sqlite_stat1). Without them SQLite assumes every
+    // index is equally selective, so with low-cardinality columns such as
+    // CategoryID or a package ID it can pick an index that matches most
+    // of the table.
+    //
+    // analyzePlannerStats() re-samples Components and the subtype tables;
+    // run it after bulk loads and large deletes. Sampling is capped by
+    // PRAGMA analysis_limit, so it stays in the milliseconds at any size.
+    bool analyzePlannerStats(DbResult& result);
+
+    // PRAGMA optimize: re-analyzes only the tables whose statistics the
+    // connection's queries showed to be missing or stale. Meant for
+    // closing a long-lived connection.
+    bool optimizePlannerStats(DbResult& result);
+
+    // Fixed statistics describing a typical inventory (about 10k
+    // components), for a fresh database whose tables are still too small
+    // to analyze. Does nothing once sqlite_stat1 holds index statistics.
+    bool seedPlannerStats(DbResult& result);
+
 private:
+    // user_version; withHistory falls back to the SchemaVersion history
+    // for files migrated before the header was kept
+    bool storedVersion(int& version, bool withHistory, DbResult& result);
+
+    // Adds a migration's row to SchemaVersion
+    bool recordVersion(int version, const char* description, DbResult& result);
+
     Database& db_;
+    std::string suspensionOwner_;   // token of the suspension this object holds
 };
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <sqlite3.h>
+
+class StatementCache;
+
+// RAII handle to a prepared statement borrowed from a StatementCache.
+// On release the statement is reset and its bindings cleared, then handed
+// back to the cache (or finalized if it was never cached).
+// Converts implicitly to sqlite3_stmt* so it can be passed straight to
+// sqlite3_bind_* / sqlite3_step / sqlite3_column_*.
+class CachedStatement {
+public:
+    CachedStatement() = default;
+    ~CachedStatement() { release(); }
+
+    CachedStatement(const CachedStatement&) = delete;
+    CachedStatement& operator=(const CachedStatement&) = delete;
+
+    CachedStatement(CachedStatement&& other) noexcept;
+    CachedStatement& operator=(CachedStatement&& other) noexcept;
+
+    sqlite3_stmt* get() const { return stmt_; }
+    operator sqlite3_stmt*() const { return stmt_; }
+    explicit operator bool() const { return stmt_ != nullptr; }
+
+    // Reset + clear bindings so the handle can be re-bound in a loop
+    // without giving the statement back to the cache.
+    void reset();
+
+    // Return the statement to its cache now instead of at scope exit.
+    void release();
+
+private:
+    friend class StatementCache;
+    CachedStatement(StatementCache* owner, sqlite3_stmt* stmt)
+        : owner_(owner), stmt_(stmt) {
+    }
+
+    StatementCache* owner_ = nullptr;   // nullptr => finalize on release
+    sqlite3_stmt* stmt_ = nullptr;
+};
+
+// Least-recently-used cache of prepared statements keyed by SQL text.
+// A statement is handed out to at most one CachedStatement at a time; a
+// second concurrent request for the same SQL gets an uncached statement.
+class StatementCache {
+public:
+    static constexpr std::size_t kDefaultCapacity = 64;
+
+    explicit StatementCache(std::size_t capacity = kDefaultCapacity)
+        : capacity_(capacity) {
+    }
+    ~StatementCache() { clear(); }
+
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    // Returns SQLITE_OK and fills stmt, or the sqlite3_prepare_v2 error code.
+    int acquire(sqlite3* db, const std::string& sql, CachedStatement& stmt);
+
+    // Finalize every idle statement. Statements currently checked out are
+    // left alone and are finalized when their handle is released.
+    void clear();
+
+    void setCapacity(std::size_t capacity);
+    std::size_t capacity() const { return capacity_; }
+    std::size_t size() const { return entries_.size(); }
+
+private:
+    friend class CachedStatement;
+
+    struct Entry {
+        std::string sql;
+        sqlite3_stmt* stmt;
+        bool inUse;
+    };
+
+    void giveBack(sqlite3_stmt* stmt);
+    void evictIdle();
+
+    std::size_t capacity_;
+    std::list<Entry> entries_; // front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::unordered_map<sqlite3_stmt*, std::list<Entry>::iterator> byStmt_;
+};
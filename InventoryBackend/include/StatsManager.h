@@ -0,0 +1,56 @@
+#pragma once
+#include "Database.h"
+#include "DbResult.h"
+
+#include <string>
+#include <vector>
+
+// Stock totals of a group of components
+struct StockTotals {
+    long long components = 0;
+    long long totalQuantity = 0;
+    long long zeroStock = 0;      // components with Quantity <= 0
+};
+
+// Totals of one category or manufacturer. id 0 with an empty name
+// collects components without a manufacturer.
+struct StockGroup {
+    int id = 0;
+    std::string name;
+    StockTotals totals;
+};
+
+// Totals of one package within a subtype family ("Resistor", "Capacitor",
+// "Transistor", "Fuse", "Diode"). packageId 0 collects subtype rows
+// without a package; components without a subtype row are not counted.
+struct PackageStockGroup {
+    std::string family;
+    int packageId = 0;
+    std::string name;
+    StockTotals totals;
+};
+
+// Inventory totals read from the CategoryStats, ManufacturerStats and
+// PackageStats tables, which triggers keep exact on every write (schema
+// version 12). Each call reads one row per group instead of scanning
+// Components, so its cost does not grow with the inventory.
+class StatsManager {
+public:
+    explicit StatsManager(Database& db) : db_(db) {}
+
+    // Whole inventory
+    bool totals(StockTotals& totals, DbResult& result);
+
+    // One category; all zero if it has no components
+    bool categoryTotals(int categoryId, StockTotals& totals, DbResult& result);
+
+    // Non-empty groups, by name
+    bool byCategory(std::vector<StockGroup>& groups, DbResult& result);
+    bool byManufacturer(std::vector<StockGroup>& groups, DbResult& result);
+    bool byPackage(std::vector<PackageStockGroup>& groups, DbResult& result);
+
+private:
+    bool listGroups(const std::string& sql, std::vector<StockGroup>& groups, DbResult& result);
+
+    Database& db_;
+};
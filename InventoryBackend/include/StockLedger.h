@@ -0,0 +1,64 @@
+#pragma once
+#include "Database.h"
+#include "DbResult.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
+// Why stock moved. Receive must add stock and Consume must remove it;
+// Adjust (stock-take corrections) may go either way.
+enum class StockMovementKind { Receive, Consume, Adjust };
+
+// One row of the StockMovements ledger
+struct StockMovement {
+    long long id = 0;
+    int componentId = 0;
+    StockMovementKind kind = StockMovementKind::Adjust;
+    int delta = 0;
+    int quantityAfter = 0;    // Components.Quantity right after this movement
+    std::string reason;
+    std::string createdOn;
+};
+
+struct StockAdjustment {
+    int componentId = 0;
+    int delta = 0;
+};
+
+// Stock changes as deltas with an append-only history.
+//
+// Each movement is `Quantity = Quantity + delta` plus a StockMovements
+// row, in one transaction. Nothing is read first, so adjustments from
+// several pick stations (or connections) serialize on the write lock
+// and never overwrite each other the way a read-modify-write through
+// ComponentManager::update would. A movement that would take Quantity
+// below zero fails with SQLITE_CONSTRAINT; a missing component with
+// SQLITE_NOTFOUND.
+//
+// Ledger rows cannot be updated; they go away only with their component.
+class StockLedger {
+public:
+    explicit StockLedger(Database& db) : db_(db) {}
+
+    // newQuantity receives the stock level after the movement
+    bool adjustQuantity(int componentId, int delta, StockMovementKind kind,
+        const std::string& reason, int& newQuantity, DbResult& result);
+
+    // Adjust with no reason, for quick corrections
+    bool adjustQuantity(int componentId, int delta, DbResult& result);
+
+    // Kit picking and receiving a delivery: every line in one transaction,
+    // all or nothing. On failure result names the offending component.
+    bool adjustBatch(std::span<const StockAdjustment> adjustments, StockMovementKind kind,
+        const std::string& reason, DbResult& result);
+
+    // Movements of one component, oldest first
+    bool history(int componentId, std::vector<StockMovement>& movements, DbResult& result);
+
+private:
+    bool apply(int componentId, int delta, StockMovementKind kind,
+        const std::string& reason, int& newQuantity, DbResult& result);
+
+    Database& db_;
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include "DbResult.h"
+
+class Database;
+
+// RAII transaction guard.
+//
+// The outermost guard on a connection issues BEGIN; guards opened while a
+// transaction is already running use a SAVEPOINT instead, so an inner
+// failure can be undone without abandoning the outer work. Whatever has
+// not been committed when the guard is destroyed is rolled back.
+//
+//     Transaction tx(db, result);
+//     if (!tx.isActive()) return false;
+//     ... writes ...
+//     return tx.commit(result);
+class Transaction {
+public:
+    enum class Mode {
+        Deferred,   // BEGIN (take the write lock on first write)
+        Immediate   // BEGIN IMMEDIATE (take the write lock up front)
+    };
+
+    Transaction(Database& db, DbResult& result, Mode mode = Mode::Deferred);
+    ~Transaction();
+
+    Transaction(const Transaction&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+
+    bool isActive() const { return active_; }
+    bool isNested() const { return !savepoint_.empty(); }
+
+    // COMMIT (outermost) or RELEASE (nested). On failure the guard stays
+    // active and rolls back on destruction.
+    bool commit(DbResult& result);
+
+    // Roll back now instead of at scope exit.
+    void rollback();
+
+private:
+    Database& db_;
+    std::string savepoint_;
+    bool active_;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "Database.h"
 #include "DbResult.h"
+#include <functional>
 #include <vector>
 
 struct Transistor {
@@ -28,6 +29,10 @@ public:
     bool add(const Transistor& t, DbResult& result);
     bool getById(int componentId, Transistor& t, DbResult& result);
     bool list(std::vector<Transistor>& ts, DbResult& result);
+
+    // Streams rows one at a time instead of filling a vector; fn returns
+    // false to stop early.
+    bool forEach(const std::function<bool(const Transistor&)>& fn, DbResult& result);
     bool remove(int componentId, DbResult& result);
 
 private:
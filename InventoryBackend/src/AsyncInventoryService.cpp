@@ -0,0 +1,105 @@
+#include "AsyncInventoryService.h"
+#include <sqlite3.h>
+
+#include <utility>
+
+AsyncInventoryService::AsyncInventoryService()
+    : worker_([this] { run(); })
+{
+}
+
+AsyncInventoryService::~AsyncInventoryService()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+    }
+    queued_.notify_one();
+    worker_.join();
+}
+
+std::future<DbResult> AsyncInventoryService::open(const std::string& path,
+    const DatabaseOptions& options)
+{
+    auto done = std::make_shared<std::promise<DbResult>>();
+    auto future = done->get_future();
+
+    enqueue([this, path, options, done] {
+        setReaders(nullptr);
+        service_.reset();
+
+        DbResult result;
+        service_ = InventoryService::open(path, options, result);
+        if (service_)
+            setReaders(service_->readers());
+        done->set_value(result);
+    });
+    return future;
+}
+
+std::future<void> AsyncInventoryService::close()
+{
+    auto done = std::make_shared<std::promise<void>>();
+    auto future = done->get_future();
+
+    enqueue([this, done] {
+        setReaders(nullptr);
+        service_.reset();
+        done->set_value();
+    });
+    return future;
+}
+
+void AsyncInventoryService::post(Task task)
+{
+    enqueue([this, task = std::move(task)] { task(service_.get()); });
+}
+
+bool AsyncInventoryService::readSession(ReadSession& session, DbResult& result)
+{
+    std::shared_ptr<ReaderPool> readers;
+    {
+        std::lock_guard<std::mutex> lock(readersMutex_);
+        readers = readers_;
+    }
+    if (!readers) {
+        session.release();
+        result.setError(SQLITE_MISUSE, "No file database is open");
+        return false;
+    }
+    return readers->acquire(session, result);
+}
+
+void AsyncInventoryService::enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queue_.push_back(std::move(job));
+    }
+    queued_.notify_one();
+}
+
+void AsyncInventoryService::run()
+{
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queued_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+                break;   // stopping, and everything queued has run
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        job();
+    }
+
+    setReaders(nullptr);
+    service_.reset();
+}
+
+void AsyncInventoryService::setReaders(std::shared_ptr<ReaderPool> readers)
+{
+    std::lock_guard<std::mutex> lock(readersMutex_);
+    readers_ = std::move(readers);
+}
@@ -7,8 +7,8 @@ BJTManager::BJTManager(Database& db) : db_(db) {}
 // Add BJT with prepared statement
 bool BJTManager::add(const BJT& bjt, DbResult& result) {
     // Optional: validate component exists
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "INSERT INTO BJTs (ComponentID, VceMax, IcMax, PdMax, Hfe, Ft) "
         "VALUES (?, ?, ?, ?, ?, ?);",
         stmt, result)) return false;
@@ -22,19 +22,17 @@ bool BJTManager::add(const BJT& bjt, DbResult& result) {
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Get BJT by ComponentID
 bool BJTManager::getById(int componentId, BJT& bjt, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "SELECT ComponentID, VceMax, IcMax, PdMax, Hfe, Ft FROM BJTs WHERE ComponentID=?;",
         stmt, result)) return false;
 
@@ -54,14 +52,13 @@ bool BJTManager::getById(int componentId, BJT& bjt, DbResult& result) {
         result.setError(sqlite3_errcode(db_.handle()), "BJT not found");
     }
 
-    db_.finalize(stmt);
     return ok;
 }
 
 // Update BJT
 bool BJTManager::update(const BJT& bjt, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "UPDATE BJTs SET VceMax=?, IcMax=?, PdMax=?, Hfe=?, Ft=? WHERE ComponentID=?;",
         stmt, result)) return false;
 
@@ -74,58 +71,57 @@ bool BJTManager::update(const BJT& bjt, DbResult& result) {
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Remove BJT
 bool BJTManager::remove(int componentId, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("DELETE FROM BJTs WHERE ComponentID=?;", stmt, result)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached("DELETE FROM BJTs WHERE ComponentID=?;", stmt, result)) return false;
     sqlite3_bind_int(stmt, 1, componentId);
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // List all BJTs
 bool BJTManager::list(std::vector<BJT>& bjts, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ComponentID, VceMax, IcMax, PdMax, Hfe, Ft FROM BJTs;", stmt, result))
-        return false;
-
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        BJT b;
-        b.componentId = sqlite3_column_int(stmt, 0);
-        b.vceMax = sqlite3_column_double(stmt, 1);
-        b.icMax = sqlite3_column_double(stmt, 2);
-        b.pdMax = sqlite3_column_double(stmt, 3);
-        b.hfe = sqlite3_column_double(stmt, 4);
-        b.ft = sqlite3_column_double(stmt, 5);
+    return forEach([&](const BJT& b) {
         bjts.push_back(b);
-    }
+        return true;
+    }, result);
+}
 
-    db_.finalize(stmt);
-    result.clear();
-    return true;
+bool BJTManager::forEach(const std::function<bool(const BJT&)>& fn, DbResult& result) {
+    CachedStatement stmt;
+    if (!db_.prepareCached("SELECT ComponentID, VceMax, IcMax, PdMax, Hfe, Ft FROM BJTs ORDER BY ComponentID;", stmt, result))
+        return false;
+
+    BJT b;
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        b.componentId = sqlite3_column_int(row, 0);
+        b.vceMax = sqlite3_column_double(row, 1);
+        b.icMax = sqlite3_column_double(row, 2);
+        b.pdMax = sqlite3_column_double(row, 3);
+        b.hfe = sqlite3_column_double(row, 4);
+        b.ft = sqlite3_column_double(row, 5);
+        return fn(b);
+    }, result);
 }
 
 // Optional: Lookup for GUI dropdowns
 bool BJTManager::listLookup(std::vector<LookupItem>& items, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "SELECT c.ID, c.PartNumber FROM Components c "
         "INNER JOIN BJTs b ON c.ID = b.ComponentID;", stmt, result)) return false;
 
@@ -134,7 +130,10 @@ bool BJTManager::listLookup(std::vector<LookupItem>& items, DbResult& result) {
         items.push_back({ sqlite3_column_int(stmt, 0), safeColumnText(stmt, 1) });
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
+
+bool BJTManager::find(const BJTQuery& query, std::vector<int>& componentIds, DbResult& result) {
+    return query.run(db_, componentIds, result);
+}
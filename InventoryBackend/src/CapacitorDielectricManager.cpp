@@ -1,7 +1,7 @@
 #include "CapacitorDielectricManager.h"
 #include <sqlite3.h>
 
-CapacitorDielectricManager::CapacitorDielectricManager(Database& db) : db_(db) {}
+CapacitorDielectricManager::CapacitorDielectricManager(Database& db) : LookupManager(db, "CapacitorDielectric") {}
 
 bool CapacitorDielectricManager::add(const CapacitorDielectric& diel, DbResult& result) {
     sqlite3_stmt* stmt = nullptr;
@@ -17,6 +17,7 @@ bool CapacitorDielectricManager::add(const CapacitorDielectric& diel, DbResult&
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -41,19 +42,16 @@ bool CapacitorDielectricManager::getById(int id, CapacitorDielectric& diel, DbRe
 }
 
 bool CapacitorDielectricManager::list(std::vector<CapacitorDielectric>& diels, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID, Name FROM CapacitorDielectric;", stmt, result))
+    std::vector<LookupItem> items;
+    if (!listLookup(items, result))
         return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    for (const LookupItem& item : items) {
         CapacitorDielectric diel;
-        diel.id = sqlite3_column_int(stmt, 0);
-        diel.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        diel.id = item.id;
+        diel.name = item.name;
         diels.push_back(diel);
     }
-
-    db_.finalize(stmt);
-    result.clear();
     return true;
 }
 
@@ -71,21 +69,11 @@ bool CapacitorDielectricManager::remove(int id, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
 
 int CapacitorDielectricManager::getByName(const std::string& name, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID FROM CapacitorDielectric WHERE Name=?;", stmt, result))
-        return -1;
-
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-
-    int id = -1;
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-        id = sqlite3_column_int(stmt, 0);
-
-    sqlite3_finalize(stmt);
-    return id;
+    return getIdByName(name, result);
 }
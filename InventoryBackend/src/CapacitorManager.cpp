@@ -1,23 +1,20 @@
 #include "CapacitorManager.h"
 #include "DbUtils.h"
+#include "Transaction.h"
 #include <sqlite3.h>
 
 CapacitorManager::CapacitorManager(Database& db) : db_(db) {}
 
-// Add capacitor
-bool CapacitorManager::add(const Capacitor& cap, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
-        "INSERT INTO Capacitors "
-        "(ComponentID, Capacitance, VoltageRating, Tolerance, ESR, LeakageCurrent, "
-        "Polarized, PackageTypeID, DielectricTypeID, "
-        "Diameter, Height, LeadSpacing, Length, Width) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);",
-        stmt, result))
-    {
-        return false;
-    }
+namespace {
 
+const char* const kInsertCapacitorSql =
+    "INSERT INTO Capacitors "
+    "(ComponentID, Capacitance, VoltageRating, Tolerance, ESR, LeakageCurrent, "
+    "Polarized, PackageTypeID, DielectricTypeID, "
+    "Diameter, Height, LeadSpacing, Length, Width) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+
+void bindCapacitorInsert(sqlite3_stmt* stmt, const Capacitor& cap) {
     sqlite3_bind_int(stmt, 1, cap.componentId);
     sqlite3_bind_double(stmt, 2, cap.capacitance);
     sqlite3_bind_double(stmt, 3, cap.voltageRating);
@@ -25,29 +22,109 @@ bool CapacitorManager::add(const Capacitor& cap, DbResult& result) {
     sqlite3_bind_double(stmt, 5, cap.esr);
     sqlite3_bind_double(stmt, 6, cap.leakageCurrent);
     sqlite3_bind_int(stmt, 7, cap.polarized ? 1 : 0);
-    sqlite3_bind_int(stmt, 8, cap.packageTypeId);
-    sqlite3_bind_int(stmt, 9, cap.dielectricTypeId);
+    bindOptionalId(stmt, 8, cap.packageTypeId);
+    bindOptionalId(stmt, 9, cap.dielectricTypeId);
     sqlite3_bind_double(stmt, 10, cap.diameter);
     sqlite3_bind_double(stmt, 11, cap.height);
     sqlite3_bind_double(stmt, 12, cap.leadSpacing);
     sqlite3_bind_double(stmt, 13, cap.length);
     sqlite3_bind_double(stmt, 14, cap.width);
+}
+
+} // namespace
+
+// Add capacitor
+bool CapacitorManager::add(const Capacitor& cap, DbResult& result) {
+    CachedStatement stmt;
+    if (!db_.prepareCached(kInsertCapacitorSql, stmt, result))
+    {
+        return false;
+    }
+
+    return insert(stmt, cap, result);
+}
+
+// Add many capacitor rows in one transaction
+bool CapacitorManager::addBatch(std::span<const Capacitor> caps, DbResult& result) {
+    if (caps.empty()) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result);
+    if (!tx.isActive())
+        return false;
+
+    CachedStatement stmt;
+    bool ok = db_.prepareCached(kInsertCapacitorSql, stmt, result);
+
+    for (std::size_t i = 0; ok && i < caps.size(); ++i) {
+        ok = insert(stmt, caps[i], result);
+        stmt.reset();
+    }
+    stmt.release();
+
+    if (!ok || !tx.commit(result))
+        return false;
+
+    result.clear();
+    return true;
+}
+
+// Add components together with their capacitor rows in one transaction
+bool CapacitorManager::addBatch(std::span<Component> comps, std::span<Capacitor> caps,
+    DbResult& result) {
+    if (comps.size() != caps.size()) {
+        result.setError(SQLITE_MISUSE, "Component and capacitor counts differ");
+        return false;
+    }
+    if (comps.empty()) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result);
+    if (!tx.isActive())
+        return false;
+
+    ComponentManager compMgr(db_);
+    CachedStatement stmt;
+    bool ok = db_.prepareCached(kInsertCapacitorSql, stmt, result);
+
+    for (std::size_t i = 0; ok && i < comps.size(); ++i) {
+        ok = compMgr.add(comps[i], result);
+        if (!ok)
+            break;
+
+        caps[i].componentId = comps[i].id;
+        ok = insert(stmt, caps[i], result);
+        stmt.reset();
+    }
+    stmt.release();
+
+    if (!ok || !tx.commit(result))
+        return false;
+
+    result.clear();
+    return true;
+}
+
+bool CapacitorManager::insert(sqlite3_stmt* stmt, const Capacitor& cap, DbResult& result) {
+    bindCapacitorInsert(stmt, cap);
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Get capacitor by component ID
 bool CapacitorManager::getById(int id, Capacitor& cap, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "SELECT ComponentID, Capacitance, VoltageRating, Tolerance, ESR, LeakageCurrent, "
         "Polarized, PackageTypeID, DielectricTypeID, "
         "Diameter, Height, LeadSpacing, Length, Width "
@@ -78,19 +155,17 @@ bool CapacitorManager::getById(int id, Capacitor& cap, DbResult& result) {
     }
     else {
         result.setError(sqlite3_errcode(db_.handle()), "Capacitor not found");
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Update capacitor
 bool CapacitorManager::update(const Capacitor& cap, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "UPDATE Capacitors SET "
         "Capacitance=?, VoltageRating=?, Tolerance=?, ESR=?, LeakageCurrent=?, "
         "Polarized=?, PackageTypeID=?, DielectricTypeID=?, "
@@ -107,8 +182,8 @@ bool CapacitorManager::update(const Capacitor& cap, DbResult& result) {
     sqlite3_bind_double(stmt, 4, cap.esr);
     sqlite3_bind_double(stmt, 5, cap.leakageCurrent);
     sqlite3_bind_int(stmt, 6, cap.polarized ? 1 : 0);
-    sqlite3_bind_int(stmt, 7, cap.packageTypeId);
-    sqlite3_bind_int(stmt, 8, cap.dielectricTypeId);
+    bindOptionalId(stmt, 7, cap.packageTypeId);
+    bindOptionalId(stmt, 8, cap.dielectricTypeId);
     sqlite3_bind_double(stmt, 9, cap.diameter);
     sqlite3_bind_double(stmt, 10, cap.height);
     sqlite3_bind_double(stmt, 11, cap.leadSpacing);
@@ -118,19 +193,17 @@ bool CapacitorManager::update(const Capacitor& cap, DbResult& result) {
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Delete capacitor
 bool CapacitorManager::remove(int id, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("DELETE FROM Capacitors WHERE ComponentID=?;", stmt, result)) {
+    CachedStatement stmt;
+    if (!db_.prepareCached("DELETE FROM Capacitors WHERE ComponentID=?;", stmt, result)) {
         return false;
     }
 
@@ -138,50 +211,55 @@ bool CapacitorManager::remove(int id, DbResult& result) {
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // List all capacitors
 bool CapacitorManager::list(std::vector<Capacitor>& caps, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    return forEach([&](const Capacitor& cap) {
+        caps.push_back(cap);
+        return true;
+    }, result);
+}
+
+bool CapacitorManager::forEach(const std::function<bool(const Capacitor&)>& fn, DbResult& result) {
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "SELECT ComponentID, Capacitance, VoltageRating, Tolerance, ESR, LeakageCurrent, "
         "Polarized, PackageTypeID, DielectricTypeID, "
         "Diameter, Height, LeadSpacing, Length, Width "
-        "FROM Capacitors;",
+        "FROM Capacitors ORDER BY ComponentID;",
         stmt, result))
     {
         return false;
     }
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Capacitor cap;
-        cap.componentId = sqlite3_column_int(stmt, 0);
-        cap.capacitance = sqlite3_column_double(stmt, 1);
-        cap.voltageRating = sqlite3_column_double(stmt, 2);
-        cap.tolerance = sqlite3_column_double(stmt, 3);
-        cap.esr = sqlite3_column_double(stmt, 4);
-        cap.leakageCurrent = sqlite3_column_double(stmt, 5);
-        cap.polarized = sqlite3_column_int(stmt, 6) != 0;
-        cap.packageTypeId = sqlite3_column_int(stmt, 7);
-        cap.dielectricTypeId = sqlite3_column_int(stmt, 8);
+    Capacitor cap;
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        cap.componentId = sqlite3_column_int(row, 0);
+        cap.capacitance = sqlite3_column_double(row, 1);
+        cap.voltageRating = sqlite3_column_double(row, 2);
+        cap.tolerance = sqlite3_column_double(row, 3);
+        cap.esr = sqlite3_column_double(row, 4);
+        cap.leakageCurrent = sqlite3_column_double(row, 5);
+        cap.polarized = sqlite3_column_int(row, 6) != 0;
+        cap.packageTypeId = sqlite3_column_int(row, 7);
+        cap.dielectricTypeId = sqlite3_column_int(row, 8);
 
-        cap.diameter = sqlite3_column_double(stmt, 9);
-        cap.height = sqlite3_column_double(stmt, 10);
-        cap.leadSpacing = sqlite3_column_double(stmt, 11);
-        cap.length = sqlite3_column_double(stmt, 12);
-        cap.width = sqlite3_column_double(stmt, 13);
+        cap.diameter = sqlite3_column_double(row, 9);
+        cap.height = sqlite3_column_double(row, 10);
+        cap.leadSpacing = sqlite3_column_double(row, 11);
+        cap.length = sqlite3_column_double(row, 12);
+        cap.width = sqlite3_column_double(row, 13);
 
-        caps.push_back(std::move(cap));
-    }
+        return fn(cap);
+    }, result);
+}
 
-    db_.finalize(stmt);
-    result.clear();
-    return true;
+bool CapacitorManager::find(const CapacitorQuery& query, std::vector<int>& componentIds, DbResult& result) {
+    return query.run(db_, componentIds, result);
 }
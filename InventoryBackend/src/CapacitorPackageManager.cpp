@@ -1,7 +1,7 @@
 #include "CapacitorPackageManager.h"
 #include <sqlite3.h>
 
-CapacitorPackageManager::CapacitorPackageManager(Database& db) : db_(db) {}
+CapacitorPackageManager::CapacitorPackageManager(Database& db) : LookupManager(db, "CapacitorPackage") {}
 
 bool CapacitorPackageManager::add(const CapacitorPackage& pkg, DbResult& result) {
     sqlite3_stmt* stmt = nullptr;
@@ -17,6 +17,7 @@ bool CapacitorPackageManager::add(const CapacitorPackage& pkg, DbResult& result)
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -40,19 +41,16 @@ bool CapacitorPackageManager::getById(int id, CapacitorPackage& pkg, DbResult& r
 }
 
 bool CapacitorPackageManager::list(std::vector<CapacitorPackage>& pkgs, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID, Name FROM CapacitorPackage;", stmt, result))
+    std::vector<LookupItem> items;
+    if (!listLookup(items, result))
         return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    for (const LookupItem& item : items) {
         CapacitorPackage pkg;
-        pkg.id = sqlite3_column_int(stmt, 0);
-        pkg.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        pkg.id = item.id;
+        pkg.name = item.name;
         pkgs.push_back(pkg);
     }
-
-    db_.finalize(stmt);
-    result.clear();
     return true;
 }
 
@@ -70,21 +68,11 @@ bool CapacitorPackageManager::remove(int id, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
 
 int CapacitorPackageManager::getByName(const std::string& name, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID FROM CapacitorPackage WHERE Name=?;", stmt, result))
-        return -1;
-
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-
-    int id = -1;
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-        id = sqlite3_column_int(stmt, 0);
-
-    sqlite3_finalize(stmt);
-    return id;
+    return getIdByName(name, result);
 }
@@ -31,6 +31,7 @@ bool CategoryManager::add(
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -91,6 +92,7 @@ bool CategoryManager::update(
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -117,6 +119,7 @@ bool CategoryManager::remove(
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -0,0 +1,291 @@
+#include "ComponentDetailsManager.h"
+#include "DbUtils.h"
+#include <sqlite3.h>
+
+#include <span>
+#include <string>
+
+namespace {
+
+// Column groups, in select order. Each reader below consumes its group
+// in this order.
+constexpr const char* kComponentColumns[] = {
+    "c.ID", "c.CategoryID", "c.PartNumber", "c.ManufacturerID", "c.Description", "c.Notes",
+    "c.Quantity", "c.DatasheetLink", "c.CreatedOn", "c.ModifiedOn", "cat.Name", "m.Name",
+};
+constexpr const char* kResistorColumns[] = {
+    "r.ComponentID", "r.Resistance", "r.Tolerance", "r.PowerRating", "r.TempCoeffMin",
+    "r.TempCoeffMax", "r.TempMin", "r.TempMax", "r.PackageTypeID", "r.CompositionID",
+    "r.LeadSpacing", "r.VoltageRating", "rp.Name", "rc.Name",
+};
+constexpr const char* kCapacitorColumns[] = {
+    "cap.ComponentID", "cap.Capacitance", "cap.VoltageRating", "cap.Tolerance", "cap.ESR",
+    "cap.LeakageCurrent", "cap.Polarized", "cap.PackageTypeID", "cap.DielectricTypeID",
+    "cap.Diameter", "cap.Height", "cap.LeadSpacing", "cap.Length", "cap.Width", "cp.Name", "cd.Name",
+};
+constexpr const char* kTransistorColumns[] = {
+    "t.ComponentID", "t.TypeID", "t.PolarityID", "t.PackageID", "tt.Name", "tpol.Name", "tp.Name",
+};
+constexpr const char* kBJTColumns[] = {
+    "b.ComponentID", "b.VceMax", "b.IcMax", "b.PdMax", "b.Hfe", "b.Ft",
+};
+constexpr const char* kFuseColumns[] = {
+    "f.ComponentId", "f.PackageId", "f.TypeId", "f.CurrentRating", "f.VoltageRating",
+    "fp.Name", "ft.Name",
+};
+constexpr const char* kDiodeColumns[] = {
+    "d.ComponentId", "d.PackageId", "d.TypeId", "d.PolarityId", "d.ForwardVoltage",
+    "d.MaxCurrent", "d.MaxReverseVoltage", "d.ReverseLeakage", "dp.Name", "dt.Name", "dpol.Name",
+};
+
+constexpr std::span<const char* const> kColumnGroups[] = {
+    kComponentColumns, kResistorColumns, kCapacitorColumns, kTransistorColumns,
+    kBJTColumns, kFuseColumns, kDiodeColumns,
+};
+
+// Select-list position of the first column of group
+constexpr int groupStart(int group)
+{
+    int col = 0;
+    for (int i = 0; i < group; ++i)
+        col += static_cast<int>(kColumnGroups[i].size());
+    return col;
+}
+
+enum : int {
+    ColComponent = groupStart(0),
+    ColResistor = groupStart(1),
+    ColCapacitor = groupStart(2),
+    ColTransistor = groupStart(3),
+    ColBJT = groupStart(4),
+    ColFuse = groupStart(5),
+    ColDiode = groupStart(6),
+};
+
+// "SELECT <every group's columns> " for the statements below
+std::string selectDetailsColumns()
+{
+    std::string sql = "SELECT ";
+    const char* separator = "";
+    for (std::span<const char* const> group : kColumnGroups) {
+        for (const char* column : group) {
+            sql += separator;
+            sql += column;
+            separator = ", ";
+        }
+    }
+    return sql + " ";
+}
+
+bool present(sqlite3_stmt* stmt, int col)
+{
+    return sqlite3_column_type(stmt, col) != SQLITE_NULL;
+}
+
+ResistorDetails readResistor(sqlite3_stmt* stmt, int col)
+{
+    ResistorDetails d;
+    Resistor& r = d.resistor;
+    r.componentId = sqlite3_column_int(stmt, col++);
+    r.resistance = sqlite3_column_double(stmt, col++);
+    r.tolerance = sqlite3_column_double(stmt, col++);
+    r.powerRating = sqlite3_column_double(stmt, col++);
+
+    // Same NULL convention as ResistorManager::getByComponentId
+    r.hasTempCoeff = present(stmt, col);
+    r.tempCoeffMin = sqlite3_column_double(stmt, col++);
+    r.tempCoeffMax = sqlite3_column_double(stmt, col++);
+    r.hasTempRange = present(stmt, col);
+    r.tempMin = sqlite3_column_double(stmt, col++);
+    r.tempMax = sqlite3_column_double(stmt, col++);
+
+    r.packageTypeId = sqlite3_column_int(stmt, col++);
+    r.compositionId = sqlite3_column_int(stmt, col++);
+    r.leadSpacing = sqlite3_column_double(stmt, col++);
+    r.voltageRating = sqlite3_column_double(stmt, col++);
+    d.packageName = safeColumnText(stmt, col++);
+    d.compositionName = safeColumnText(stmt, col++);
+    return d;
+}
+
+CapacitorDetails readCapacitor(sqlite3_stmt* stmt, int col)
+{
+    CapacitorDetails d;
+    Capacitor& cap = d.capacitor;
+    cap.componentId = sqlite3_column_int(stmt, col++);
+    cap.capacitance = sqlite3_column_double(stmt, col++);
+    cap.voltageRating = sqlite3_column_double(stmt, col++);
+    cap.tolerance = sqlite3_column_double(stmt, col++);
+    cap.esr = sqlite3_column_double(stmt, col++);
+    cap.leakageCurrent = sqlite3_column_double(stmt, col++);
+    cap.polarized = sqlite3_column_int(stmt, col++) != 0;
+    cap.packageTypeId = sqlite3_column_int(stmt, col++);
+    cap.dielectricTypeId = sqlite3_column_int(stmt, col++);
+    cap.diameter = sqlite3_column_double(stmt, col++);
+    cap.height = sqlite3_column_double(stmt, col++);
+    cap.leadSpacing = sqlite3_column_double(stmt, col++);
+    cap.length = sqlite3_column_double(stmt, col++);
+    cap.width = sqlite3_column_double(stmt, col++);
+    d.packageName = safeColumnText(stmt, col++);
+    d.dielectricName = safeColumnText(stmt, col++);
+    return d;
+}
+
+TransistorDetails readTransistor(sqlite3_stmt* stmt, int col)
+{
+    TransistorDetails d;
+    Transistor& t = d.transistor;
+    t.componentId = sqlite3_column_int(stmt, col++);
+    t.typeId = sqlite3_column_int(stmt, col++);
+    t.polarityId = sqlite3_column_int(stmt, col++);
+    t.packageId = sqlite3_column_int(stmt, col++);
+    d.typeName = safeColumnText(stmt, col++);
+    d.polarityName = safeColumnText(stmt, col++);
+    d.packageName = safeColumnText(stmt, col++);
+
+    if (present(stmt, ColBJT)) {
+        col = ColBJT;
+        BJT b;
+        b.componentId = sqlite3_column_int(stmt, col++);
+        b.vceMax = sqlite3_column_double(stmt, col++);
+        b.icMax = sqlite3_column_double(stmt, col++);
+        b.pdMax = sqlite3_column_double(stmt, col++);
+        b.hfe = sqlite3_column_double(stmt, col++);
+        b.ft = sqlite3_column_double(stmt, col++);
+        d.bjt = b;
+    }
+    return d;
+}
+
+FuseDetails readFuse(sqlite3_stmt* stmt, int col)
+{
+    FuseDetails d;
+    Fuse& f = d.fuse;
+    f.componentId = sqlite3_column_int(stmt, col++);
+    f.packageId = sqlite3_column_int(stmt, col++);
+    f.typeId = sqlite3_column_int(stmt, col++);
+    f.currentRating = sqlite3_column_double(stmt, col++);
+    f.voltageRating = sqlite3_column_double(stmt, col++);
+    d.packageName = safeColumnText(stmt, col++);
+    d.typeName = safeColumnText(stmt, col++);
+    return d;
+}
+
+DiodeDetails readDiode(sqlite3_stmt* stmt, int col)
+{
+    DiodeDetails d;
+    Diode& diode = d.diode;
+    diode.componentId = sqlite3_column_int(stmt, col++);
+    diode.packageId = sqlite3_column_int(stmt, col++);
+    diode.typeId = sqlite3_column_int(stmt, col++);
+    diode.polarityId = sqlite3_column_int(stmt, col++);
+    diode.forwardVoltage = sqlite3_column_double(stmt, col++);
+    diode.maxCurrent = sqlite3_column_double(stmt, col++);
+    diode.maxReverseVoltage = sqlite3_column_double(stmt, col++);
+    diode.reverseLeakage = sqlite3_column_double(stmt, col++);
+    d.packageName = safeColumnText(stmt, col++);
+    d.typeName = safeColumnText(stmt, col++);
+    d.polarityName = safeColumnText(stmt, col++);
+    return d;
+}
+
+void readDetails(sqlite3_stmt* stmt, ComponentDetails& details)
+{
+    Component& comp = details.component;
+    int col = ColComponent;
+    comp.id = sqlite3_column_int(stmt, col++);
+    comp.categoryId = sqlite3_column_int(stmt, col++);
+    comp.partNumber = safeColumnText(stmt, col++);
+    comp.manufacturerId = sqlite3_column_int(stmt, col++);
+    comp.description = safeColumnText(stmt, col++);
+    comp.notes = safeColumnText(stmt, col++);
+    comp.quantity = sqlite3_column_int(stmt, col++);
+    comp.datasheetLink = safeColumnText(stmt, col++);
+    comp.createdOn = safeColumnText(stmt, col++);
+    comp.modifiedOn = safeColumnText(stmt, col++);
+    details.categoryName = safeColumnText(stmt, col++);
+    details.manufacturerName = safeColumnText(stmt, col++);
+
+    // A component has at most one subtype row in practice; if several
+    // exist, the first in this order wins.
+    if (present(stmt, ColResistor))
+        details.subtype = readResistor(stmt, ColResistor);
+    else if (present(stmt, ColCapacitor))
+        details.subtype = readCapacitor(stmt, ColCapacitor);
+    else if (present(stmt, ColTransistor))
+        details.subtype = readTransistor(stmt, ColTransistor);
+    else if (present(stmt, ColFuse))
+        details.subtype = readFuse(stmt, ColFuse);
+    else if (present(stmt, ColDiode))
+        details.subtype = readDiode(stmt, ColDiode);
+    else
+        details.subtype = std::monostate{};
+}
+
+} // namespace
+
+bool ComponentDetailsManager::getById(int id, ComponentDetails& details, DbResult& result)
+{
+    static const std::string sql = selectDetailsColumns()
+        + "FROM Components c" + kComponentDetailsJoinSql + " WHERE c.ID = ?;";
+
+    CachedStatement stmt;
+
+    if (!db_.prepareCached(sql, stmt, result))
+        return false;
+
+    sqlite3_bind_int(stmt, 1, id);
+
+    bool found = false;
+    if (!db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        readDetails(row, details);
+        found = true;
+        return false;
+    }, result))
+        return false;
+
+    if (!found) {
+        result.setError(SQLITE_NOTFOUND, "Component not found");
+        return false;
+    }
+    return true;
+}
+
+bool ComponentDetailsManager::getByIds(std::span<const int> ids,
+    std::vector<ComponentDetails>& details, DbResult& result)
+{
+    details.clear();
+    if (ids.empty()) {
+        result.clear();
+        return true;
+    }
+
+    // The IDs travel as one JSON array parameter, so the SQL text (and
+    // the cached statement) is the same for any batch size. CROSS JOIN
+    // pins json_each as the outer loop: rows come out in array order and
+    // each ID is a rowid probe into Components. An ORDER BY would instead
+    // push every wide row through a temp b-tree.
+    static const std::string sql = selectDetailsColumns()
+        + "FROM json_each(?) AS ids CROSS JOIN Components c ON c.ID = ids.value"
+        + kComponentDetailsJoinSql + ";";
+
+    CachedStatement stmt;
+
+    if (!db_.prepareCached(sql, stmt, result))
+        return false;
+
+    std::string idArray = "[";
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (i > 0)
+            idArray += ',';
+        idArray += std::to_string(ids[i]);
+    }
+    idArray += ']';
+    sqlite3_bind_text(stmt, 1, idArray.c_str(), static_cast<int>(idArray.size()), SQLITE_STATIC);
+
+    details.reserve(ids.size());
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        readDetails(row, details.emplace_back());
+        return true;
+    }, result);
+}
@@ -0,0 +1,276 @@
+#include "ComponentExporter.h"
+#include "ComponentDetailsManager.h"
+#include "DbUtils.h"
+
+#include <sqlite3.h>
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <string_view>
+
+namespace {
+
+// ---- Columns ----
+
+struct ExportColumn {
+    const char* name;   // CSV header and JSON key
+    const char* expr;   // select expression
+};
+
+// Shared attributes come first and are merged across subtypes, matching
+// the column names CsvImporter reads.
+const ExportColumn kColumns[] = {
+    { "ID",                 "c.ID" },
+    { "PartNumber",         "c.PartNumber" },
+    { "Category",           "cat.Name" },
+    { "Manufacturer",       "m.Name" },
+    { "Description",        "c.Description" },
+    { "Notes",              "c.Notes" },
+    { "Quantity",           "c.Quantity" },
+    { "DatasheetLink",      "c.DatasheetLink" },
+    { "CreatedOn",          "c.CreatedOn" },
+    { "ModifiedOn",         "c.ModifiedOn" },
+    { "Package",            "COALESCE(rp.Name, cp.Name, tp.Name, fp.Name, dp.Name)" },
+    { "Tolerance",          "COALESCE(r.Tolerance, cap.Tolerance)" },
+    { "VoltageRating",      "COALESCE(r.VoltageRating, cap.VoltageRating, f.VoltageRating)" },
+    { "LeadSpacing",        "COALESCE(r.LeadSpacing, cap.LeadSpacing)" },
+
+    { "Resistance",         "r.Resistance" },
+    { "PowerRating",        "r.PowerRating" },
+    { "Composition",        "rc.Name" },
+    { "TempCoeffMin",       "r.TempCoeffMin" },
+    { "TempCoeffMax",       "r.TempCoeffMax" },
+    { "TempMin",            "r.TempMin" },
+    { "TempMax",            "r.TempMax" },
+
+    { "Capacitance",        "cap.Capacitance" },
+    { "ESR",                "cap.ESR" },
+    { "LeakageCurrent",     "cap.LeakageCurrent" },
+    { "Polarized",          "cap.Polarized" },
+    { "Dielectric",         "cd.Name" },
+    { "Diameter",           "cap.Diameter" },
+    { "Height",             "cap.Height" },
+    { "Length",             "cap.Length" },
+    { "Width",              "cap.Width" },
+
+    { "TransistorType",     "tt.Name" },
+    { "TransistorPolarity", "tpol.Name" },
+    { "VceMax",             "b.VceMax" },
+    { "IcMax",              "b.IcMax" },
+    { "PdMax",              "b.PdMax" },
+    { "Hfe",                "b.Hfe" },
+    { "Ft",                 "b.Ft" },
+
+    { "FuseType",           "ft.Name" },
+    { "CurrentRating",      "f.CurrentRating" },
+
+    { "DiodeType",          "dt.Name" },
+    { "DiodePolarity",      "dpol.Name" },
+    { "ForwardVoltage",     "d.ForwardVoltage" },
+    { "MaxCurrent",         "d.MaxCurrent" },
+    { "MaxReverseVoltage",  "d.MaxReverseVoltage" },
+    { "ReverseLeakage",     "d.ReverseLeakage" },
+};
+
+constexpr int kColumnCount = static_cast<int>(sizeof(kColumns) / sizeof(kColumns[0]));
+
+std::string exportSql()
+{
+    std::string sql = "SELECT ";
+    for (int i = 0; i < kColumnCount; ++i) {
+        if (i > 0)
+            sql += ", ";
+        sql += kColumns[i].expr;
+    }
+    sql += " FROM Components c";
+    sql += kComponentDetailsJoinSql;
+    sql += " ORDER BY c.ID;";
+    return sql;
+}
+
+// ---- Output ----
+
+// Collects formatted text and hands it to the stream in large writes
+class OutputBuffer {
+public:
+    OutputBuffer(std::ostream& out, std::size_t capacity)
+        : out_(out), capacity_(capacity > 0 ? capacity : 1) {
+        buf_.reserve(capacity_);
+    }
+
+    void append(std::string_view s) {
+        buf_.append(s.data(), s.size());
+    }
+
+    void append(char c) {
+        buf_.push_back(c);
+    }
+
+    // Pending text, for formatters that append to a std::string
+    std::string& text() { return buf_; }
+
+    // Called between records, so a record is never split across writes
+    bool flushIfFull() {
+        return buf_.size() < capacity_ || flush();
+    }
+
+    bool flush() {
+        out_.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+        bytes_ += static_cast<long long>(buf_.size());
+        buf_.clear();
+        return static_cast<bool>(out_);
+    }
+
+    long long bytesWritten() const { return bytes_; }
+
+private:
+    std::ostream& out_;
+    std::size_t capacity_;
+    std::string buf_;
+    long long bytes_ = 0;
+};
+
+std::string_view columnText(sqlite3_stmt* stmt, int col)
+{
+    const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+    return text ? std::string_view(text, static_cast<std::size_t>(sqlite3_column_bytes(stmt, col)))
+                : std::string_view();
+}
+
+void appendCsvField(OutputBuffer& out, std::string_view value, char delimiter)
+{
+    if (value.find_first_of(std::string{ delimiter, '"', '\r', '\n' }) == std::string_view::npos) {
+        out.append(value);
+        return;
+    }
+
+    out.append('"');
+    for (char ch : value) {
+        if (ch == '"')
+            out.append('"');
+        out.append(ch);
+    }
+    out.append('"');
+}
+
+void writeCsvHeader(OutputBuffer& out, char delimiter)
+{
+    for (int i = 0; i < kColumnCount; ++i) {
+        if (i > 0)
+            out.append(delimiter);
+        out.append(kColumns[i].name);
+    }
+    out.append('\n');
+}
+
+void writeCsvRow(OutputBuffer& out, sqlite3_stmt* row, char delimiter)
+{
+    for (int i = 0; i < kColumnCount; ++i) {
+        if (i > 0)
+            out.append(delimiter);
+        // Numbers use SQLite's own text rendering, which round-trips
+        if (sqlite3_column_type(row, i) != SQLITE_NULL)
+            appendCsvField(out, columnText(row, i), delimiter);
+    }
+    out.append('\n');
+}
+
+void writeJsonRow(OutputBuffer& out, sqlite3_stmt* row)
+{
+    out.append('{');
+    bool first = true;
+    for (int i = 0; i < kColumnCount; ++i) {
+        const int type = sqlite3_column_type(row, i);
+        if (type == SQLITE_NULL)
+            continue;
+        // JSON has no Inf/NaN
+        if (type == SQLITE_FLOAT && !std::isfinite(sqlite3_column_double(row, i)))
+            continue;
+
+        if (!first)
+            out.append(',');
+        first = false;
+
+        out.append('"');
+        out.append(kColumns[i].name);
+        out.append("\":");
+        if (type == SQLITE_INTEGER || type == SQLITE_FLOAT)
+            out.append(columnText(row, i));
+        else
+            appendJsonString(out.text(), columnText(row, i));
+    }
+    out.append("}\n");
+}
+
+} // namespace
+
+ComponentExporter::ComponentExporter(Database& db)
+    : db_(db)
+{
+}
+
+bool ComponentExporter::exportFile(const std::string& path, const ExportOptions& options,
+    ExportReport& report, DbResult& result)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        report = ExportReport{};
+        result.setError(SQLITE_CANTOPEN, "Cannot create " + path);
+        return false;
+    }
+    if (!exportStream(out, options, report, result))
+        return false;
+
+    out.close();
+    if (!out) {
+        result.setError(SQLITE_IOERR, "Failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+bool ComponentExporter::exportStream(std::ostream& out, const ExportOptions& options,
+    ExportReport& report, DbResult& result)
+{
+    report = ExportReport{};
+    result.clear();
+    const auto started = std::chrono::steady_clock::now();
+
+    // Run once per export and far from hot, so not worth a cache slot
+    sqlite3_stmt* stmt = nullptr;
+    if (!db_.prepare(exportSql(), stmt, result))
+        return false;
+
+    OutputBuffer buffer(out, options.bufferBytes);
+    if (options.format == ExportFormat::Csv && options.header)
+        writeCsvHeader(buffer, options.delimiter);
+
+    bool writeFailed = false;
+    bool ok = db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        if (options.format == ExportFormat::Csv)
+            writeCsvRow(buffer, row, options.delimiter);
+        else
+            writeJsonRow(buffer, row);
+        ++report.rowsWritten;
+
+        if (!buffer.flushIfFull()) {
+            writeFailed = true;
+            return false;
+        }
+        return true;
+    }, result);
+    db_.finalize(stmt);
+
+    if (ok && !writeFailed && !buffer.flush())
+        writeFailed = true;
+
+    report.bytesWritten = buffer.bytesWritten();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    if (writeFailed) {
+        result.setError(SQLITE_IOERR, "Write to export stream failed");
+        return false;
+    }
+    return ok;
+}
@@ -1,18 +1,29 @@
 #include "ComponentManager.h"
 #include "DbUtils.h"
+#include "Transaction.h"
+#include "SchemaManager.h"
 #include <sqlite3.h>
+#include <cctype>
 
-bool ComponentManager::add(Component& comp, DbResult& result)
-{
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
-        "INSERT INTO Components (CategoryID, PartNumber, ManufacturerID, "
-        "Description, Notes, Quantity, DatasheetLink, CreatedOn, ModifiedOn) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, datetime('now'), datetime('now'));",
-        stmt, result)) {
-        return false;
-    }
+namespace {
+
+// Scratch list of IDs for removeMany/removeWhere, private to the connection
+const char* const kStageIdsSql =
+    "CREATE TEMP TABLE IF NOT EXISTS PurgeIds (ID INTEGER PRIMARY KEY);"
+    "DELETE FROM temp.PurgeIds;";
 
+// A bulk delete this large, and at least a tenth of what is left,
+// refreshes the planner statistics
+constexpr long long kReanalyzeMinRemoved = 1000;
+
+const char* const kInsertComponentSql =
+    "INSERT INTO Components (CategoryID, PartNumber, ManufacturerID, "
+    "Description, Notes, Quantity, DatasheetLink, CreatedOn, ModifiedOn) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?, datetime('now'), datetime('now')) "
+    "RETURNING ID, CreatedOn, ModifiedOn;";
+
+void bindComponentInsert(sqlite3_stmt* stmt, const Component& comp)
+{
     sqlite3_bind_int(stmt, 1, comp.categoryId);
     sqlite3_bind_text(stmt, 2, comp.partNumber.c_str(), -1, SQLITE_TRANSIENT);
 
@@ -25,18 +36,160 @@ bool ComponentManager::add(Component& comp, DbResult& result)
     sqlite3_bind_text(stmt, 5, comp.notes.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 6, comp.quantity);
     sqlite3_bind_text(stmt, 7, comp.datasheetLink.c_str(), -1, SQLITE_TRANSIENT);
+}
 
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
+const char* const kSelectComponentSql =
+    "SELECT ID, CategoryID, PartNumber, ManufacturerID, Description, Notes, "
+    "Quantity, DatasheetLink, CreatedOn, ModifiedOn FROM Components ";
+
+// Full component SELECT followed by the given WHERE/ORDER BY tail
+std::string selectComponents(const char* tail)
+{
+    return std::string(kSelectComponentSql) + tail;
+}
+
+// Reads a row selected with selectComponents(). assign() reuses the
+// existing string buffers when comp is recycled across rows.
+void readComponent(sqlite3_stmt* stmt, Component& comp)
+{
+    comp.id = sqlite3_column_int(stmt, 0);
+    comp.categoryId = sqlite3_column_int(stmt, 1);
+    comp.partNumber.assign(safeColumnView(stmt, 2));
+    comp.manufacturerId = sqlite3_column_int(stmt, 3);
+    comp.description.assign(safeColumnView(stmt, 4));
+    comp.notes.assign(safeColumnView(stmt, 5));
+    comp.quantity = sqlite3_column_int(stmt, 6);
+    comp.datasheetLink.assign(safeColumnView(stmt, 7));
+    comp.createdOn.assign(safeColumnView(stmt, 8));
+    comp.modifiedOn.assign(safeColumnView(stmt, 9));
+}
+
+void readComponentView(sqlite3_stmt* stmt, ComponentView& view)
+{
+    view.id = sqlite3_column_int(stmt, 0);
+    view.categoryId = sqlite3_column_int(stmt, 1);
+    view.partNumber = safeColumnView(stmt, 2);
+    view.manufacturerId = sqlite3_column_int(stmt, 3);
+    view.description = safeColumnView(stmt, 4);
+    view.notes = safeColumnView(stmt, 5);
+    view.quantity = sqlite3_column_int(stmt, 6);
+    view.datasheetLink = safeColumnView(stmt, 7);
+    view.createdOn = safeColumnView(stmt, 8);
+    view.modifiedOn = safeColumnView(stmt, 9);
+}
+
+// Turns free text into an FTS5 query: each whitespace-separated word
+// becomes a quoted prefix term ("word"*), so user input can never be
+// parsed as FTS5 syntax. Terms are implicitly ANDed.
+std::string toFtsPrefixQuery(const std::string& text)
+{
+    std::string query;
+    std::string term;
+
+    auto flush = [&]() {
+        if (term.empty())
+            return;
+        if (!query.empty())
+            query += ' ';
+        query += '"';
+        for (char ch : term) {
+            if (ch == '"')
+                query += '"';   // "" escapes a quote inside a string
+            query += ch;
+        }
+        query += "\"*";
+        term.clear();
+    };
+
+    for (char ch : text) {
+        if (std::isspace(static_cast<unsigned char>(ch)))
+            flush();
+        else
+            term += ch;
+    }
+    flush();
+    return query;
+}
+
+} // namespace
+
+Component ComponentView::toComponent() const
+{
+    Component comp;
+    comp.id = id;
+    comp.categoryId = categoryId;
+    comp.partNumber = partNumber;
+    comp.manufacturerId = manufacturerId;
+    comp.description = description;
+    comp.notes = notes;
+    comp.quantity = quantity;
+    comp.datasheetLink = datasheetLink;
+    comp.createdOn = createdOn;
+    comp.modifiedOn = modifiedOn;
+    return comp;
+}
+
+bool ComponentManager::add(Component& comp, DbResult& result)
+{
+    CachedStatement stmt;
+    if (!db_.prepareCached(kInsertComponentSql, stmt, result)) {
+        return false;
+    }
+
+    return insert(stmt, comp, result);
+}
+
+bool ComponentManager::addBatch(std::span<Component> comps, DbResult& result)
+{
+    if (comps.empty()) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result);
+    if (!tx.isActive())
+        return false;
+
+    CachedStatement stmt;
+    bool ok = db_.prepareCached(kInsertComponentSql, stmt, result);
+
+    for (std::size_t i = 0; ok && i < comps.size(); ++i) {
+        ok = insert(stmt, comps[i], result);
+        stmt.reset();
+    }
+    stmt.release();
+
+    if (!ok || !tx.commit(result))
+        return false;
+
+    result.clear();
+    return true;
+}
+
+bool ComponentManager::insert(sqlite3_stmt* stmt, Component& comp, DbResult& result)
+{
+    bindComponentInsert(stmt, comp);
+
+    // RETURNING hands back the stored row's generated values, so callers
+    // hold the full row without a second query.
+    if (sqlite3_step(stmt) != SQLITE_ROW) {
         result.setError(
             sqlite3_errcode(db_.handle()),
             sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
+    comp.id = sqlite3_column_int(stmt, 0);
+    comp.createdOn = safeColumnText(stmt, 1);
+    comp.modifiedOn = safeColumnText(stmt, 2);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        result.setError(
+            sqlite3_errcode(db_.handle()),
+            sqlite3_errmsg(db_.handle()));
+        return false;
+    }
 
-    comp.id = db_.lastInsertId();
     if (comp.id <= 0) {
         result.setError(SQLITE_ERROR, "Failed to retrieve component ID");
         return false;
@@ -48,47 +201,33 @@ bool ComponentManager::add(Component& comp, DbResult& result)
 
 bool ComponentManager::getById(int id, Component& comp, DbResult& result)
 {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
-        "SELECT ID, CategoryID, PartNumber, ManufacturerID, Description, Notes, "
-        "Quantity, DatasheetLink, CreatedOn, ModifiedOn "
-        "FROM Components WHERE ID = ?;",
-        stmt, result)) {
+    CachedStatement stmt;
+    if (!db_.prepareCached(selectComponents("WHERE ID = ?;"), stmt, result)) {
         return false;
     }
 
     sqlite3_bind_int(stmt, 1, id);
 
     if (sqlite3_step(stmt) == SQLITE_ROW) {
-        comp.id = sqlite3_column_int(stmt, 0);
-        comp.categoryId = sqlite3_column_int(stmt, 1);
-        comp.partNumber = safeColumnText(stmt, 2);
-        comp.manufacturerId = sqlite3_column_int(stmt, 3);
-        comp.description = safeColumnText(stmt, 4);
-        comp.notes = safeColumnText(stmt, 5);
-        comp.quantity = sqlite3_column_int(stmt, 6);
-        comp.datasheetLink = safeColumnText(stmt, 7);
-        comp.createdOn = safeColumnText(stmt, 8);
-        comp.modifiedOn = safeColumnText(stmt, 9);
+        readComponent(stmt, comp);
     }
     else {
         result.setError(sqlite3_errcode(db_.handle()), "Component not found");
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
-bool ComponentManager::update(const Component& comp, DbResult& result)
+bool ComponentManager::update(Component& comp, DbResult& result)
 {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "UPDATE Components SET CategoryID=?, PartNumber=?, ManufacturerID=?, "
         "Description=?, Notes=?, Quantity=?, DatasheetLink=?, "
-        "ModifiedOn=datetime('now') WHERE ID=?;",
+        "ModifiedOn=datetime('now') WHERE ID=? "
+        "RETURNING CreatedOn, ModifiedOn;",
         stmt, result)) {
         return false;
     }
@@ -102,23 +241,36 @@ bool ComponentManager::update(const Component& comp, DbResult& result)
     sqlite3_bind_text(stmt, 7, comp.datasheetLink.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 8, comp.id);
 
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_DONE) {
+        result.setError(SQLITE_NOTFOUND, "Component not found");
+        return false;
+    }
+    if (rc != SQLITE_ROW) {
+        result.setError(
+            sqlite3_errcode(db_.handle()),
+            sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+
+    comp.createdOn = safeColumnText(stmt, 0);
+    comp.modifiedOn = safeColumnText(stmt, 1);
+
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(
             sqlite3_errcode(db_.handle()),
             sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 bool ComponentManager::remove(int id, DbResult& result)
 {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("DELETE FROM Components WHERE ID=?;", stmt, result)) {
+    CachedStatement stmt;
+    if (!db_.prepareCached("DELETE FROM Components WHERE ID=?;", stmt, result)) {
         return false;
     }
 
@@ -128,43 +280,271 @@ bool ComponentManager::remove(int id, DbResult& result)
         result.setError(
             sqlite3_errcode(db_.handle()),
             sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
+// ---- Bulk removal ----
+
+bool ComponentManager::removeMany(std::span<const int> ids, long long& removed,
+    DbResult& result)
+{
+    removed = 0;
+    if (ids.empty()) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result);
+    if (!tx.isActive() || !db_.exec(kStageIdsSql, result))
+        return false;
+
+    CachedStatement stmt;
+    if (!db_.prepareCached("INSERT OR IGNORE INTO temp.PurgeIds (ID) VALUES (?);", stmt, result))
+        return false;
+    for (const int id : ids) {
+        sqlite3_bind_int(stmt, 1, id);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+            return false;
+        }
+        stmt.reset();
+    }
+    stmt.release();
+
+    if (!removeStaged(removed, result) || !tx.commit(result)) {
+        removed = 0;
+        return false;
+    }
+    result.clear();
+    return true;
+}
+
+bool ComponentManager::removeWhere(const ComponentFilter& filter, long long& removed,
+    DbResult& result)
+{
+    removed = 0;
+    if (filter.empty()) {
+        result.setError(SQLITE_MISUSE, "removeWhere needs at least one filter condition");
+        return false;
+    }
+
+    std::string sql = "INSERT INTO temp.PurgeIds (ID) SELECT ID FROM Components WHERE 1";
+    if (filter.categoryId)
+        sql += " AND CategoryID = ?";
+    if (filter.manufacturerId)
+        sql += " AND ManufacturerID = ?";
+    if (filter.maxQuantity)
+        sql += " AND Quantity <= ?";
+    if (!filter.modifiedBefore.empty())
+        sql += " AND ModifiedOn < ?";
+    sql += ";";
+
+    Transaction tx(db_, result);
+    if (!tx.isActive() || !db_.exec(kStageIdsSql, result))
+        return false;
+
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, result))
+        return false;
+
+    int param = 1;
+    if (filter.categoryId)
+        sqlite3_bind_int(stmt, param++, *filter.categoryId);
+    if (filter.manufacturerId)
+        sqlite3_bind_int(stmt, param++, *filter.manufacturerId);
+    if (filter.maxQuantity)
+        sqlite3_bind_int(stmt, param++, *filter.maxQuantity);
+    if (!filter.modifiedBefore.empty())
+        sqlite3_bind_text(stmt, param++, filter.modifiedBefore.c_str(), -1, SQLITE_TRANSIENT);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+    stmt.release();
+
+    if (!removeStaged(removed, result) || !tx.commit(result)) {
+        removed = 0;
+        return false;
+    }
+    result.clear();
+    return true;
+}
+
+// Deletes the components listed in temp.PurgeIds and empties it
+bool ComponentManager::removeStaged(long long& removed, DbResult& result)
+{
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+            "DELETE FROM Components WHERE ID IN (SELECT ID FROM temp.PurgeIds);", stmt, result))
+        return false;
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+    removed = sqlite3_changes64(db_.handle());
+    stmt.release();
+
+    if (!db_.exec("DELETE FROM temp.PurgeIds;", result))
+        return false;
+
+    if (removed >= kReanalyzeMinRemoved
+        && removed * 10 >= db_.countRows("Components", "")) {
+        return SchemaManager(db_).analyzePlannerStats(result);
+    }
+    return true;
+}
+
 bool ComponentManager::list(std::vector<Component>& comps, DbResult& result)
 {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
-        "SELECT ID, CategoryID, PartNumber, ManufacturerID, Description, Notes, "
-        "Quantity, DatasheetLink, CreatedOn, ModifiedOn FROM Components;",
+    comps.clear();
+
+    return forEach([&](const Component& comp) {
+        comps.push_back(comp);
+        return true;
+    }, result);
+}
+
+bool ComponentManager::forEach(const std::function<bool(const Component&)>& fn,
+    DbResult& result)
+{
+    CachedStatement stmt;
+    if (!db_.prepareCached(selectComponents("ORDER BY ID;"), stmt, result)) {
+        return false;
+    }
+
+    Component comp;
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        readComponent(row, comp);
+        return fn(comp);
+    }, result);
+}
+
+bool ComponentManager::forEachView(const std::function<bool(const ComponentView&)>& fn,
+    DbResult& result)
+{
+    CachedStatement stmt;
+    if (!db_.prepareCached(selectComponents("ORDER BY ID;"), stmt, result)) {
+        return false;
+    }
+
+    ComponentView view;
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        readComponentView(row, view);
+        return fn(view);
+    }, result);
+}
+
+bool ComponentManager::findByPartNumber(const std::string& partNumber,
+    std::vector<Component>& comps, DbResult& result)
+{
+    // PartNumber is COLLATE NOCASE, so this is a case-insensitive match
+    // served by idx_Components_PartNumber.
+    CachedStatement stmt;
+    if (!db_.prepareCached(selectComponents("WHERE PartNumber = ? ORDER BY ID;"),
         stmt, result)) {
         return false;
     }
 
+    sqlite3_bind_text(stmt, 1, partNumber.c_str(), -1, SQLITE_TRANSIENT);
+
     comps.clear();
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Component comp;
-        comp.id = sqlite3_column_int(stmt, 0);
-        comp.categoryId = sqlite3_column_int(stmt, 1);
-        comp.partNumber = safeColumnText(stmt, 2);
-        comp.manufacturerId = sqlite3_column_int(stmt, 3);
-        comp.description = safeColumnText(stmt, 4);
-        comp.notes = safeColumnText(stmt, 5);
-        comp.quantity = sqlite3_column_int(stmt, 6);
-        comp.datasheetLink = safeColumnText(stmt, 7);
-        comp.createdOn = safeColumnText(stmt, 8);
-        comp.modifiedOn = safeColumnText(stmt, 9);
-        comps.push_back(comp);
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        readComponent(row, comps.emplace_back());
+        return true;
+    }, result);
+}
+
+bool ComponentManager::listPage(ComponentPageCursor& cursor, int pageSize,
+    std::vector<Component>& page, DbResult& result)
+{
+    page.clear();
+
+    if (pageSize <= 0) {
+        result.setError(SQLITE_MISUSE, "Page size must be positive");
+        return false;
+    }
+    if (cursor.atEnd) {
+        result.clear();
+        return true;
     }
 
-    db_.finalize(stmt);
+    CachedStatement stmt;
+    bool ok = false;
+    if (cursor.order == ComponentOrder::ByPartNumber) {
+        // Row-value comparison uses PartNumber's NOCASE collation, which
+        // matches idx_Components_PartNumber (rowid is its implicit suffix).
+        ok = db_.prepareCached(selectComponents(
+            "WHERE (PartNumber, ID) > (?, ?) ORDER BY PartNumber, ID LIMIT ?;"),
+            stmt, result);
+        if (ok) {
+            sqlite3_bind_text(stmt, 1, cursor.lastPartNumber.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int(stmt, 2, cursor.lastId);
+            sqlite3_bind_int(stmt, 3, pageSize);
+        }
+    }
+    else {
+        ok = db_.prepareCached(selectComponents("WHERE ID > ? ORDER BY ID LIMIT ?;"),
+            stmt, result);
+        if (ok) {
+            sqlite3_bind_int(stmt, 1, cursor.lastId);
+            sqlite3_bind_int(stmt, 2, pageSize);
+        }
+    }
+    if (!ok)
+        return false;
+
+    page.reserve(pageSize);
+    if (!db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+            readComponent(row, page.emplace_back());
+            return true;
+        }, result)) {
+        return false;
+    }
+
+    if (!page.empty()) {
+        cursor.lastId = page.back().id;
+        cursor.lastPartNumber = page.back().partNumber;
+    }
+    cursor.atEnd = static_cast<int>(page.size()) < pageSize;
+
     result.clear();
     return true;
 }
+
+bool ComponentManager::search(const std::string& query, int limit,
+    std::vector<Component>& comps, DbResult& result)
+{
+    comps.clear();
+
+    const std::string ftsQuery = toFtsPrefixQuery(query);
+    if (ftsQuery.empty() || limit <= 0) {
+        result.clear();
+        return true;
+    }
+
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "SELECT c.ID, c.CategoryID, c.PartNumber, c.ManufacturerID, c.Description, c.Notes, "
+        "c.Quantity, c.DatasheetLink, c.CreatedOn, c.ModifiedOn "
+        "FROM ComponentsFts f JOIN Components c ON c.ID = f.rowid "
+        "WHERE ComponentsFts MATCH ? "
+        "ORDER BY bm25(ComponentsFts, 10.0, 2.0, 1.0) LIMIT ?;",
+        stmt, result)) {
+        return false;
+    }
+
+    sqlite3_bind_text(stmt, 1, ftsQuery.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 2, limit);
+
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        readComponent(row, comps.emplace_back());
+        return true;
+    }, result);
+}
@@ -0,0 +1,731 @@
+#include "CsvImporter.h"
+#include "BoundedQueue.h"
+#include "DbUtils.h"
+#include "SchemaManager.h"
+#include "Transaction.h"
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// ---- Columns ----
+
+enum Column {
+    ColPartNumber, ColCategory, ColManufacturer, ColDescription, ColNotes,
+    ColQuantity, ColDatasheetLink,
+    ColResistance, ColTolerance, ColPowerRating, ColComposition,
+    ColCapacitance, ColVoltageRating, ColDielectric,
+    ColPackage,
+    ColumnCount
+};
+
+// Folded header names, in Column order
+const char* const kColumnNames[ColumnCount] = {
+    "partnumber", "category", "manufacturer", "description", "notes",
+    "quantity", "datasheetlink",
+    "resistance", "tolerance", "powerrating", "composition",
+    "capacitance", "voltagerating", "dielectric",
+    "package"
+};
+
+// Field index of each column, -1 if the file lacks it
+using Header = std::array<int, ColumnCount>;
+
+// ---- Pipeline items ----
+
+struct RawRecord {
+    int line;
+    std::string text;
+};
+
+struct RawChunk {
+    std::size_t seq;
+    std::vector<RawRecord> records;
+};
+
+enum class Subtype { None, Resistor, Capacitor };
+
+struct ParsedRow {
+    int line = 0;
+    DbResult error;              // set if the row failed to parse
+
+    Component component;
+    Subtype subtype = Subtype::None;
+    Resistor resistor;
+    Capacitor capacitor;
+
+    // Lookup names the snapshot did not know. Only kept with
+    // addMissingLookups; the writer creates them and fills in the IDs.
+    std::string categoryName;
+    std::string manufacturerName;
+    std::string packageName;
+    std::string compositionName;
+    std::string dielectricName;
+};
+
+struct ParsedChunk {
+    std::size_t seq;
+    std::vector<ParsedRow> rows;
+};
+
+// Chunks the writer may hold out of order. A parse thread whose chunk is
+// too far ahead of the next one to write waits here, so one slow chunk
+// cannot pile up the others' output. The next chunk always fits.
+class ReorderWindow {
+public:
+    explicit ReorderWindow(std::size_t size) : size_(size > 0 ? size : 1) {}
+
+    // Parse thread: wait until seq is within the window. False once closed.
+    bool admit(std::size_t seq) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        moved_.wait(lock, [&] { return closed_ || seq < next_ + size_; });
+        return !closed_;
+    }
+
+    // Writer: every chunk before next has been written
+    void advance(std::size_t next) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            next_ = next;
+        }
+        moved_.notify_all();
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        moved_.notify_all();
+    }
+
+private:
+    const std::size_t size_;
+    std::size_t next_ = 0;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable moved_;
+};
+
+// Folded name -> ID for every lookup table the importer resolves. Built
+// once before the parse threads start and only read afterwards, so the
+// threads share it without locking.
+struct LookupSnapshot {
+    using Names = std::unordered_map<std::string, int>;
+
+    Names categories;
+    Names manufacturers;
+    Names resistorPackages;
+    Names resistorCompositions;
+    Names capacitorPackages;
+    Names capacitorDielectrics;
+};
+
+bool loadNames(LookupManager& mgr, LookupSnapshot::Names& names, DbResult& result)
+{
+    std::vector<LookupItem> items;
+    if (!mgr.listLookup(items, result))
+        return false;
+
+    names.reserve(items.size());
+    for (const LookupItem& item : items)
+        names.emplace(foldNoCase(item.name), item.id);
+    return true;
+}
+
+// ---- Text helpers ----
+
+std::string_view trimView(std::string_view s)
+{
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+        s.remove_prefix(1);
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+        s.remove_suffix(1);
+    return s;
+}
+
+// Reads one CSV record, joining physical lines while a quoted field is
+// open. line is the running physical line count; startLine receives the
+// line the record begins on.
+bool readRecord(std::istream& in, std::string& record, int& line, int& startLine)
+{
+    std::string physical;
+    if (!std::getline(in, physical))
+        return false;
+
+    startLine = ++line;
+    record.clear();
+
+    for (;;) {
+        if (!physical.empty() && physical.back() == '\r')
+            physical.pop_back();
+        record += physical;
+
+        // An escaped quote ("") counts twice, so odd means still open
+        if (std::count(record.begin(), record.end(), '"') % 2 == 0)
+            return true;
+        if (!std::getline(in, physical))
+            return true;     // unterminated; splitFields reports it
+
+        ++line;
+        record += '\n';
+    }
+}
+
+// RFC 4180 field split. False if a quoted field is never closed.
+bool splitFields(std::string_view record, char delimiter, std::vector<std::string>& fields)
+{
+    fields.clear();
+    std::string field;
+    bool inQuotes = false;
+
+    for (std::size_t i = 0; i < record.size(); ++i) {
+        const char c = record[i];
+        if (inQuotes) {
+            if (c == '"') {
+                if (i + 1 < record.size() && record[i + 1] == '"') {
+                    field += '"';
+                    ++i;
+                }
+                else {
+                    inQuotes = false;
+                }
+            }
+            else {
+                field += c;
+            }
+        }
+        else if (c == '"') {
+            inQuotes = true;
+        }
+        else if (c == delimiter) {
+            fields.push_back(std::move(field));
+            field.clear();
+        }
+        else {
+            field += c;
+        }
+    }
+
+    fields.push_back(std::move(field));
+    return !inQuotes;
+}
+
+bool isUnit(std::string_view s)
+{
+    static const char* const kUnits[] = {
+        "", "ohm", "ohms", "\xCE\xA9" /* Ω */, "r", "f", "v", "w", "a", "%"
+    };
+    const std::string folded = foldNoCase(s);
+    for (const char* unit : kUnits) {
+        if (folded == unit)
+            return true;
+    }
+    return false;
+}
+
+// "4.7k", "100nF", "0.25 W", "1e-6": a number with an optional SI
+// prefix and unit symbol
+bool parseRating(std::string_view text, double& value)
+{
+    text = trimView(text);
+    const char* first = text.data();
+    const char* last = first + text.size();
+
+    auto [end, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc() || end == first)
+        return false;
+
+    std::string_view rest = trimView(std::string_view(end, last - end));
+    if (isUnit(rest))
+        return true;
+
+    static const struct { std::string_view prefix; double scale; } kPrefixes[] = {
+        { "p", 1e-12 }, { "n", 1e-9 }, { "u", 1e-6 }, { "\xC2\xB5", 1e-6 } /* µ */,
+        { "m", 1e-3 }, { "k", 1e3 }, { "K", 1e3 }, { "M", 1e6 }, { "G", 1e9 }
+    };
+    for (const auto& p : kPrefixes) {
+        if (rest.substr(0, p.prefix.size()) == p.prefix && isUnit(rest.substr(p.prefix.size()))) {
+            value *= p.scale;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseQuantity(std::string_view text, int& value)
+{
+    text = trimView(text);
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && end == text.data() + text.size() && value >= 0;
+}
+
+// ---- Row parsing (parse threads) ----
+
+class RowParser {
+public:
+    RowParser(const Header& header, const LookupSnapshot& names, const CsvImportOptions& options)
+        : header_(header), names_(names), options_(options) {
+    }
+
+    void parse(const RawRecord& rec, ParsedRow& row)
+    {
+        row.line = rec.line;
+
+        if (!splitFields(rec.text, options_.delimiter, fields_)) {
+            row.error.setError(ImportError::MalformedRecord, "Unterminated quoted field");
+            return;
+        }
+
+        Component& c = row.component;
+
+        c.partNumber = std::string(trimView(field(ColPartNumber)));
+        if (c.partNumber.empty()) {
+            row.error.setError(ImportError::MissingField, "PartNumber is empty");
+            return;
+        }
+
+        const std::string category = normalizeWhitespace(std::string(field(ColCategory)));
+        if (category.empty()) {
+            row.error.setError(ImportError::MissingField, "Category is empty");
+            return;
+        }
+        if (!resolve(names_.categories, "category", category, c.categoryId, row.categoryName, row))
+            return;
+
+        const std::string manufacturer = normalizeWhitespace(std::string(field(ColManufacturer)));
+        if (!manufacturer.empty()
+            && !resolve(names_.manufacturers, "manufacturer", manufacturer,
+                c.manufacturerId, row.manufacturerName, row))
+            return;
+
+        c.description = std::string(field(ColDescription));
+        c.notes = std::string(field(ColNotes));
+        c.datasheetLink = std::string(trimView(field(ColDatasheetLink)));
+
+        std::string_view qty = trimView(field(ColQuantity));
+        if (!qty.empty() && !parseQuantity(qty, c.quantity)) {
+            row.error.setError(ImportError::InvalidNumber,
+                "Quantity '" + std::string(qty) + "' is not a whole number");
+            return;
+        }
+
+        const std::string kind = foldNoCase(category);
+        if (kind == "resistor" && !trimView(field(ColResistance)).empty())
+            parseResistor(row);
+        else if (kind == "capacitor" && !trimView(field(ColCapacitance)).empty())
+            parseCapacitor(row);
+    }
+
+private:
+    std::string_view field(Column col) const
+    {
+        const int index = header_[col];
+        if (index < 0 || index >= static_cast<int>(fields_.size()))
+            return {};
+        return fields_[index];
+    }
+
+    // Empty fields leave value untouched
+    bool rating(Column col, double& value, ParsedRow& row)
+    {
+        std::string_view text = trimView(field(col));
+        if (text.empty() || parseRating(text, value))
+            return true;
+
+        row.error.setError(ImportError::InvalidNumber,
+            std::string(kColumnNames[col]) + " '" + std::string(text) + "' is not a number");
+        return false;
+    }
+
+    bool resolve(const LookupSnapshot::Names& names, const char* what, const std::string& name,
+        int& id, std::string& deferredName, ParsedRow& row)
+    {
+        auto it = names.find(foldNoCase(name));
+        if (it != names.end()) {
+            id = it->second;
+            return true;
+        }
+        if (options_.addMissingLookups) {
+            deferredName = name;
+            return true;
+        }
+        row.error.setError(ImportError::UnknownLookup,
+            std::string("Unknown ") + what + " '" + name + "'");
+        return false;
+    }
+
+    bool optionalLookup(Column col, const LookupSnapshot::Names& names, const char* what,
+        int& id, std::string& deferredName, ParsedRow& row)
+    {
+        const std::string name = normalizeWhitespace(std::string(field(col)));
+        return name.empty() || resolve(names, what, name, id, deferredName, row);
+    }
+
+    void parseResistor(ParsedRow& row)
+    {
+        Resistor& r = row.resistor;
+        if (!rating(ColResistance, r.resistance, row)
+            || !rating(ColTolerance, r.tolerance, row)
+            || !rating(ColPowerRating, r.powerRating, row)
+            || !rating(ColVoltageRating, r.voltageRating, row)
+            || !optionalLookup(ColPackage, names_.resistorPackages, "resistor package",
+                r.packageTypeId, row.packageName, row)
+            || !optionalLookup(ColComposition, names_.resistorCompositions, "resistor composition",
+                r.compositionId, row.compositionName, row))
+            return;
+
+        row.subtype = Subtype::Resistor;
+    }
+
+    void parseCapacitor(ParsedRow& row)
+    {
+        Capacitor& cap = row.capacitor;
+        if (!rating(ColCapacitance, cap.capacitance, row)
+            || !rating(ColVoltageRating, cap.voltageRating, row)
+            || !rating(ColTolerance, cap.tolerance, row)
+            || !optionalLookup(ColPackage, names_.capacitorPackages, "capacitor package",
+                cap.packageTypeId, row.packageName, row)
+            || !optionalLookup(ColDielectric, names_.capacitorDielectrics, "capacitor dielectric",
+                cap.dielectricTypeId, row.dielectricName, row))
+            return;
+
+        row.subtype = Subtype::Capacitor;
+    }
+
+    const Header& header_;
+    const LookupSnapshot& names_;
+    const CsvImportOptions& options_;
+    std::vector<std::string> fields_;   // reused across rows
+};
+
+bool parseHeader(const std::string& record, char delimiter, Header& header, DbResult& result)
+{
+    std::vector<std::string> fields;
+    splitFields(record, delimiter, fields);
+
+    // Excel writes a UTF-8 byte order mark ahead of the first name
+    if (!fields.empty() && fields[0].rfind("\xEF\xBB\xBF", 0) == 0)
+        fields[0].erase(0, 3);
+
+    header.fill(-1);
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        std::string name = foldNoCase(trimView(fields[i]));
+        name.erase(std::remove(name.begin(), name.end(), ' '), name.end());
+        for (int col = 0; col < ColumnCount; ++col) {
+            if (name == kColumnNames[col] && header[col] < 0)
+                header[col] = static_cast<int>(i);
+        }
+    }
+
+    for (Column required : { ColPartNumber, ColCategory }) {
+        if (header[required] < 0) {
+            result.setError(ImportError::MissingColumn,
+                std::string("CSV header has no '") + kColumnNames[required] + "' column");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Existing ID for name, adding the row first if it is missing
+bool resolveOrAdd(LookupManager& mgr, const std::string& name, int& id, DbResult& result)
+{
+    if (name.empty())
+        return true;
+
+    id = mgr.getIdByName(name, result);
+    if (id > 0)
+        return true;
+    if (!result.ok())
+        return false;
+
+    if (!mgr.addByName(name, result))
+        return false;
+    id = mgr.getIdByName(name, result);
+    return id > 0;
+}
+
+} // namespace
+
+// ---- CsvImporter ----
+
+CsvImporter::CsvImporter(Database& db)
+    : db_(db)
+    , components_(db)
+    , categories_(db)
+    , manufacturers_(db)
+    , resistors_(db)
+    , resistorPackages_(db)
+    , resistorCompositions_(db)
+    , capacitors_(db)
+    , capacitorPackages_(db)
+    , capacitorDielectrics_(db)
+{
+}
+
+bool CsvImporter::importFile(const std::string& path, const CsvImportOptions& options,
+    ImportReport& report, DbResult& result)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        report = ImportReport{};
+        result.setError(SQLITE_CANTOPEN, "Cannot open " + path);
+        return false;
+    }
+    return importStream(in, options, report, result);
+}
+
+bool CsvImporter::importStream(std::istream& in, const CsvImportOptions& options,
+    ImportReport& report, DbResult& result)
+{
+    report = ImportReport{};
+    result.clear();
+    const auto started = std::chrono::steady_clock::now();
+
+    // Header
+    std::string record;
+    int line = 0;
+    int startLine = 0;
+    if (!readRecord(in, record, line, startLine)) {
+        result.setError(ImportError::MissingColumn, "CSV input is empty");
+        return false;
+    }
+
+    Header header;
+    if (!parseHeader(record, options.delimiter, header, result))
+        return false;
+
+    // Lookup snapshot for the parse threads. They never touch the
+    // connection; everything that does runs on the writer thread.
+    LookupSnapshot names;
+    if (!loadNames(categories_, names.categories, result)
+        || !loadNames(manufacturers_, names.manufacturers, result)
+        || !loadNames(resistorPackages_, names.resistorPackages, result)
+        || !loadNames(resistorCompositions_, names.resistorCompositions, result)
+        || !loadNames(capacitorPackages_, names.capacitorPackages, result)
+        || !loadNames(capacitorDielectrics_, names.capacitorDielectrics, result))
+        return false;
+
+    int threadCount = options.parseThreads;
+    if (threadCount <= 0)
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 2);
+    const std::size_t chunkRows = static_cast<std::size_t>(std::max(1, options.chunkRows));
+    const long long batchRows = std::max(1, options.batchRows);
+
+    BoundedQueue<RawChunk> rawQueue(static_cast<std::size_t>(std::max(1, options.queueChunks)));
+    BoundedQueue<ParsedChunk> parsedQueue(static_cast<std::size_t>(std::max(1, options.queueChunks)));
+    ReorderWindow window(static_cast<std::size_t>(std::max(1, options.queueChunks)));
+
+    // ---- Writer: sole user of the connection while the import runs ----
+    DbResult writerResult;
+    std::thread writer([&] {
+        auto recordError = [&](int errorLine, const DbResult& error) {
+            ++report.rowsFailed;
+            if (report.errors.size() < options.maxRecordedErrors)
+                report.errors.push_back({ errorLine, error });
+        };
+
+        auto writeRow = [&](ParsedRow& row, DbResult& rowResult) {
+            Component& c = row.component;
+            if (!resolveOrAdd(categories_, row.categoryName, c.categoryId, rowResult)
+                || !resolveOrAdd(manufacturers_, row.manufacturerName, c.manufacturerId, rowResult))
+                return false;
+
+            if (row.subtype == Subtype::None)
+                return components_.add(c, rowResult);
+
+            // Component and subtype row land together or not at all,
+            // without abandoning the rest of the batch.
+            Transaction rowTx(db_, rowResult);
+            if (!rowTx.isActive() || !components_.add(c, rowResult))
+                return false;
+
+            bool ok;
+            if (row.subtype == Subtype::Resistor) {
+                Resistor& r = row.resistor;
+                r.componentId = c.id;
+                ok = resolveOrAdd(resistorPackages_, row.packageName, r.packageTypeId, rowResult)
+                    && resolveOrAdd(resistorCompositions_, row.compositionName, r.compositionId, rowResult)
+                    && resistors_.add(r, rowResult);
+            }
+            else {
+                Capacitor& cap = row.capacitor;
+                cap.componentId = c.id;
+                ok = resolveOrAdd(capacitorPackages_, row.packageName, cap.packageTypeId, rowResult)
+                    && resolveOrAdd(capacitorDielectrics_, row.dielectricName, cap.dielectricTypeId, rowResult)
+                    && capacitors_.add(cap, rowResult);
+            }
+            return ok && rowTx.commit(rowResult);
+        };
+
+        std::optional<Transaction> batch;
+        long long inBatch = 0;
+        bool failed = false;
+
+        SchemaManager schema(db_);
+        if (options.deferSearchIndex && !schema.suspendSearchIndex(writerResult))
+            failed = true;
+
+        auto commitBatch = [&] {
+            // Heartbeat rides in the batch, so it moves only when rows land
+            if (batch && options.deferSearchIndex && !schema.touchSearchIndexSuspension(writerResult)) {
+                failed = true;
+                return;
+            }
+            if (batch && !batch->commit(writerResult)) {
+                failed = true;
+                return;
+            }
+            if (batch)
+                ++report.transactions;
+            batch.reset();
+            inBatch = 0;
+        };
+
+        // Parse threads finish chunks out of order; hold early arrivals
+        // so rows are written in file order. The window keeps them to
+        // queueChunks at a time.
+        std::map<std::size_t, ParsedChunk> pending;
+        std::size_t nextSeq = 0;
+
+        while (!failed) {
+            std::optional<ParsedChunk> chunk = parsedQueue.pop();
+            if (!chunk)
+                break;
+            pending.emplace(chunk->seq, std::move(*chunk));
+
+            while (!failed && !pending.empty() && pending.begin()->first == nextSeq) {
+                for (ParsedRow& row : pending.begin()->second.rows) {
+                    ++report.rowsRead;
+                    if (row.error.hasError()) {
+                        recordError(row.line, row.error);
+                        continue;
+                    }
+
+                    if (!batch) {
+                        batch.emplace(db_, writerResult, Transaction::Mode::Immediate);
+                        if (!batch->isActive()) {
+                            failed = true;
+                            break;
+                        }
+                    }
+
+                    DbResult rowResult;
+                    if (writeRow(row, rowResult))
+                        ++report.rowsImported;
+                    else
+                        recordError(row.line, rowResult);
+
+                    if (++inBatch >= batchRows) {
+                        commitBatch();
+                        if (failed)
+                            break;
+                    }
+                }
+                pending.erase(pending.begin());
+                window.advance(++nextSeq);
+            }
+        }
+
+        if (!failed)
+            commitBatch();
+
+        if (failed) {
+            // Rolls back the open batch; unblock the other stages
+            batch.reset();
+            window.close();
+            parsedQueue.close();
+            rawQueue.close();
+        }
+
+        // Batches committed before a failure stay, so they get indexed too
+        if (options.deferSearchIndex) {
+            DbResult resumeResult;
+            if (!schema.resumeSearchIndex(resumeResult) && !failed)
+                writerResult = resumeResult;
+        }
+
+        // New rows shift the value spread the planner's estimates rely on
+        if (report.rowsImported > 0) {
+            DbResult statsResult;
+            if (!schema.analyzePlannerStats(statsResult) && !failed)
+                writerResult = statsResult;
+        }
+    });
+
+    // ---- Parse threads ----
+    std::vector<std::thread> parsers;
+    parsers.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i) {
+        parsers.emplace_back([&] {
+            RowParser parser(header, names, options);
+            while (std::optional<RawChunk> raw = rawQueue.pop()) {
+                ParsedChunk parsed{ raw->seq, {} };
+                parsed.rows.resize(raw->records.size());
+                for (std::size_t r = 0; r < raw->records.size(); ++r)
+                    parser.parse(raw->records[r], parsed.rows[r]);
+                if (!window.admit(parsed.seq) || !parsedQueue.push(std::move(parsed)))
+                    break;
+            }
+        });
+    }
+
+    // ---- Reader (this thread): split the input into record chunks ----
+    RawChunk chunk{ 0, {} };
+    chunk.records.reserve(chunkRows);
+    bool readerStopped = false;
+    while (readRecord(in, record, line, startLine)) {
+        if (trimView(record).empty())
+            continue;    // blank lines, e.g. a trailing newline
+
+        chunk.records.push_back({ startLine, record });
+        if (chunk.records.size() == chunkRows) {
+            const std::size_t seq = chunk.seq;
+            if (!rawQueue.push(std::move(chunk))) {
+                readerStopped = true;
+                break;
+            }
+            chunk = RawChunk{ seq + 1, {} };
+            chunk.records.reserve(chunkRows);
+        }
+    }
+    if (!readerStopped && !chunk.records.empty())
+        rawQueue.push(std::move(chunk));
+
+    rawQueue.close();
+    for (std::thread& t : parsers)
+        t.join();
+    parsedQueue.close();
+    writer.join();
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::sort(report.errors.begin(), report.errors.end(),
+        [](const ImportRowError& a, const ImportRowError& b) { return a.line < b.line; });
+
+    if (writerResult.hasError()) {
+        result = writerResult;
+        return false;
+    }
+
+    if (report.rowsFailed > 0) {
+        result.setWarning(report.errors.empty() ? 0 : report.errors.front().result.code,
+            std::to_string(report.rowsFailed) + " of " + std::to_string(report.rowsRead)
+            + " rows were not imported");
+    }
+    return true;
+}
@@ -1,21 +1,160 @@
 #include "Database.h"
+#include "QueryProfiler.h"
 
-Database::Database(const std::string& filename, DbResult& result) : db_(nullptr) {
-    int rc = sqlite3_open(filename.c_str(), &db_);
+namespace {
+
+const char* journalModeName(DatabaseOptions::JournalMode mode) {
+    switch (mode) {
+    case DatabaseOptions::JournalMode::Delete: return "DELETE";
+    case DatabaseOptions::JournalMode::Wal:    return "WAL";
+    case DatabaseOptions::JournalMode::Memory: return "MEMORY";
+    case DatabaseOptions::JournalMode::Off:    return "OFF";
+    default:                                   return nullptr;
+    }
+}
+
+const char* synchronousName(DatabaseOptions::Synchronous mode) {
+    switch (mode) {
+    case DatabaseOptions::Synchronous::Off:    return "OFF";
+    case DatabaseOptions::Synchronous::Normal: return "NORMAL";
+    case DatabaseOptions::Synchronous::Full:   return "FULL";
+    default:                                   return nullptr;
+    }
+}
+
+const char* tempStoreName(DatabaseOptions::TempStore mode) {
+    switch (mode) {
+    case DatabaseOptions::TempStore::File:   return "FILE";
+    case DatabaseOptions::TempStore::Memory: return "MEMORY";
+    default:                                 return nullptr;
+    }
+}
+
+} // namespace
+
+Database::Database(const std::string& filename, DbResult& result)
+    : Database(filename, DatabaseOptions{}, result) {
+}
+
+Database::Database(const std::string& filename, const DatabaseOptions& options, DbResult& result)
+    : db_(nullptr), options_(options) {
+    const int flags = options.readOnly
+        ? SQLITE_OPEN_READONLY
+        : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    int rc = sqlite3_open_v2(filename.c_str(), &db_, flags, nullptr);
     if (rc) {
         result.setError(rc, sqlite3_errmsg(db_));
         sqlite3_close(db_);
         db_ = nullptr;
+        return;
     }
-    else {
-        result.clear();
+
+    if (!configure(options, result)) {
+        sqlite3_close(db_);
+        db_ = nullptr;
+        return;
     }
+    result.clear();
+}
+
+bool Database::configure(const DatabaseOptions& options, DbResult& result) {
+    // busy_timeout first so the pragmas below wait out other writers
+    sqlite3_busy_timeout(db_, options.busyTimeoutMs);
+
+    std::string sql;
+    if (const char* mode = journalModeName(options.journalMode))
+        sql += std::string("PRAGMA journal_mode=") + mode + ";";
+    if (const char* mode = synchronousName(options.synchronous))
+        sql += std::string("PRAGMA synchronous=") + mode + ";";
+    if (const char* mode = tempStoreName(options.tempStore))
+        sql += std::string("PRAGMA temp_store=") + mode + ";";
+    if (options.mmapSize >= 0)
+        sql += "PRAGMA mmap_size=" + std::to_string(options.mmapSize) + ";";
+    if (options.cacheSizeKiB > 0)
+        sql += "PRAGMA cache_size=-" + std::to_string(options.cacheSizeKiB) + ";";
+    if (options_.readOnly)
+        sql += "PRAGMA query_only=1;";
+
+    if (!sql.empty() && !exec(sql, result))
+        return false;
+
+    const bool readOnly = options_.readOnly;
+    options_ = options;
+    options_.readOnly = readOnly;   // fixed by the open flags
+    result.clear();
+    return true;
 }
 
 Database::~Database() {
+    // Idle cached statements go now. close_v2 rather than close: a
+    // statement still out (an uncached prepare() handle) would make
+    // sqlite3_close fail and leak the connection; this way it closes
+    // when that statement is finalized.
+    stmtCache_.clear();
     if (db_) {
-        sqlite3_close(db_);
+        sqlite3_trace_v2(db_, 0, nullptr, nullptr);
+        sqlite3_close_v2(db_);
+    }
+}
+
+void Database::setProfiler(std::shared_ptr<QueryProfiler> profiler) {
+    if (!db_)
+        return;
+
+    profiledRuns_.clear();
+    profiler_ = std::move(profiler);
+    if (!profiler_) {
+        sqlite3_trace_v2(db_, 0, nullptr, nullptr);
+        return;
+    }
+
+    // Cached statements carry counters from before profiling began
+    for (sqlite3_stmt* stmt = sqlite3_next_stmt(db_, nullptr); stmt; stmt = sqlite3_next_stmt(db_, stmt)) {
+        for (int op : { SQLITE_STMTSTATUS_FULLSCAN_STEP, SQLITE_STMTSTATUS_SORT,
+                        SQLITE_STMTSTATUS_AUTOINDEX, SQLITE_STMTSTATUS_VM_STEP })
+            sqlite3_stmt_status(stmt, op, 1);
     }
+    sqlite3_trace_v2(db_, SQLITE_TRACE_STMT | SQLITE_TRACE_ROW | SQLITE_TRACE_PROFILE,
+        &Database::traceHook, this);
+}
+
+int Database::traceHook(unsigned type, void* context, void* p, void* /*x*/) {
+    auto* self = static_cast<Database*>(context);
+    auto* stmt = static_cast<sqlite3_stmt*>(p);
+
+    // The profile event's own time comes from the VFS clock, which has
+    // millisecond resolution; time the run with steady_clock instead.
+    // TRACE_STMT fires again for each trigger program, so keep the first.
+    switch (type) {
+    case SQLITE_TRACE_STMT:
+        self->profiledRuns_.try_emplace(stmt, ProfiledRun{ std::chrono::steady_clock::now() });
+        return 0;
+    case SQLITE_TRACE_ROW:
+        if (auto it = self->profiledRuns_.find(stmt); it != self->profiledRuns_.end())
+            ++it->second.rows;
+        return 0;
+    case SQLITE_TRACE_PROFILE:
+        break;
+    default:
+        return 0;
+    }
+
+    auto it = self->profiledRuns_.find(stmt);
+    if (it == self->profiledRuns_.end() || !self->profiler_)
+        return 0;   // started before profiling was attached
+    const ProfiledRun run = it->second;
+    self->profiledRuns_.erase(it);
+
+    const auto elapsed = std::chrono::steady_clock::now() - run.started;
+    // Reset flag set: the counters then cover exactly this run
+    self->profiler_->record(sqlite3_sql(stmt),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), run.rows,
+        sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1),
+        sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, 1),
+        sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_AUTOINDEX, 1),
+        sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_VM_STEP, 1));
+    return 0;
 }
 
 bool Database::isOpen() const {
@@ -52,6 +191,52 @@ void Database::finalize(sqlite3_stmt* stmt) {
     }
 }
 
+bool Database::prepareCached(const std::string& sql, CachedStatement& stmt, DbResult& result) {
+    int rc = stmtCache_.acquire(db_, sql, stmt);
+    if (rc != SQLITE_OK) {
+        result.setError(rc, sqlite3_errmsg(db_));
+        return false;
+    }
+    result.clear();
+    return true;
+}
+
+bool Database::stepRows(sqlite3_stmt* stmt, const std::function<bool(sqlite3_stmt*)>& onRow,
+    DbResult& result) {
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        if (!onRow(stmt))
+            break;
+    }
+
+    if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+        result.setError(rc, sqlite3_errmsg(db_));
+        return false;
+    }
+    result.clear();
+    return true;
+}
+
+bool Database::dataVersion(long long& version, DbResult& result) {
+    CachedStatement stmt;
+    if (!prepareCached("PRAGMA data_version;", stmt, result))
+        return false;
+
+    if (sqlite3_step(stmt) != SQLITE_ROW) {
+        result.setError(sqlite3_errcode(db_), sqlite3_errmsg(db_));
+        return false;
+    }
+    version = sqlite3_column_int64(stmt, 0);
+    result.clear();
+    return true;
+}
+
+unsigned long long Database::snapshotSerial() const {
+    if (transactionDepth_ == 0 || !db_ || sqlite3_get_autocommit(db_) != 0)
+        return 0;
+    return sqlite3_txn_state(db_, "main") >= SQLITE_TXN_READ ? transactionSerial_ : 0;
+}
+
 int Database::lastInsertId() const {
     if (db_) {
         return static_cast<int>(sqlite3_last_insert_rowid(db_));
@@ -80,6 +265,24 @@ bool Database::tableExists(const std::string& tableName) const {
     return exists;
 }
 
+bool Database::indexExists(const std::string& indexName) const {
+    if (!db_) return false;
+
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql = "SELECT name FROM sqlite_master WHERE type='index' AND name=?;";
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        return false;
+    }
+
+    sqlite3_bind_text(stmt, 1, indexName.c_str(), -1, SQLITE_TRANSIENT);
+
+    bool exists = (sqlite3_step(stmt) == SQLITE_ROW);
+
+    sqlite3_finalize(stmt);
+    return exists;
+}
+
 bool Database::columnExists(const std::string& tableName, const std::string& columnName) const {
     if (!db_) return false;
 
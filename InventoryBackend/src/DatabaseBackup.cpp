@@ -0,0 +1,198 @@
+#include "DatabaseBackup.h"
+#include "Database.h"
+#include "DatabaseOptions.h"
+#include "DbUtils.h"
+#include <sqlite3.h>
+
+#include <filesystem>
+#include <system_error>
+#include <thread>
+
+namespace {
+
+// VM instructions between cancellation checks during VACUUM INTO
+constexpr int kCancelCheckOps = 10000;
+
+int stopRequested(void* token)
+{
+    return static_cast<const std::stop_token*>(token)->stop_requested() ? 1 : 0;
+}
+
+bool journalModeIsWal(Database& db, DbResult& result)
+{
+    CachedStatement stmt;
+    if (!db.prepareCached("PRAGMA journal_mode;", stmt, result))
+        return false;
+
+    bool wal = false;
+    db.stepRows(stmt, [&](sqlite3_stmt* row) {
+        wal = safeColumnView(row, 0) == "wal";
+        return false;
+    }, result);
+    return wal;
+}
+
+int pageCount(Database& db)
+{
+    DbResult result;
+    CachedStatement stmt;
+    int pages = 0;
+    if (db.prepareCached("PRAGMA page_count;", stmt, result)) {
+        db.stepRows(stmt, [&](sqlite3_stmt* row) {
+            pages = sqlite3_column_int(row, 0);
+            return false;
+        }, result);
+    }
+    return pages;
+}
+
+} // namespace
+
+bool DatabaseBackup::copy(const std::string& sourcePath, const std::string& destPath,
+    const BackupOptions& options, const BackupProgressFn& progress, DbResult& result)
+{
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    if (fs::equivalent(sourcePath, destPath, ec)) {
+        result.setError(SQLITE_MISUSE, "Cannot back up " + sourcePath + " onto itself");
+        return false;
+    }
+
+    const std::string partialPath = destPath + ".partial";
+    fs::remove(partialPath, ec);
+
+    const bool ok = options.compact
+        ? vacuumInto(sourcePath, partialPath, options, progress, result)
+        : copyPages(sourcePath, partialPath, options, progress, result);
+
+    if (!ok) {
+        fs::remove(partialPath, ec);
+        return false;
+    }
+
+    fs::rename(partialPath, destPath, ec);
+    if (ec) {
+        fs::remove(partialPath, ec);
+        result.setError(SQLITE_CANTOPEN, "Cannot move the backup to " + destPath);
+        return false;
+    }
+
+    result.clear();
+    return true;
+}
+
+bool DatabaseBackup::copyPages(const std::string& sourcePath, const std::string& partialPath,
+    const BackupOptions& options, const BackupProgressFn& progress, DbResult& result)
+{
+    Database source(sourcePath, DatabaseOptions::readOnlyReporting(), result);
+    if (!source.isOpen())
+        return false;
+
+    // Scoped so the file is closed before copy() renames it
+    Database dest(partialPath, result);
+    if (!dest.isOpen())
+        return false;
+
+    // A snapshot for the whole copy; only safe to hold under WAL, where
+    // it does not block writers
+    const bool wal = journalModeIsWal(source, result);
+    if (!result.ok())
+        return false;
+    if (wal && !source.exec("BEGIN; SELECT 1 FROM sqlite_schema LIMIT 1;", result))
+        return false;
+
+    sqlite3_backup* backup = sqlite3_backup_init(dest.handle(), "main", source.handle(), "main");
+    if (!backup) {
+        result.setError(sqlite3_errcode(dest.handle()), sqlite3_errmsg(dest.handle()));
+        if (wal) {
+            DbResult ignored;
+            source.exec("ROLLBACK;", ignored);
+        }
+        return false;
+    }
+
+    const int pagesPerStep = options.pagesPerStep > 0 ? options.pagesPerStep : -1;
+    int rc = SQLITE_OK;
+    while (true) {
+        rc = sqlite3_backup_step(backup, pagesPerStep);
+
+        if (progress) {
+            const int total = sqlite3_backup_pagecount(backup);
+            progress({ total - sqlite3_backup_remaining(backup), total });
+        }
+
+        if (rc == SQLITE_DONE)
+            break;
+        if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED)
+            break;
+        if (options.cancel.stop_requested()) {
+            rc = SQLITE_INTERRUPT;
+            break;
+        }
+        if (options.pause.count() > 0)
+            std::this_thread::sleep_for(options.pause);
+    }
+
+    // finish() reports the step error, if any, on the destination
+    const int finishRc = sqlite3_backup_finish(backup);
+    if (rc == SQLITE_INTERRUPT)
+        result.setError(SQLITE_INTERRUPT, "Backup cancelled");
+    else if (rc != SQLITE_DONE || finishRc != SQLITE_OK)
+        result.setError(sqlite3_errcode(dest.handle()), sqlite3_errmsg(dest.handle()));
+
+    if (wal) {
+        DbResult ignored;
+        source.exec("COMMIT;", ignored);
+    }
+
+    if (rc != SQLITE_DONE || finishRc != SQLITE_OK)
+        return false;
+
+    result.clear();
+    return true;
+}
+
+bool DatabaseBackup::vacuumInto(const std::string& sourcePath, const std::string& partialPath,
+    const BackupOptions& options, const BackupProgressFn& progress, DbResult& result)
+{
+    // VACUUM INTO only reads the source, but SQLite refuses it on a
+    // read-only connection
+    DatabaseOptions sourceOptions = DatabaseOptions::readOnlyReporting();
+    sourceOptions.readOnly = false;
+    Database source(sourcePath, sourceOptions, result);
+    if (!source.isOpen())
+        return false;
+
+    const int pagesTotal = pageCount(source);
+
+    // VACUUM INTO is a single statement; cancel through the progress handler
+    std::stop_token cancel = options.cancel;
+    sqlite3_progress_handler(source.handle(), kCancelCheckOps, stopRequested, &cancel);
+
+    sqlite3_stmt* stmt = nullptr;
+    bool ok = source.prepare("VACUUM INTO ?;", stmt, result);
+    if (ok) {
+        sqlite3_bind_text(stmt, 1, partialPath.c_str(), -1, SQLITE_TRANSIENT);
+        const int rc = sqlite3_step(stmt);
+        if (rc == SQLITE_INTERRUPT) {
+            result.setError(SQLITE_INTERRUPT, "Backup cancelled");
+            ok = false;
+        }
+        else if (rc != SQLITE_DONE) {
+            result.setError(sqlite3_errcode(source.handle()), sqlite3_errmsg(source.handle()));
+            ok = false;
+        }
+    }
+    source.finalize(stmt);
+    sqlite3_progress_handler(source.handle(), 0, nullptr, nullptr);
+
+    if (!ok)
+        return false;
+
+    if (progress)
+        progress({ pagesTotal, pagesTotal });
+
+    result.clear();
+    return true;
+}
@@ -0,0 +1,53 @@
+#include "DatabaseOptions.h"
+
+DatabaseOptions DatabaseOptions::interactive()
+{
+    DatabaseOptions o;
+    o.journalMode = JournalMode::Wal;
+    o.synchronous = Synchronous::Normal;
+    o.tempStore = TempStore::Memory;
+    o.mmapSize = 256LL * 1024 * 1024;
+    o.cacheSizeKiB = 64 * 1024;
+    o.busyTimeoutMs = 5000;
+    return o;
+}
+
+DatabaseOptions DatabaseOptions::bulkLoad()
+{
+    DatabaseOptions o;
+    o.journalMode = JournalMode::Wal;
+    o.synchronous = Synchronous::Off;
+    o.tempStore = TempStore::Memory;
+    o.mmapSize = 256LL * 1024 * 1024;
+    o.cacheSizeKiB = 256 * 1024;
+    o.busyTimeoutMs = 30000;
+    return o;
+}
+
+DatabaseOptions DatabaseOptions::readOnlyReporting()
+{
+    DatabaseOptions o;
+    o.readOnly = true;
+    o.tempStore = TempStore::Memory;
+    o.mmapSize = 1024LL * 1024 * 1024;
+    o.cacheSizeKiB = 128 * 1024;
+    o.busyTimeoutMs = 5000;
+    return o;
+}
+
+bool DatabaseOptions::fromProfileName(const std::string& name, DatabaseOptions& options)
+{
+    if (name == "interactive") {
+        options = interactive();
+        return true;
+    }
+    if (name == "bulk-load") {
+        options = bulkLoad();
+        return true;
+    }
+    if (name == "read-only-reporting") {
+        options = readOnlyReporting();
+        return true;
+    }
+    return false;
+}
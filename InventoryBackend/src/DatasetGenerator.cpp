@@ -0,0 +1,793 @@
+#include "DatasetGenerator.h"
+#include "Transaction.h"
+#include "SchemaManager.h"
+#include "ComponentManager.h"
+#include "CategoryManager.h"
+#include "ManufacturerManager.h"
+#include "ResistorManager.h"
+#include "ResistorPackageManager.h"
+#include "ResistorCompositionManager.h"
+#include "CapacitorManager.h"
+#include "CapacitorPackageManager.h"
+#include "CapacitorDielectricManager.h"
+#include "TransistorManager.h"
+#include "TransistorTypeManager.h"
+#include "TransistorPolarityManager.h"
+#include "TransistorPackageManager.h"
+#include "BJTManager.h"
+#include "DiodeManager.h"
+#include "DiodeTypeManager.h"
+#include "DiodePackageManager.h"
+#include "DiodePolarityManager.h"
+#include "FuseManager.h"
+#include "FuseTypeManager.h"
+#include "FusePackageManager.h"
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Rows are built and inserted in groups of this size, category by
+// category. Fixed, so IDs do not depend on DatasetOptions::batchRows.
+constexpr int kGroupRows = 1000;
+
+constexpr double kE24[] = {
+    1.0, 1.1, 1.2, 1.3, 1.5, 1.6, 1.8, 2.0, 2.2, 2.4, 2.7, 3.0,
+    3.3, 3.6, 3.9, 4.3, 4.7, 5.1, 5.6, 6.2, 6.8, 7.5, 8.2, 9.1 };
+constexpr double kE6[] = { 1.0, 1.5, 2.2, 3.3, 4.7, 6.8 };
+constexpr double kFuseAmps[] = {
+    0.1, 0.125, 0.16, 0.2, 0.25, 0.315, 0.4, 0.5, 0.63, 0.8, 1.0, 1.25,
+    1.6, 2.0, 2.5, 3.15, 4.0, 5.0, 6.3, 8.0, 10.0, 12.5, 16.0, 20.0 };
+
+// SplitMix64: tiny, fast and identical on every compiler
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // [0, n)
+    int below(int n) { return static_cast<int>(next() % static_cast<std::uint64_t>(n)); }
+
+    // [0, 1)
+    double unit() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    double between(double lo, double hi) { return lo + (hi - lo) * unit(); }
+
+    bool chance(double p) { return unit() < p; }
+
+    template <class T, std::size_t N>
+    const T& pick(const T (&values)[N]) { return values[below(static_cast<int>(N))]; }
+
+    // Index into weights, proportional to its entry
+    int weighted(std::initializer_list<int> weights) {
+        int total = 0;
+        for (int w : weights)
+            total += w;
+        int r = below(total);
+        int i = 0;
+        for (int w : weights) {
+            if (r < w)
+                return i;
+            r -= w;
+            ++i;
+        }
+        return i - 1;
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+// Two significant digits, e.g. 4.7 ohm, 10 ohm, 470 ohm
+double roundValue(double v)
+{
+    return std::round(v * 100.0) / 100.0;
+}
+
+// "4.7k", "100", "2.2M" (engineering prefix, trailing zeros dropped)
+std::string siValue(double v)
+{
+    static const struct { double scale; const char* prefix; } kPrefixes[] = {
+        { 1e6, "M" }, { 1e3, "k" }, { 1.0, "" }, { 1e-3, "m" },
+        { 1e-6, "u" }, { 1e-9, "n" }, { 1e-12, "p" } };
+
+    for (const auto& p : kPrefixes) {
+        if (v >= p.scale * 0.999 || p.scale == 1e-12) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.3g%s", v / p.scale, p.prefix);
+            return buf;
+        }
+    }
+    return std::to_string(v);
+}
+
+// Resistor value code: 4K7, 100R, 1M0
+std::string resistorCode(double ohms)
+{
+    const char* unit = "R";
+    double v = ohms;
+    if (ohms >= 1e6) { unit = "M"; v = ohms / 1e6; }
+    else if (ohms >= 1e3) { unit = "K"; v = ohms / 1e3; }
+
+    const int whole = static_cast<int>(v + 1e-9);
+    const int tenth = static_cast<int>(std::round((v - whole) * 10.0));
+    char buf[16];
+    if (whole >= 10)
+        std::snprintf(buf, sizeof(buf), "%d%s", whole, unit);
+    else
+        std::snprintf(buf, sizeof(buf), "%d%s%d", whole, unit, tenth);
+    return buf;
+}
+
+// EIA capacitance code in pF: 104 = 100 nF
+std::string capacitorCode(double farads)
+{
+    double pf = farads * 1e12;
+    int exponent = 0;
+    while (pf >= 100.0) {
+        pf /= 10.0;
+        ++exponent;
+    }
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%02d%d", static_cast<int>(std::round(pf)), exponent);
+    return buf;
+}
+
+// 1..10000, most parts stocked in the tens and hundreds
+int quantity(Rng& rng)
+{
+    return static_cast<int>(std::pow(10.0, rng.unit() * 4.0));
+}
+
+std::string notes(Rng& rng)
+{
+    const int r = rng.below(100);
+    if (r < 2)
+        return "obsolete, check stock";
+    if (r < 7)
+        return "preferred part";
+    return {};
+}
+
+struct Ids {
+    int resistor = 0, capacitor = 0, transistor = 0, diode = 0, fuse = 0;
+
+    std::vector<int> resistorMakers, capacitorMakers, semiconductorMakers, fuseMakers;
+
+    int r0603 = 0, r0805 = 0, rAxial = 0;
+    int carbonFilm = 0, metalFilm = 0, wirewound = 0;
+
+    int c0g = 0, x7r = 0, y5v = 0, polyester = 0, polypropylene = 0,
+        aluminum = 0, tantalum = 0, mica = 0;
+    int cRadial = 0, cAxial = 0, cSmd = 0;
+
+    int bjt = 0, mosfet = 0;
+    int npn = 0, pnp = 0, nChannel = 0, pChannel = 0;
+    int to92 = 0, to126 = 0, to220 = 0, to3p = 0;
+
+    int rectifier = 0, zener = 0, schottky = 0, led = 0, tvs = 0;
+    int dAxial = 0, dRadial = 0, sod123 = 0, sod323 = 0, do214 = 0, dTo220 = 0;
+    int anodeCathode = 0, cathodeAnode = 0;
+
+    int fastBlow = 0, slowBlow = 0, resettable = 0;
+    int fAxial = 0, fRadial = 0, cartridge = 0, fSmd = 0;
+};
+
+template <class Manager>
+int idByName(Manager& mgr, const char* name, DbResult& result)
+{
+    // The transistor and diode lookups predate LookupManager
+    if constexpr (std::is_base_of_v<LookupManager, Manager>)
+        return mgr.getIdByName(name, result);
+    else
+        return mgr.getByName(name, result);
+}
+
+template <class Manager>
+bool resolveAll(Manager& mgr, std::initializer_list<std::pair<const char*, int*>> names,
+    DbResult& result)
+{
+    for (const auto& [name, id] : names) {
+        *id = idByName(mgr, name, result);
+        if (*id <= 0) {
+            result.setError(SQLITE_NOTFOUND, std::string("Seeded lookup value missing: ") + name);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Manufacturers are optional: a renamed or deleted seed just drops out
+void resolveMakers(ManufacturerManager& mgr, std::initializer_list<const char*> names,
+    std::vector<int>& ids)
+{
+    DbResult ignored;
+    for (const char* name : names) {
+        const int id = mgr.getIdByName(name, ignored);
+        if (id > 0)
+            ids.push_back(id);
+    }
+    if (ids.empty())
+        ids.push_back(0);
+}
+
+// One group's rows, per category, ready for the batch inserts
+struct Group {
+    std::vector<Component> resistorComps;
+    std::vector<Resistor> resistors;
+    std::vector<Component> capacitorComps;
+    std::vector<Capacitor> capacitors;
+    std::vector<Component> transistorComps;
+    std::vector<Transistor> transistors;
+    std::vector<std::optional<BJT>> bjts;
+    std::vector<Component> diodeComps;
+    std::vector<Diode> diodes;
+    std::vector<Component> fuseComps;
+    std::vector<Fuse> fuses;
+
+    void clear() {
+        resistorComps.clear(); resistors.clear();
+        capacitorComps.clear(); capacitors.clear();
+        transistorComps.clear(); transistors.clear(); bjts.clear();
+        diodeComps.clear(); diodes.clear();
+        fuseComps.clear(); fuses.clear();
+    }
+};
+
+class RowFactory {
+public:
+    RowFactory(const Ids& ids, std::uint64_t seed) : ids_(ids), rng_(seed) {}
+
+    void add(const DatasetMix& mix, Group& group) {
+        ++seq_;
+        switch (rng_.weighted({ mix.resistors, mix.capacitors, mix.transistors,
+                                mix.diodes, mix.fuses })) {
+        case 0: resistor(group); break;
+        case 1: capacitor(group); break;
+        case 2: transistor(group); break;
+        case 3: diode(group); break;
+        default: fuse(group); break;
+        }
+    }
+
+private:
+    Component component(int categoryId, const std::vector<int>& makers,
+        std::string partNumber, std::string description) {
+        Component c(partNumber, description, categoryId,
+            makers[rng_.below(static_cast<int>(makers.size()))], quantity(rng_));
+        c.notes = notes(rng_);
+        return c;
+    }
+
+    std::string partNumber(const char* format, const std::string& a, const std::string& b) {
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), format, a.c_str(), b.c_str(), seq_);
+        return buf;
+    }
+
+    void resistor(Group& group) {
+        Resistor r;
+        r.resistance = roundValue(rng_.pick(kE24) * std::pow(10.0, rng_.below(7)));
+
+        const int pkg = rng_.weighted({ 35, 40, 25 });
+        r.packageTypeId = pkg == 0 ? ids_.r0603 : pkg == 1 ? ids_.r0805 : ids_.rAxial;
+
+        const int grade = rng_.weighted({ 10, 60, 30 });
+        r.tolerance = grade == 0 ? 0.1 : grade == 1 ? 1.0 : 5.0;
+
+        const bool wirewound = pkg == 2 && r.resistance < 1000.0 && rng_.chance(0.15);
+        r.compositionId = wirewound ? ids_.wirewound
+            : r.tolerance < 5.0 ? ids_.metalFilm : ids_.carbonFilm;
+
+        static const double kAxialWatts[] = { 0.25, 0.5, 1.0 };
+        static const double kWirewoundWatts[] = { 2.0, 5.0, 10.0 };
+        r.powerRating = pkg == 0 ? 0.1 : pkg == 1 ? 0.125
+            : wirewound ? rng_.pick(kWirewoundWatts) : rng_.pick(kAxialWatts);
+        r.voltageRating = pkg == 0 ? 50.0 : pkg == 1 ? 150.0 : 350.0;
+        r.leadSpacing = pkg == 2 ? 10.16 : 0.0;
+
+        r.hasTempCoeff = r.compositionId == ids_.metalFilm || rng_.chance(0.3);
+        if (r.hasTempCoeff) {
+            const double tcr = r.tolerance <= 0.1 ? 25.0 : r.compositionId == ids_.metalFilm ? 50.0 : 350.0;
+            r.tempCoeffMin = -tcr;
+            r.tempCoeffMax = tcr;
+        }
+        r.hasTempRange = rng_.chance(0.8);
+        if (r.hasTempRange) {
+            r.tempMin = -55.0;
+            r.tempMax = pkg == 2 ? 125.0 : 155.0;
+        }
+
+        static const char* const kPkgCode[] = { "0603", "0805", "AX" };
+        static const char* const kPkgName[] = { "0603", "0805", "axial" };
+        const char* material = wirewound ? "wirewound"
+            : r.compositionId == ids_.metalFilm ? "metal film" : "carbon film";
+        char desc[128];
+        std::snprintf(desc, sizeof(desc), "Resistor %s ohm %g%% %gW %s %s",
+            siValue(r.resistance).c_str(), r.tolerance, r.powerRating, kPkgName[pkg], material);
+
+        const char tolLetter[] = { r.tolerance <= 0.1 ? 'B' : r.tolerance <= 1.0 ? 'F' : 'J', 0 };
+        group.resistorComps.push_back(component(ids_.resistor, ids_.resistorMakers,
+            partNumber("R%s-%s-%08lld", kPkgCode[pkg], resistorCode(r.resistance) + "-" + tolLetter),
+            desc));
+        group.resistors.push_back(r);
+    }
+
+    void capacitor(Group& group) {
+        Capacitor c;
+        c.capacitance = rng_.pick(kE6) * std::pow(10.0, -12 + rng_.below(9));   // 1 pF .. 680 uF
+
+        static const double kCeramicVolts[] = { 16.0, 25.0, 50.0, 100.0 };
+        static const double kFilmVolts[] = { 63.0, 100.0, 250.0, 400.0 };
+        static const double kAluminumVolts[] = { 6.3, 10.0, 16.0, 25.0, 35.0, 50.0, 63.0, 100.0, 400.0 };
+        static const double kTantalumVolts[] = { 6.3, 10.0, 16.0, 25.0, 35.0 };
+
+        const char* dielectric = nullptr;
+        if (c.capacitance < 1e-9) {
+            const bool isMica = rng_.chance(0.15);
+            c.dielectricTypeId = isMica ? ids_.mica : ids_.c0g;
+            dielectric = isMica ? "mica" : "C0G";
+            c.tolerance = 5.0;
+            c.voltageRating = isMica ? 500.0 : rng_.pick(kCeramicVolts);
+            c.packageTypeId = isMica ? ids_.cRadial : rng_.chance(0.8) ? ids_.cSmd : ids_.cRadial;
+        }
+        else if (c.capacitance < 1e-6) {
+            switch (rng_.weighted({ 60, 10, 15, 15 })) {
+            case 0: c.dielectricTypeId = ids_.x7r; dielectric = "X7R"; c.tolerance = 10.0; break;
+            case 1: c.dielectricTypeId = ids_.y5v; dielectric = "Y5V"; c.tolerance = 20.0; break;
+            case 2: c.dielectricTypeId = ids_.polyester; dielectric = "polyester film"; c.tolerance = 10.0; break;
+            default: c.dielectricTypeId = ids_.polypropylene; dielectric = "polypropylene film"; c.tolerance = 5.0; break;
+            }
+            const bool film = c.dielectricTypeId == ids_.polyester || c.dielectricTypeId == ids_.polypropylene;
+            c.voltageRating = film ? rng_.pick(kFilmVolts) : rng_.pick(kCeramicVolts);
+            c.packageTypeId = film ? (rng_.chance(0.7) ? ids_.cRadial : ids_.cAxial)
+                : rng_.chance(0.8) ? ids_.cSmd : ids_.cRadial;
+        }
+        else {
+            int kind = rng_.weighted({ 20, 55, 25 });
+            if (kind == 0 && c.capacitance > 22e-6)
+                kind = 1;
+            if (kind == 0) {
+                c.dielectricTypeId = ids_.x7r; dielectric = "X7R"; c.tolerance = 10.0;
+                c.voltageRating = rng_.pick(kCeramicVolts);
+                c.packageTypeId = ids_.cSmd;
+            }
+            else if (kind == 1) {
+                c.dielectricTypeId = ids_.aluminum; dielectric = "aluminum electrolytic"; c.tolerance = 20.0;
+                c.voltageRating = rng_.pick(kAluminumVolts);
+                c.packageTypeId = ids_.cRadial;
+                c.polarized = true;
+            }
+            else {
+                c.dielectricTypeId = ids_.tantalum; dielectric = "tantalum"; c.tolerance = 10.0;
+                c.voltageRating = rng_.pick(kTantalumVolts);
+                c.packageTypeId = ids_.cSmd;
+                c.polarized = true;
+            }
+            if (c.polarized) {
+                c.esr = roundValue(rng_.between(0.02, 2.0));
+                c.leakageCurrent = 0.01 * c.capacitance * c.voltageRating;   // 0.01 CV
+            }
+        }
+
+        if (c.packageTypeId == ids_.cSmd) {
+            c.length = 2.0;
+            c.width = 1.25;
+            c.height = 1.25;
+        }
+        else {
+            c.diameter = c.capacitance >= 1e-4 ? 10.0 : c.capacitance >= 1e-6 ? 6.3 : 5.0;
+            c.height = c.diameter * 1.8;
+            c.leadSpacing = c.diameter >= 10.0 ? 5.0 : 2.5;
+        }
+
+        const char* pkg = c.packageTypeId == ids_.cSmd ? "SMD"
+            : c.packageTypeId == ids_.cAxial ? "axial" : "radial";
+        char desc[128];
+        std::snprintf(desc, sizeof(desc), "Capacitor %sF %gV %s %s",
+            siValue(c.capacitance).c_str(), c.voltageRating, dielectric, pkg);
+
+        char volts[16];
+        std::snprintf(volts, sizeof(volts), "%gV", c.voltageRating);
+        group.capacitorComps.push_back(component(ids_.capacitor, ids_.capacitorMakers,
+            partNumber("C%s-%s-%08lld", capacitorCode(c.capacitance), volts), desc));
+        group.capacitors.push_back(c);
+    }
+
+    void transistor(Group& group) {
+        Transistor t;
+        const bool isBjt = rng_.chance(0.7);
+        t.typeId = isBjt ? ids_.bjt : ids_.mosfet;
+        const bool positive = rng_.chance(isBjt ? 0.6 : 0.7);
+        t.polarityId = isBjt ? (positive ? ids_.npn : ids_.pnp)
+                             : (positive ? ids_.nChannel : ids_.pChannel);
+
+        const int pkg = isBjt ? rng_.weighted({ 50, 15, 30, 5 }) : rng_.weighted({ 20, 0, 60, 20 });
+        static const char* const kPkgName[] = { "TO-92", "TO-126", "TO-220", "TO-3P" };
+        const int pkgIds[] = { ids_.to92, ids_.to126, ids_.to220, ids_.to3p };
+        t.packageId = pkgIds[pkg];
+
+        // Ratings grow with the package
+        static const double kVce[][5] = {
+            { 30, 40, 45, 60, 80 }, { 60, 80, 100, 140, 160 },
+            { 60, 100, 140, 200, 250 }, { 140, 200, 230, 300, 400 } };
+        static const double kIc[][4] = {
+            { 0.1, 0.2, 0.5, 0.8 }, { 1.5, 2.0, 3.0, 4.0 },
+            { 3.0, 5.0, 8.0, 15.0 }, { 10.0, 15.0, 17.0, 25.0 } };
+        static const double kPd[] = { 0.625, 12.5, 65.0, 150.0 };
+
+        const double vce = kVce[pkg][rng_.below(5)];
+        const double ic = kIc[pkg][rng_.below(4)];
+        std::optional<BJT> bjt;
+        if (isBjt) {
+            const double hfe = std::round(pkg == 0 ? rng_.between(100, 400) : rng_.between(20, 160));
+            const double ft = std::round(pkg == 0 ? rng_.between(100e6, 300e6) : rng_.between(2e6, 60e6));
+            bjt = BJT(0, vce, ic, kPd[pkg], hfe, ft);
+        }
+
+        static const char* const kPolarity[] = { "NPN", "PNP", "N-channel", "P-channel" };
+        const char* polarity = kPolarity[(isBjt ? 0 : 2) + (positive ? 0 : 1)];
+        char desc[128];
+        std::snprintf(desc, sizeof(desc), "%s %s %gV %gA %s", polarity,
+            isBjt ? "BJT transistor" : "MOSFET transistor", vce, ic, kPkgName[pkg]);
+
+        static const char* const kPnPolarity[] = { "NPN", "PNP", "NCH", "PCH" };
+        group.transistorComps.push_back(component(ids_.transistor, ids_.semiconductorMakers,
+            partNumber("Q%s-%s-%08lld", kPnPolarity[(isBjt ? 0 : 2) + (positive ? 0 : 1)], kPkgName[pkg]),
+            desc));
+        group.transistors.push_back(t);
+        group.bjts.push_back(bjt);
+    }
+
+    void diode(Group& group) {
+        Diode d;
+        d.polarityId = rng_.chance(0.9) ? ids_.anodeCathode : ids_.cathodeAnode;
+
+        static const char* const kTypeName[] = { "rectifier", "Zener", "Schottky", "LED", "TVS" };
+        static const char* const kTypeCode[] = { "RECT", "ZEN", "SCH", "LED", "TVS" };
+        const int type = rng_.weighted({ 35, 20, 20, 15, 10 });
+        const int typeIds[] = { ids_.rectifier, ids_.zener, ids_.schottky, ids_.led, ids_.tvs };
+        d.typeId = typeIds[type];
+
+        switch (type) {
+        case 0: {
+            static const double kAmps[] = { 1.0, 3.0, 6.0 };
+            static const double kVolts[] = { 50, 100, 200, 400, 600, 800, 1000 };
+            const int pkgIds[] = { ids_.dAxial, ids_.do214, ids_.dTo220 };
+            d.packageId = pkgIds[rng_.weighted({ 50, 35, 15 })];
+            d.forwardVoltage = roundValue(rng_.between(0.95, 1.1));
+            d.maxCurrent = rng_.pick(kAmps);
+            d.maxReverseVoltage = rng_.pick(kVolts);
+            d.reverseLeakage = 5e-6;
+            break;
+        }
+        case 1: {
+            const int pkgIds[] = { ids_.sod123, ids_.sod323, ids_.dAxial };
+            d.packageId = pkgIds[rng_.weighted({ 40, 30, 30 })];
+            d.forwardVoltage = 0.9;
+            d.maxCurrent = 0.2;
+            // Zener voltage on the E24 series, 2.4 V to 91 V
+            d.maxReverseVoltage = rng_.chance(0.5) ? kE24[9 + rng_.below(15)]
+                                                   : roundValue(rng_.pick(kE24) * 10.0);
+            d.reverseLeakage = 1e-7;
+            break;
+        }
+        case 2: {
+            static const double kAmps[] = { 0.5, 1.0, 2.0, 3.0, 5.0 };
+            static const double kVolts[] = { 20, 30, 40, 60, 100 };
+            const int pkgIds[] = { ids_.sod123, ids_.do214, ids_.dTo220 };
+            d.packageId = pkgIds[rng_.weighted({ 45, 40, 15 })];
+            d.forwardVoltage = roundValue(rng_.between(0.3, 0.55));
+            d.maxCurrent = rng_.pick(kAmps);
+            d.maxReverseVoltage = rng_.pick(kVolts);
+            d.reverseLeakage = 1e-4;
+            break;
+        }
+        case 3: {
+            static const double kForward[] = { 1.8, 2.0, 2.1, 3.0, 3.2 };
+            d.packageId = rng_.chance(0.8) ? ids_.dRadial : ids_.sod123;
+            d.forwardVoltage = rng_.pick(kForward);
+            d.maxCurrent = 0.02;
+            d.maxReverseVoltage = 5.0;
+            d.reverseLeakage = 1e-5;
+            break;
+        }
+        default: {
+            static const double kStandoff[] = { 5, 12, 15, 24, 33, 58 };
+            d.packageId = rng_.chance(0.7) ? ids_.do214 : ids_.dAxial;
+            d.forwardVoltage = 3.5;
+            d.maxCurrent = 40.0;
+            d.maxReverseVoltage = rng_.pick(kStandoff);
+            d.reverseLeakage = 1e-6;
+            break;
+        }
+        }
+
+        char desc[128];
+        std::snprintf(desc, sizeof(desc), "%s diode %gV %gA", kTypeName[type],
+            d.maxReverseVoltage, d.maxCurrent);
+        char volts[16];
+        std::snprintf(volts, sizeof(volts), "%gV", d.maxReverseVoltage);
+        group.diodeComps.push_back(component(ids_.diode, ids_.semiconductorMakers,
+            partNumber("D%s-%s-%08lld", kTypeCode[type], volts), desc));
+        group.diodes.push_back(d);
+    }
+
+    void fuse(Group& group) {
+        Fuse f;
+        static const char* const kTypeName[] = { "fast-blow", "slow-blow", "resettable" };
+        static const char* const kTypeCode[] = { "F", "T", "PTC" };
+        const int type = rng_.weighted({ 45, 35, 20 });
+        const int typeIds[] = { ids_.fastBlow, ids_.slowBlow, ids_.resettable };
+        f.typeId = typeIds[type];
+
+        // Resettable fuses top out at a few amps and are never cartridges
+        const int maxAmp = type == 2 ? 17 : static_cast<int>(std::size(kFuseAmps));
+        f.currentRating = kFuseAmps[rng_.below(maxAmp)];
+
+        int pkg = type == 2 ? (rng_.chance(0.5) ? 1 : 3) : rng_.weighted({ 15, 20, 40, 25 });
+        const int pkgIds[] = { ids_.fAxial, ids_.fRadial, ids_.cartridge, ids_.fSmd };
+        static const char* const kPkgName[] = { "axial", "radial", "cartridge", "SMD" };
+        f.packageId = pkgIds[pkg];
+
+        static const double kSmdVolts[] = { 32.0, 63.0, 125.0 };
+        static const double kPtcVolts[] = { 16.0, 30.0, 60.0 };
+        f.voltageRating = type == 2 ? rng_.pick(kPtcVolts) : pkg == 3 ? rng_.pick(kSmdVolts) : 250.0;
+
+        char desc[128];
+        std::snprintf(desc, sizeof(desc), "Fuse %gA %gV %s %s", f.currentRating,
+            f.voltageRating, kTypeName[type], kPkgName[pkg]);
+        char amps[16];
+        std::snprintf(amps, sizeof(amps), "%gA", f.currentRating);
+        group.fuseComps.push_back(component(ids_.fuse, ids_.fuseMakers,
+            partNumber("F%s-%s-%08lld", kTypeCode[type], amps), desc));
+        group.fuses.push_back(f);
+    }
+
+    const Ids& ids_;
+    Rng rng_;
+    long long seq_ = 0;
+};
+
+bool resolveIds(Database& db, Ids& ids, DbResult& result)
+{
+    CategoryManager categories(db);
+    ManufacturerManager manufacturers(db);
+    ResistorPackageManager resistorPackages(db);
+    ResistorCompositionManager compositions(db);
+    CapacitorPackageManager capacitorPackages(db);
+    CapacitorDielectricManager dielectrics(db);
+    TransistorTypeManager transistorTypes(db);
+    TransistorPolarityManager transistorPolarities(db);
+    TransistorPackageManager transistorPackages(db);
+    DiodeTypeManager diodeTypes(db);
+    DiodePackageManager diodePackages(db);
+    DiodePolarityManager diodePolarities(db);
+    FuseTypeManager fuseTypes(db);
+    FusePackageManager fusePackages(db);
+
+    resolveMakers(manufacturers, { "Vishay", "Stackpole", "Panasonic", "TE Connectivity" }, ids.resistorMakers);
+    resolveMakers(manufacturers, { "Murata", "KEMET", "TDK Electronics", "Panasonic", "Rubycon", "Vishay" }, ids.capacitorMakers);
+    resolveMakers(manufacturers, { "ON Semiconductor", "Toshiba", "Sanken", "Vishay" }, ids.semiconductorMakers);
+    resolveMakers(manufacturers, { "SCHURTER", "Bel Fuse", "TE Connectivity" }, ids.fuseMakers);
+
+    return resolveAll(categories, { { "Resistor", &ids.resistor }, { "Capacitor", &ids.capacitor },
+                                    { "Transistor", &ids.transistor }, { "Diode", &ids.diode },
+                                    { "Fuse", &ids.fuse } }, result)
+        && resolveAll(resistorPackages, { { "0603", &ids.r0603 }, { "0805", &ids.r0805 },
+                                          { "Axial leaded", &ids.rAxial } }, result)
+        && resolveAll(compositions, { { "Carbon Film", &ids.carbonFilm }, { "Metal Film", &ids.metalFilm },
+                                      { "Wirewound", &ids.wirewound } }, result)
+        && resolveAll(dielectrics, { { "C0G/NP0", &ids.c0g }, { "X7R", &ids.x7r }, { "Y5V", &ids.y5v },
+                                     { "Polyester", &ids.polyester }, { "Polypropylene", &ids.polypropylene },
+                                     { "Aluminum", &ids.aluminum }, { "Tantalum", &ids.tantalum },
+                                     { "Mica", &ids.mica } }, result)
+        && resolveAll(capacitorPackages, { { "Radial leaded", &ids.cRadial }, { "Axial leaded", &ids.cAxial },
+                                           { "SMD", &ids.cSmd } }, result)
+        && resolveAll(transistorTypes, { { "BJT", &ids.bjt }, { "MOSFET", &ids.mosfet } }, result)
+        && resolveAll(transistorPolarities, { { "NPN", &ids.npn }, { "PNP", &ids.pnp },
+                                              { "N-Channel", &ids.nChannel }, { "P-Channel", &ids.pChannel } }, result)
+        && resolveAll(transistorPackages, { { "TO-92", &ids.to92 }, { "TO-126", &ids.to126 },
+                                            { "TO-220", &ids.to220 }, { "TO-3P", &ids.to3p } }, result)
+        && resolveAll(diodeTypes, { { "Rectifier", &ids.rectifier }, { "Zener", &ids.zener },
+                                    { "Schottky", &ids.schottky }, { "LED", &ids.led }, { "TVS", &ids.tvs } }, result)
+        && resolveAll(diodePackages, { { "Axial leaded", &ids.dAxial }, { "Radial leaded", &ids.dRadial },
+                                       { "SMD SOD-123", &ids.sod123 }, { "SMD SOD-323", &ids.sod323 },
+                                       { "SMD DO-214", &ids.do214 }, { "TO-220", &ids.dTo220 } }, result)
+        && resolveAll(diodePolarities, { { "Anode-Cathode", &ids.anodeCathode },
+                                         { "Cathode-Anode", &ids.cathodeAnode } }, result)
+        && resolveAll(fuseTypes, { { "Fast-blow", &ids.fastBlow }, { "Slow-blow", &ids.slowBlow },
+                                   { "Resettable (polyfuse)", &ids.resettable } }, result)
+        && resolveAll(fusePackages, { { "Axial", &ids.fAxial }, { "Radial", &ids.fRadial },
+                                      { "Cartridge", &ids.cartridge }, { "SMD", &ids.fSmd } }, result);
+}
+
+} // namespace
+
+bool DatasetGenerator::generate(const DatasetOptions& options, DatasetReport& report, DbResult& result)
+{
+    const auto started = std::chrono::steady_clock::now();
+    report = DatasetReport{};
+
+    const DatasetMix& mix = options.mix;
+    if (options.rows < 0 || mix.resistors < 0 || mix.capacitors < 0 || mix.transistors < 0
+        || mix.diodes < 0 || mix.fuses < 0
+        || mix.resistors + mix.capacitors + mix.transistors + mix.diodes + mix.fuses <= 0) {
+        result.setError(SQLITE_MISUSE, "Dataset needs a non-negative row count and a positive category mix");
+        return false;
+    }
+
+    Ids ids;
+    if (!resolveIds(db_, ids, result))
+        return false;
+
+    ComponentManager components(db_);
+    ResistorManager resistors(db_);
+    CapacitorManager capacitors(db_);
+    TransistorManager transistors(db_);
+    BJTManager bjts(db_);
+    DiodeManager diodes(db_);
+    FuseManager fuses(db_);
+
+    // Writes rows [begin, end) of a group inside the open batch. A group's
+    // rows go category by category, so a batch that ends mid-group leaves
+    // the IDs exactly as one covering the whole group would.
+    // Plain adds rather than the managers' addBatch: nested in the batch
+    // transaction, each addBatch would open a savepoint, and SQLite then
+    // journals every RETURNING insert (about 3x the cost per row).
+    auto writeRows = [&](Group& g, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            std::size_t i = k;
+            if (i < g.resistors.size()) {
+                if (!components.add(g.resistorComps[i], result))
+                    return false;
+                g.resistors[i].componentId = g.resistorComps[i].id;
+                if (!resistors.add(g.resistors[i], result))
+                    return false;
+                ++report.resistors;
+                continue;
+            }
+            i -= g.resistors.size();
+
+            if (i < g.capacitors.size()) {
+                if (!components.add(g.capacitorComps[i], result))
+                    return false;
+                g.capacitors[i].componentId = g.capacitorComps[i].id;
+                if (!capacitors.add(g.capacitors[i], result))
+                    return false;
+                ++report.capacitors;
+                continue;
+            }
+            i -= g.capacitors.size();
+
+            if (i < g.transistors.size()) {
+                if (!components.add(g.transistorComps[i], result))
+                    return false;
+                const int id = g.transistorComps[i].id;
+                g.transistors[i].componentId = id;
+                if (!transistors.add(g.transistors[i], result))
+                    return false;
+                if (g.bjts[i]) {
+                    g.bjts[i]->componentId = id;
+                    if (!bjts.add(*g.bjts[i], result))
+                        return false;
+                }
+                ++report.transistors;
+                continue;
+            }
+            i -= g.transistors.size();
+
+            if (i < g.diodes.size()) {
+                if (!components.add(g.diodeComps[i], result))
+                    return false;
+                g.diodes[i].componentId = g.diodeComps[i].id;
+                if (!diodes.add(g.diodes[i], result))
+                    return false;
+                ++report.diodes;
+                continue;
+            }
+            i -= g.diodes.size();
+
+            if (!components.add(g.fuseComps[i], result))
+                return false;
+            g.fuses[i].componentId = g.fuseComps[i].id;
+            if (!fuses.add(g.fuses[i], result))
+                return false;
+            ++report.fuses;
+        }
+        return true;
+    };
+
+    SchemaManager schema(db_);
+    if (options.deferSearchIndex && !schema.suspendSearchIndex(result))
+        return false;
+
+    RowFactory factory(ids, options.seed);
+    Group group;
+    std::size_t groupSize = 0;      // rows in group
+    std::size_t groupWritten = 0;   // of those, written so far
+    long long generated = 0;
+    const long long batchRows = options.batchRows > 0 ? options.batchRows : kGroupRows;
+    bool ok = true;
+
+    while (ok && report.rows < options.rows) {
+        Transaction batch(db_, result, Transaction::Mode::Immediate);
+        if (!batch.isActive()) {
+            ok = false;
+            break;
+        }
+
+        // Counts cover committed rows only
+        const DatasetReport committed = report;
+        long long inBatch = 0;
+        while (ok && inBatch < batchRows && report.rows < options.rows) {
+            // Groups are always kGroupRows, whatever the batch size, so
+            // the rows and their IDs depend only on seed, mix and count
+            if (groupWritten == groupSize) {
+                const long long n = std::min<long long>(kGroupRows, options.rows - generated);
+                group.clear();
+                for (long long i = 0; i < n; ++i)
+                    factory.add(mix, group);
+                generated += n;
+                groupSize = static_cast<std::size_t>(n);
+                groupWritten = 0;
+            }
+
+            const std::size_t n = static_cast<std::size_t>(std::min<long long>(
+                static_cast<long long>(groupSize - groupWritten), batchRows - inBatch));
+            ok = writeRows(group, groupWritten, groupWritten + n);
+            groupWritten += n;
+            inBatch += static_cast<long long>(n);
+            report.rows += static_cast<long long>(n);
+        }
+
+        if (ok && options.deferSearchIndex)
+            ok = schema.touchSearchIndexSuspension(result);
+
+        if (ok && batch.commit(result)) {
+            ++report.transactions;
+        }
+        else {
+            ok = false;
+            report = committed;
+        }
+    }
+
+    // Batches committed before a failure stay, so they get indexed too
+    if (options.deferSearchIndex) {
+        DbResult resumeResult;
+        if (!schema.resumeSearchIndex(resumeResult) && ok) {
+            result = resumeResult;
+            ok = false;
+        }
+    }
+
+    if (report.rows > 0) {
+        DbResult statsResult;
+        if (!schema.analyzePlannerStats(statsResult) && ok) {
+            result = statsResult;
+            ok = false;
+        }
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (ok)
+        result.clear();
+    return ok;
+}
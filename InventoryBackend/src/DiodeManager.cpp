@@ -11,8 +11,8 @@ bool DiodeManager::add(const Diode& d, DbResult& res) {
     const char* sql = "INSERT INTO Diodes "
         "(ComponentId, PackageId, TypeId, PolarityId, ForwardVoltage, MaxCurrent, MaxReverseVoltage, ReverseLeakage) "
         "VALUES (?,?,?,?,?,?,?,?);";
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, d.componentId);
     sqlite3_bind_int(stmt, 2, d.packageId);
@@ -25,15 +25,14 @@ bool DiodeManager::add(const Diode& d, DbResult& res) {
 
     bool ok = (sqlite3_step(stmt) == SQLITE_DONE);
     if (!ok) res.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-    sqlite3_finalize(stmt);
     return ok;
 }
 
 bool DiodeManager::getById(int componentId, Diode& d, DbResult& res) {
     const char* sql = "SELECT ComponentId, PackageId, TypeId, PolarityId, ForwardVoltage, MaxCurrent, MaxReverseVoltage, ReverseLeakage "
         "FROM Diodes WHERE ComponentId=?;";
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, componentId);
     int rc = sqlite3_step(stmt);
@@ -46,11 +45,9 @@ bool DiodeManager::getById(int componentId, Diode& d, DbResult& res) {
         d.maxCurrent = sqlite3_column_double(stmt, 5);
         d.maxReverseVoltage = sqlite3_column_double(stmt, 6);
         d.reverseLeakage = sqlite3_column_double(stmt, 7);
-        sqlite3_finalize(stmt);
         return true;
     }
 
-    sqlite3_finalize(stmt);
     return false;
 }
 
@@ -58,8 +55,8 @@ bool DiodeManager::update(const Diode& d, DbResult& res) {
     const char* sql = "UPDATE Diodes SET "
         "PackageId=?, TypeId=?, PolarityId=?, ForwardVoltage=?, MaxCurrent=?, MaxReverseVoltage=?, ReverseLeakage=? "
         "WHERE ComponentId=?;";
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, d.packageId);
     sqlite3_bind_int(stmt, 2, d.typeId);
@@ -72,41 +69,47 @@ bool DiodeManager::update(const Diode& d, DbResult& res) {
 
     bool ok = (sqlite3_step(stmt) == SQLITE_DONE);
     if (!ok) res.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-    sqlite3_finalize(stmt);
     return ok;
 }
 
 bool DiodeManager::remove(int componentId, DbResult& res) {
     const char* sql = "DELETE FROM Diodes WHERE ComponentId=?;";
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, componentId);
     bool ok = (sqlite3_step(stmt) == SQLITE_DONE);
     if (!ok) res.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-    sqlite3_finalize(stmt);
     return ok;
 }
 
 bool DiodeManager::list(std::vector<Diode>& ds, DbResult& res) {
-    const char* sql = "SELECT ComponentId, PackageId, TypeId, PolarityId, ForwardVoltage, MaxCurrent, MaxReverseVoltage, ReverseLeakage "
-        "FROM Diodes;";
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
-
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Diode d;
-        d.componentId = sqlite3_column_int(stmt, 0);
-        d.packageId = sqlite3_column_int(stmt, 1);
-        d.typeId = sqlite3_column_int(stmt, 2);
-        d.polarityId = sqlite3_column_int(stmt, 3);
-        d.forwardVoltage = sqlite3_column_double(stmt, 4);
-        d.maxCurrent = sqlite3_column_double(stmt, 5);
-        d.maxReverseVoltage = sqlite3_column_double(stmt, 6);
-        d.reverseLeakage = sqlite3_column_double(stmt, 7);
+    return forEach([&](const Diode& d) {
         ds.push_back(d);
-    }
+        return true;
+    }, res);
+}
+
+bool DiodeManager::forEach(const std::function<bool(const Diode&)>& fn, DbResult& res) {
+    const char* sql = "SELECT ComponentId, PackageId, TypeId, PolarityId, ForwardVoltage, MaxCurrent, MaxReverseVoltage, ReverseLeakage "
+        "FROM Diodes ORDER BY ComponentId;";
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
+
+    Diode d;
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        d.componentId = sqlite3_column_int(row, 0);
+        d.packageId = sqlite3_column_int(row, 1);
+        d.typeId = sqlite3_column_int(row, 2);
+        d.polarityId = sqlite3_column_int(row, 3);
+        d.forwardVoltage = sqlite3_column_double(row, 4);
+        d.maxCurrent = sqlite3_column_double(row, 5);
+        d.maxReverseVoltage = sqlite3_column_double(row, 6);
+        d.reverseLeakage = sqlite3_column_double(row, 7);
+        return fn(d);
+    }, res);
+}
 
-    sqlite3_finalize(stmt);
-    return true;
+bool DiodeManager::find(const DiodeQuery& query, std::vector<int>& componentIds, DbResult& res) {
+    return query.run(db_, componentIds, res);
 }
@@ -11,8 +11,8 @@ bool FuseManager::add(const Fuse& fuse, DbResult& res) {
         "(ComponentId, PackageId, TypeId, CurrentRating, VoltageRating) "
         "VALUES (?,?,?,?,?);";
 
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, fuse.componentId);
     sqlite3_bind_int(stmt, 2, fuse.packageId);
@@ -25,7 +25,6 @@ bool FuseManager::add(const Fuse& fuse, DbResult& res) {
         res.setError(sqlite3_errcode(db_.handle()),
             sqlite3_errmsg(db_.handle()));
 
-    sqlite3_finalize(stmt);
     return ok;
 }
 
@@ -34,8 +33,8 @@ bool FuseManager::getById(int componentId, Fuse& fuse, DbResult& res) {
         "SELECT ComponentId, PackageId, TypeId, CurrentRating, VoltageRating "
         "FROM Fuses WHERE ComponentId=?;";
 
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, componentId);
 
@@ -45,11 +44,9 @@ bool FuseManager::getById(int componentId, Fuse& fuse, DbResult& res) {
         fuse.typeId = sqlite3_column_int(stmt, 2);
         fuse.currentRating = sqlite3_column_double(stmt, 3);
         fuse.voltageRating = sqlite3_column_double(stmt, 4);
-        sqlite3_finalize(stmt);
         return true;
     }
 
-    sqlite3_finalize(stmt);
     return false;
 }
 
@@ -59,8 +56,8 @@ bool FuseManager::update(const Fuse& fuse, DbResult& res) {
         "PackageId=?, TypeId=?, CurrentRating=?, VoltageRating=? "
         "WHERE ComponentId=?;";
 
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, fuse.packageId);
     sqlite3_bind_int(stmt, 2, fuse.typeId);
@@ -73,15 +70,14 @@ bool FuseManager::update(const Fuse& fuse, DbResult& res) {
         res.setError(sqlite3_errcode(db_.handle()),
             sqlite3_errmsg(db_.handle()));
 
-    sqlite3_finalize(stmt);
     return ok;
 }
 
 bool FuseManager::remove(int componentId, DbResult& res) {
     const char* sql = "DELETE FROM Fuses WHERE ComponentId=?;";
 
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
 
     sqlite3_bind_int(stmt, 1, componentId);
 
@@ -90,28 +86,35 @@ bool FuseManager::remove(int componentId, DbResult& res) {
         res.setError(sqlite3_errcode(db_.handle()),
             sqlite3_errmsg(db_.handle()));
 
-    sqlite3_finalize(stmt);
     return ok;
 }
 
 bool FuseManager::list(std::vector<Fuse>& fuses, DbResult& res) {
+    return forEach([&](const Fuse& f) {
+        fuses.push_back(f);
+        return true;
+    }, res);
+}
+
+bool FuseManager::forEach(const std::function<bool(const Fuse&)>& fn, DbResult& res) {
     const char* sql =
         "SELECT ComponentId, PackageId, TypeId, CurrentRating, VoltageRating "
-        "FROM Fuses;";
-
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql, stmt, res)) return false;
-
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Fuse f;
-        f.componentId = sqlite3_column_int(stmt, 0);
-        f.packageId = sqlite3_column_int(stmt, 1);
-        f.typeId = sqlite3_column_int(stmt, 2);
-        f.currentRating = sqlite3_column_double(stmt, 3);
-        f.voltageRating = sqlite3_column_double(stmt, 4);
-        fuses.push_back(f);
-    }
+        "FROM Fuses ORDER BY ComponentId;";
+
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, res)) return false;
+
+    Fuse f;
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        f.componentId = sqlite3_column_int(row, 0);
+        f.packageId = sqlite3_column_int(row, 1);
+        f.typeId = sqlite3_column_int(row, 2);
+        f.currentRating = sqlite3_column_double(row, 3);
+        f.voltageRating = sqlite3_column_double(row, 4);
+        return fn(f);
+    }, res);
+}
 
-    sqlite3_finalize(stmt);
-    return true;
+bool FuseManager::find(const FuseQuery& query, std::vector<int>& componentIds, DbResult& res) {
+    return query.run(db_, componentIds, res);
 }
@@ -5,11 +5,34 @@
 #include "ComponentManager.h"
 #include "DbResult.h"
 
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+// Paths another connection can open to reach the same database
+bool isSharedFile(const std::string& path)
+{
+    return !path.empty() && path != ":memory:"
+        && path.rfind("file::memory:", 0) != 0
+        && path.find("mode=memory") == std::string::npos;
+}
+
+int defaultReaderCount()
+{
+    const int hw = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(2, hw);
+}
+
+} // namespace
+
 // ---- Construction ----
 
-InventoryService::InventoryService(std::unique_ptr<Database> db)
+InventoryService::InventoryService(std::unique_ptr<Database> db, const std::string& path)
     : db_(std::move(db))
+    , path_(path)
     , componentMgr_(*db_)
+    , componentDetailsMgr_(*db_)
     , categoryMgr_(*db_)
     , manufacturerMgr_(*db_)
     , resistorMgr_(*db_)
@@ -18,7 +41,93 @@ InventoryService::InventoryService(std::unique_ptr<Database> db)
 	, capacitorManager_(*db_)
 	, capacitorPackageMgr_(*db_)
 	, capacitorDielectricMgr_(*db_)
+    , stockLedger_(*db_)
+    , statsMgr_(*db_)
+{
+    if (isSharedFile(path_))
+        configureReaders(defaultReaderCount(), DatabaseOptions::readOnlyReporting());
+}
+
+InventoryService::~InventoryService()
+{
+    // Statistics the session's queries found stale are refreshed for the
+    // next one. Nothing to report to at this point, so errors are dropped.
+    if (!db_->isReadOnly()) {
+        DbResult result;
+        SchemaManager(*db_).optimizePlannerStats(result);
+    }
+}
+
+// ---- Transactions ----
+
+Transaction InventoryService::transaction(DbResult& result, Transaction::Mode mode)
 {
+    return Transaction(*db_, result, mode);
+}
+
+// ---- Readers ----
+
+bool InventoryService::readSession(ReadSession& session, DbResult& result)
+{
+    if (!readers_) {
+        session.release();
+        result.setError(SQLITE_MISUSE, "In-memory database has no read connections");
+        return false;
+    }
+    return readers_->acquire(session, result);
+}
+
+void InventoryService::configureReaders(int maxReaders, const DatabaseOptions& options)
+{
+    if (!isSharedFile(path_))
+        return;
+
+    DatabaseOptions readerOptions = options;
+    readerOptions.readOnly = true;
+    readers_ = std::make_shared<ReaderPool>(path_, maxReaders, readerOptions);
+    if (isProfiling())
+        readers_->setProfiler(profiler_);
+}
+
+// ---- Backup ----
+
+std::future<DbResult> InventoryService::backupTo(const std::string& path,
+    BackupProgressFn progress, BackupOptions options)
+{
+    if (!isSharedFile(path_)) {
+        std::promise<DbResult> failed;
+        DbResult result;
+        result.setError(SQLITE_MISUSE, "In-memory database cannot be backed up");
+        failed.set_value(result);
+        return failed.get_future();
+    }
+
+    return std::async(std::launch::async,
+        [source = path_, path, progress = std::move(progress), options = std::move(options)] {
+            DbResult result;
+            DatabaseBackup::copy(source, path, options, progress, result);
+            return result;
+        });
+}
+
+// ---- Planner statistics ----
+
+bool InventoryService::analyzePlannerStats(DbResult& result)
+{
+    return SchemaManager(*db_).analyzePlannerStats(result);
+}
+
+// ---- Profiling ----
+
+void InventoryService::setProfiling(bool enabled)
+{
+    if (enabled && !profiler_)
+        profiler_ = std::make_shared<QueryProfiler>();
+
+    std::shared_ptr<QueryProfiler> attached = enabled ? profiler_ : nullptr;
+    db_->setProfiler(attached);
+    if (readers_)
+        readers_->setProfiler(attached);
 }
 
 // ---- Factory methods ----
@@ -26,7 +135,13 @@ InventoryService::InventoryService(std::unique_ptr<Database> db)
 std::unique_ptr<InventoryService>
 InventoryService::open(const std::string& path, DbResult& result)
 {
-    return openInternal(path, result);
+    return openInternal(path, DatabaseOptions{}, result);
+}
+
+std::unique_ptr<InventoryService>
+InventoryService::open(const std::string& path, const DatabaseOptions& options, DbResult& result)
+{
+    return openInternal(path, options, result);
 }
 
 std::unique_ptr<InventoryService>
@@ -37,21 +152,44 @@ InventoryService::create(const std::string& path, DbResult& result)
     // - delete existing file
     // - call schema.createFresh()
 
-    return openInternal(path, result);
+    return openInternal(path, DatabaseOptions{}, result);
 }
 
 std::unique_ptr<InventoryService>
-InventoryService::openInternal(const std::string& path, DbResult& result)
+InventoryService::openInternal(const std::string& path, const DatabaseOptions& options,
+    DbResult& result)
 {
-    auto db = std::make_unique<Database>(path, result);
+    auto db = std::make_unique<Database>(path, options, result);
     if (!db->isOpen())
         return nullptr;
 
-    SchemaManager schema(*db);
-    if (!schema.initialize(result))
-        return nullptr;
+    if (db->isReadOnly()) {
+        // Cannot migrate a read-only connection; require an existing schema
+        if (!db->tableExists("SchemaVersion")) {
+            result.setError(SQLITE_CANTOPEN, "Read-only database has no inventory schema");
+            return nullptr;
+        }
+    }
+    else {
+        SchemaManager schema(*db);
+        if (db->tableExists("SchemaVersion")) {
+            // A bulk load that crashed may have left search unindexed
+            if (!schema.initialize(result) || !schema.recoverSearchIndex(result))
+                return nullptr;
+        }
+        else {
+            // New file: schema and seeded statistics in one commit.
+            // initialize() cannot switch foreign keys on once inside it.
+            if (!db->exec("PRAGMA foreign_keys = ON;", result))
+                return nullptr;
+            Transaction tx(*db, result, Transaction::Mode::Immediate);
+            if (!tx.isActive() || !schema.initialize(result)
+                || !schema.seedPlannerStats(result) || !tx.commit(result))
+                return nullptr;
+        }
+    }
 
     return std::unique_ptr<InventoryService>(
-        new InventoryService(std::move(db))
+        new InventoryService(std::move(db), path)
     );
 }
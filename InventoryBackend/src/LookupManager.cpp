@@ -10,27 +10,71 @@ LookupManager::LookupManager(Database& db, const char* tableName)
 {
 }
 
-bool LookupManager::listLookup(std::vector<LookupItem>& items, DbResult& result)
+bool LookupManager::ensureCache(DbResult& result)
 {
-    result.clear();
-    items.clear();
+    // Already checked against this transaction's snapshot
+    const unsigned long long snapshot = db_.snapshotSerial();
+    if (cache_.loaded
+        && snapshot != 0
+        && cache_.snapshot == snapshot
+        && cache_.generation == db_.cacheGeneration())
+        return true;
+
+    long long version = 0;
+    if (!db_.dataVersion(version, result))
+        return false;
+
+    if (cache_.loaded
+        && cache_.dataVersion == version
+        && cache_.generation == db_.cacheGeneration()) {
+        cache_.snapshot = db_.snapshotSerial();
+        return true;
+    }
+
+    cache_.loaded = false;
+    cache_.items.clear();
+    cache_.indexById.clear();
+    cache_.idByFoldedName.clear();
 
     std::string sql = std::string("SELECT ID, Name FROM ") + tableName_ + " ORDER BY Name;";
 
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql.c_str(), stmt, result))
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, result))
         return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    bool ok = db_.stepRows(stmt, [&](sqlite3_stmt* row) {
         LookupItem item;
-        item.id = sqlite3_column_int(stmt, 0);
-        const unsigned char* txt = sqlite3_column_text(stmt, 1);
-        item.name = txt ? reinterpret_cast<const char*>(txt) : std::string();
-        items.push_back(std::move(item));
-    }
+        item.id = sqlite3_column_int(row, 0);
+        item.name = safeColumnText(row, 1);
+        cache_.indexById.emplace(item.id, cache_.items.size());
+        cache_.idByFoldedName.emplace(foldNoCase(item.name), item.id);
+        cache_.items.push_back(std::move(item));
+        return true;
+    }, result);
+    if (!ok)
+        return false;
+
+    cache_.loaded = true;
+    cache_.dataVersion = version;
+    cache_.generation = db_.cacheGeneration();
+    cache_.snapshot = db_.snapshotSerial();
+    return true;
+}
 
-    db_.finalize(stmt);
+void LookupManager::invalidateCache()
+{
+    db_.invalidateCaches();
+}
+
+bool LookupManager::listLookup(std::vector<LookupItem>& items, DbResult& result)
+{
     result.clear();
+    items.clear();
+
+    if (!ensureCache(result))
+        return false;
+
+    items = cache_.items;
     return true;
 }
 
@@ -38,21 +82,28 @@ int LookupManager::getIdByName(const std::string& name, DbResult& result)
 {
     result.clear();
 
-    std::string sql = std::string("SELECT ID FROM ") + tableName_ + " WHERE Name = ? LIMIT 1;";
-
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql.c_str(), stmt, result))
+    if (!ensureCache(result))
         return -1;
 
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+    auto it = cache_.idByFoldedName.find(foldNoCase(name));
+    return it != cache_.idByFoldedName.end() ? it->second : -1;
+}
 
-    int id = -1;
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-        id = sqlite3_column_int(stmt, 0);
+bool LookupManager::getNameById(int id, std::string& name, DbResult& result)
+{
+    result.clear();
+
+    if (!ensureCache(result))
+        return false;
+
+    auto it = cache_.indexById.find(id);
+    if (it == cache_.indexById.end()) {
+        result.setError(SQLITE_NOTFOUND, "Lookup entry not found");
+        return false;
     }
 
-    db_.finalize(stmt);
-    return id;
+    name = cache_.items[it->second].name;
+    return true;
 }
 
 bool LookupManager::addByName(const std::string& rawName, DbResult& result)
@@ -81,8 +132,8 @@ bool LookupManager::addByName(const std::string& rawName, DbResult& result)
 
     // Insert directly into the lookup table
     std::string sql = std::string("INSERT INTO ") + tableName_ + " (Name) VALUES (?);";
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(sql.c_str(), stmt, result))
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, result))
         return false;
 
     sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
@@ -91,7 +142,6 @@ bool LookupManager::addByName(const std::string& rawName, DbResult& result)
     if (rc != SQLITE_DONE) {
         // Map unique constraint to AlreadyExists, otherwise surface DB error
         int err = sqlite3_extended_errcode(db_.handle()); // full extended code
-        db_.finalize(stmt);
 
         if (err == SQLITE_CONSTRAINT || err == SQLITE_CONSTRAINT_UNIQUE) {
             result.setError(
@@ -105,7 +155,7 @@ bool LookupManager::addByName(const std::string& rawName, DbResult& result)
         return false;
     }
 
-    db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -21,6 +21,7 @@ bool ManufacturerManager::add(const Manufacturer& man, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -71,6 +72,7 @@ bool ManufacturerManager::update(const Manufacturer& man, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -91,6 +93,7 @@ bool ManufacturerManager::remove(int id, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
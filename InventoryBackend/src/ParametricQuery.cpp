@@ -0,0 +1,167 @@
+#include "ParametricQuery.h"
+#include <sqlite3.h>
+
+// ---- Field mapping ----
+
+ParametricColumn parametricColumn(ResistorField field)
+{
+    switch (field) {
+    case ResistorField::Resistance:    return { "Resistance", nullptr };
+    case ResistorField::Tolerance:     return { "Tolerance", nullptr };
+    case ResistorField::PowerRating:   return { "PowerRating", nullptr };
+    case ResistorField::VoltageRating: return { "VoltageRating", nullptr };
+    case ResistorField::LeadSpacing:   return { "LeadSpacing", nullptr };
+    case ResistorField::Package:       return { "PackageTypeID", "ResistorPackage" };
+    case ResistorField::Composition:   return { "CompositionID", "ResistorComposition" };
+    }
+    return { nullptr, nullptr };
+}
+
+ParametricColumn parametricColumn(CapacitorField field)
+{
+    switch (field) {
+    case CapacitorField::Capacitance:    return { "Capacitance", nullptr };
+    case CapacitorField::VoltageRating:  return { "VoltageRating", nullptr };
+    case CapacitorField::Tolerance:      return { "Tolerance", nullptr };
+    case CapacitorField::Esr:            return { "ESR", nullptr };
+    case CapacitorField::LeakageCurrent: return { "LeakageCurrent", nullptr };
+    case CapacitorField::Package:        return { "PackageTypeID", "CapacitorPackage" };
+    case CapacitorField::Dielectric:     return { "DielectricTypeID", "CapacitorDielectric" };
+    }
+    return { nullptr, nullptr };
+}
+
+ParametricColumn parametricColumn(DiodeField field)
+{
+    switch (field) {
+    case DiodeField::ForwardVoltage:    return { "ForwardVoltage", nullptr };
+    case DiodeField::MaxCurrent:        return { "MaxCurrent", nullptr };
+    case DiodeField::MaxReverseVoltage: return { "MaxReverseVoltage", nullptr };
+    case DiodeField::ReverseLeakage:    return { "ReverseLeakage", nullptr };
+    case DiodeField::Package:           return { "PackageId", "DiodePackage" };
+    case DiodeField::Type:              return { "TypeId", "DiodeType" };
+    case DiodeField::Polarity:          return { "PolarityId", "DiodePolarity" };
+    }
+    return { nullptr, nullptr };
+}
+
+ParametricColumn parametricColumn(FuseField field)
+{
+    switch (field) {
+    case FuseField::CurrentRating: return { "CurrentRating", nullptr };
+    case FuseField::VoltageRating: return { "VoltageRating", nullptr };
+    case FuseField::Package:       return { "PackageId", "FusePackage" };
+    case FuseField::Type:          return { "TypeId", "FuseType" };
+    }
+    return { nullptr, nullptr };
+}
+
+ParametricColumn parametricColumn(BJTField field)
+{
+    switch (field) {
+    case BJTField::VceMax: return { "VceMax", nullptr };
+    case BJTField::IcMax:  return { "IcMax", nullptr };
+    case BJTField::PdMax:  return { "PdMax", nullptr };
+    case BJTField::Hfe:    return { "Hfe", nullptr };
+    case BJTField::Ft:     return { "Ft", nullptr };
+    }
+    return { nullptr, nullptr };
+}
+
+const char* parametricTable(ResistorField) { return "Resistors"; }
+const char* parametricTable(CapacitorField) { return "Capacitors"; }
+const char* parametricTable(DiodeField) { return "Diodes"; }
+const char* parametricTable(FuseField) { return "Fuses"; }
+const char* parametricTable(BJTField) { return "BJTs"; }
+
+// ---- Predicates ----
+
+void ParametricQueryBase::addBound(ParametricColumn col, const char* op, double value)
+{
+    if (!col.column || col.lookupTable) {
+        if (error_.empty())
+            error_ = "Range bound on a lookup field";
+        return;
+    }
+    predicates_.push_back({ std::string(col.column) + " " + op + " ?",
+        Predicate::Kind::Real, value, 0, {} });
+}
+
+void ParametricQueryBase::addLookupId(ParametricColumn col, int id)
+{
+    if (!col.column || !col.lookupTable) {
+        if (error_.empty())
+            error_ = "Lookup match on a numeric field";
+        return;
+    }
+    predicates_.push_back({ std::string(col.column) + " = ?",
+        Predicate::Kind::Integer, 0.0, id, {} });
+}
+
+void ParametricQueryBase::addLookupName(ParametricColumn col, const std::string& name)
+{
+    if (!col.column || !col.lookupTable) {
+        if (error_.empty())
+            error_ = "Lookup match on a numeric field";
+        return;
+    }
+    // Resolved by SQLite once per execution; Name is UNIQUE so this is an
+    // index probe and the outer predicate stays an equality.
+    predicates_.push_back({ std::string(col.column) + " = (SELECT ID FROM "
+        + col.lookupTable + " WHERE Name = ?)", Predicate::Kind::Text, 0.0, 0, name });
+}
+
+// ---- Compile and run ----
+
+std::string ParametricQueryBase::sql() const
+{
+    std::string sql = "SELECT ComponentID FROM ";
+    sql += table_;
+
+    for (std::size_t i = 0; i < predicates_.size(); ++i) {
+        sql += (i == 0) ? " WHERE " : " AND ";
+        sql += predicates_[i].sql;
+    }
+
+    if (limit_ > 0)
+        sql += " LIMIT " + std::to_string(limit_);
+
+    sql += ";";
+    return sql;
+}
+
+bool ParametricQueryBase::run(Database& db, std::vector<int>& componentIds, DbResult& result) const
+{
+    componentIds.clear();
+
+    if (!error_.empty()) {
+        result.setError(SQLITE_MISUSE, error_);
+        return false;
+    }
+
+    // The SQL text depends only on which predicates are set, so repeated
+    // searches of the same shape reuse one cached statement.
+    CachedStatement stmt;
+    if (!db.prepareCached(sql(), stmt, result))
+        return false;
+
+    int index = 1;
+    for (const Predicate& p : predicates_) {
+        switch (p.kind) {
+        case Predicate::Kind::Real:
+            sqlite3_bind_double(stmt, index++, p.real);
+            break;
+        case Predicate::Kind::Integer:
+            sqlite3_bind_int(stmt, index++, p.integer);
+            break;
+        case Predicate::Kind::Text:
+            sqlite3_bind_text(stmt, index++, p.text.c_str(), -1, SQLITE_TRANSIENT);
+            break;
+        }
+    }
+
+    return db.stepRows(stmt, [&](sqlite3_stmt* row) {
+        componentIds.push_back(sqlite3_column_int(row, 0));
+        return true;
+    }, result);
+}
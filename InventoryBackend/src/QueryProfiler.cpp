@@ -0,0 +1,120 @@
+#include "QueryProfiler.h"
+#include "DbUtils.h"
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string_view>
+
+void QueryProfiler::record(const char* sql, std::int64_t nanoseconds, long long rows,
+    long long fullScanSteps, long long sorts, long long autoIndexes, long long vmSteps)
+{
+    const double micros = static_cast<double>(nanoseconds) / 1000.0;
+    const int bucket = micros < 1.0
+        ? 0
+        : std::min(kBuckets - 1, static_cast<int>(std::log2(micros) * 8.0));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& e = entries_[sql ? sql : ""];
+    ++e.calls;
+    e.rows += rows;
+    e.totalNs += nanoseconds;
+    e.maxNs = std::max(e.maxNs, nanoseconds);
+    e.fullScanSteps += fullScanSteps;
+    e.sorts += sorts;
+    e.autoIndexes += autoIndexes;
+    e.vmSteps += vmSteps;
+    ++e.histogram[bucket];
+}
+
+double QueryProfiler::percentileMs(const Entry& entry, double fraction)
+{
+    const long long rank = std::max(1LL, static_cast<long long>(std::ceil(fraction * entry.calls)));
+    long long seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += entry.histogram[b];
+        if (seen >= rank) {
+            // Geometric middle of the bucket, never above the largest run
+            const double micros = b == 0 ? 0.5 : std::exp2((b + 0.5) / 8.0);
+            return std::min(micros / 1000.0, static_cast<double>(entry.maxNs) / 1e6);
+        }
+    }
+    return static_cast<double>(entry.maxNs) / 1e6;
+}
+
+std::vector<QueryStats> QueryProfiler::snapshot() const
+{
+    std::vector<QueryStats> stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.reserve(entries_.size());
+        for (const auto& [sql, e] : entries_) {
+            QueryStats s;
+            s.sql = sql;
+            s.calls = e.calls;
+            s.rows = e.rows;
+            s.totalMs = static_cast<double>(e.totalNs) / 1e6;
+            s.p50Ms = percentileMs(e, 0.50);
+            s.p99Ms = percentileMs(e, 0.99);
+            s.maxMs = static_cast<double>(e.maxNs) / 1e6;
+            s.fullScanSteps = e.fullScanSteps;
+            s.sorts = e.sorts;
+            s.autoIndexes = e.autoIndexes;
+            s.vmSteps = e.vmSteps;
+            stats.push_back(std::move(s));
+        }
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const QueryStats& a, const QueryStats& b) {
+        return a.totalMs != b.totalMs ? a.totalMs > b.totalMs : a.sql < b.sql;
+    });
+    return stats;
+}
+
+void QueryProfiler::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+void QueryProfiler::writeJson(std::ostream& out, const std::vector<QueryStats>& stats)
+{
+    out << "{\"queries\": [";
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const QueryStats& s = stats[i];
+        std::string sql;
+        appendJsonString(sql, s.sql);
+        out << (i ? ",\n  " : "\n  ") << "{\"sql\": " << sql
+            << ", \"calls\": " << s.calls
+            << ", \"rows\": " << s.rows
+            << ", \"total_ms\": " << s.totalMs
+            << ", \"mean_ms\": " << s.meanMs()
+            << ", \"p50_ms\": " << s.p50Ms
+            << ", \"p99_ms\": " << s.p99Ms
+            << ", \"max_ms\": " << s.maxMs
+            << ", \"fullscan_steps\": " << s.fullScanSteps
+            << ", \"sorts\": " << s.sorts
+            << ", \"autoindexes\": " << s.autoIndexes
+            << ", \"vm_steps\": " << s.vmSteps << "}";
+    }
+    out << (stats.empty() ? "]}\n" : "\n]}\n");
+}
+
+bool QueryProfiler::writeJsonFile(const std::string& path, DbResult& result) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        result.setError(SQLITE_CANTOPEN, "Cannot create " + path);
+        return false;
+    }
+
+    writeJson(out, snapshot());
+    out.flush();
+    if (!out) {
+        result.setError(SQLITE_IOERR, "Failed to write " + path);
+        return false;
+    }
+    result.clear();
+    return true;
+}
@@ -0,0 +1,155 @@
+#include "ReaderPool.h"
+#include <sqlite3.h>
+
+#include <utility>
+
+// ---- ReadConnection ----
+
+ReadConnection::ReadConnection(const std::string& path, const DatabaseOptions& options,
+    DbResult& result)
+    : db_(path, options, result)
+    , componentMgr_(db_)
+    , componentDetailsMgr_(db_)
+    , categoryMgr_(db_)
+    , manufacturerMgr_(db_)
+    , resistorMgr_(db_)
+    , resistorPackageMgr_(db_)
+    , resistorCompositionMgr_(db_)
+    , capacitorMgr_(db_)
+    , capacitorPackageMgr_(db_)
+    , capacitorDielectricMgr_(db_)
+    , statsMgr_(db_)
+{
+}
+
+// ---- ReadSession ----
+
+ReadSession::~ReadSession()
+{
+    release();
+}
+
+ReadSession::ReadSession(ReadSession&& other) noexcept
+    : pool_(std::move(other.pool_))
+    , conn_(std::exchange(other.conn_, nullptr))
+{
+}
+
+ReadSession& ReadSession::operator=(ReadSession&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        pool_ = std::move(other.pool_);
+        conn_ = std::exchange(other.conn_, nullptr);
+    }
+    return *this;
+}
+
+void ReadSession::release()
+{
+    if (pool_ && conn_)
+        pool_->release(conn_);
+    conn_ = nullptr;
+    pool_.reset();   // may destroy the pool if the service let it go
+}
+
+// ---- ReaderPool ----
+
+ReaderPool::ReaderPool(std::string path, int maxReaders, const DatabaseOptions& options)
+    : path_(std::move(path))
+    , maxReaders_(maxReaders > 0 ? maxReaders : 1)
+    , options_(options)
+{
+}
+
+bool ReaderPool::acquire(ReadSession& session, DbResult& result)
+{
+    return acquireImpl(session, true, result);
+}
+
+bool ReaderPool::tryAcquire(ReadSession& session, DbResult& result)
+{
+    return acquireImpl(session, false, result);
+}
+
+int ReaderPool::openConnections() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(connections_.size());
+}
+
+bool ReaderPool::acquireImpl(ReadSession& session, bool wait, DbResult& result)
+{
+    session.release();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto canProceed = [&] {
+        return !idle_.empty()
+            || static_cast<int>(connections_.size()) + opening_ < maxReaders_;
+    };
+
+    if (!canProceed()) {
+        if (!wait) {
+            result.setError(SQLITE_BUSY, "All pooled read connections are in use");
+            return false;
+        }
+        returned_.wait(lock, canProceed);
+    }
+
+    if (!idle_.empty()) {
+        ReadConnection* conn = idle_.back();
+        idle_.pop_back();
+        attachProfiler(*conn, profiler_);
+        session = ReadSession(shared_from_this(), conn);
+        result.clear();
+        return true;
+    }
+
+    // Open outside the lock: it touches the file and should not hold up
+    // threads returning or borrowing other connections.
+    ++opening_;
+    lock.unlock();
+
+    auto conn = std::make_unique<ReadConnection>(path_, options_, result);
+    bool ok = conn->isOpen();
+    if (ok && !conn->database().tableExists("SchemaVersion")) {
+        result.setError(SQLITE_CANTOPEN, "Read connection sees no inventory schema");
+        ok = false;
+    }
+
+    lock.lock();
+    --opening_;
+    if (!ok) {
+        lock.unlock();
+        returned_.notify_one();   // the reserved slot is free again
+        return false;
+    }
+
+    attachProfiler(*conn, profiler_);
+    session = ReadSession(shared_from_this(), conn.get());
+    connections_.push_back(std::move(conn));
+    result.clear();
+    return true;
+}
+
+void ReaderPool::setProfiler(std::shared_ptr<QueryProfiler> profiler)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    profiler_ = std::move(profiler);
+}
+
+// Called on a connection no other thread holds
+void ReaderPool::attachProfiler(ReadConnection& conn, const std::shared_ptr<QueryProfiler>& profiler)
+{
+    if (conn.database().profiler() != profiler.get())
+        conn.database().setProfiler(profiler);
+}
+
+void ReaderPool::release(ReadConnection* conn)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(conn);
+    }
+    returned_.notify_one();
+}
@@ -16,6 +16,7 @@ bool ResistorCompositionManager::add(const ResistorComposition& comp, DbResult&
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -57,6 +58,7 @@ bool ResistorCompositionManager::update(const ResistorComposition& comp, DbResul
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -75,38 +77,25 @@ bool ResistorCompositionManager::remove(int id, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
 
 bool ResistorCompositionManager::list(std::vector<ResistorComposition>& comps, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID, Name FROM ResistorComposition;", stmt, result))
+    std::vector<LookupItem> items;
+    if (!listLookup(items, result))
         return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    for (const LookupItem& item : items) {
         ResistorComposition comp;
-        comp.id = sqlite3_column_int(stmt, 0);
-        comp.name = safeColumnText(stmt, 1);
+        comp.id = item.id;
+        comp.name = item.name;
         comps.push_back(comp);
     }
-
-    db_.finalize(stmt);
-    result.clear();
     return true;
 }
 
 int ResistorCompositionManager::getByName(const std::string& name, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID FROM ResistorComposition WHERE Name=?;", stmt, result))
-        return -1;
-
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-
-    int id = -1;
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-        id = sqlite3_column_int(stmt, 0);
-
-    sqlite3_finalize(stmt);
-    return id;
+    return getIdByName(name, result);
 }
@@ -1,21 +1,19 @@
 #include "ResistorManager.h"
 #include "DbUtils.h"
+#include "Transaction.h"
 #include <sqlite3.h>
 
-// Add resistor
-bool ResistorManager::add(const Resistor& r, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    const char* sql =
-        "INSERT INTO Resistors ("
-        "ComponentID, Resistance, Tolerance, PowerRating, "
-        "TempCoeffMin, TempCoeffMax, "
-        "TempMin, TempMax, "
-        "PackageTypeID, CompositionID, LeadSpacing, VoltageRating"
-        ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+namespace {
 
-    if (!db_.prepare(sql, stmt, result))
-        return false;
+const char* const kInsertResistorSql =
+    "INSERT INTO Resistors ("
+    "ComponentID, Resistance, Tolerance, PowerRating, "
+    "TempCoeffMin, TempCoeffMax, "
+    "TempMin, TempMax, "
+    "PackageTypeID, CompositionID, LeadSpacing, VoltageRating"
+    ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
+void bindResistorInsert(sqlite3_stmt* stmt, const Resistor& r) {
     int idx = 1;
     sqlite3_bind_int(stmt, idx++, r.componentId);
     sqlite3_bind_double(stmt, idx++, r.resistance);
@@ -42,25 +40,103 @@ bool ResistorManager::add(const Resistor& r, DbResult& result) {
         sqlite3_bind_null(stmt, idx++);
     }
 
-    sqlite3_bind_int(stmt, idx++, r.packageTypeId);
-    sqlite3_bind_int(stmt, idx++, r.compositionId);
+    bindOptionalId(stmt, idx++, r.packageTypeId);
+    bindOptionalId(stmt, idx++, r.compositionId);
     sqlite3_bind_double(stmt, idx++, r.leadSpacing);
     sqlite3_bind_double(stmt, idx++, r.voltageRating);
+}
+
+} // namespace
+
+// Add resistor
+bool ResistorManager::add(const Resistor& r, DbResult& result) {
+    CachedStatement stmt;
+    if (!db_.prepareCached(kInsertResistorSql, stmt, result))
+        return false;
+
+    return insert(stmt, r, result);
+}
+
+// Add many resistor rows in one transaction
+bool ResistorManager::addBatch(std::span<const Resistor> resistors, DbResult& result) {
+    if (resistors.empty()) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result);
+    if (!tx.isActive())
+        return false;
+
+    CachedStatement stmt;
+    bool ok = db_.prepareCached(kInsertResistorSql, stmt, result);
+
+    for (std::size_t i = 0; ok && i < resistors.size(); ++i) {
+        ok = insert(stmt, resistors[i], result);
+        stmt.reset();
+    }
+    stmt.release();
+
+    if (!ok || !tx.commit(result))
+        return false;
+
+    result.clear();
+    return true;
+}
+
+// Add components together with their resistor rows in one transaction
+bool ResistorManager::addBatch(std::span<Component> comps, std::span<Resistor> resistors,
+    DbResult& result) {
+    if (comps.size() != resistors.size()) {
+        result.setError(SQLITE_MISUSE, "Component and resistor counts differ");
+        return false;
+    }
+    if (comps.empty()) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result);
+    if (!tx.isActive())
+        return false;
+
+    ComponentManager compMgr(db_);
+    CachedStatement stmt;
+    bool ok = db_.prepareCached(kInsertResistorSql, stmt, result);
+
+    for (std::size_t i = 0; ok && i < comps.size(); ++i) {
+        ok = compMgr.add(comps[i], result);
+        if (!ok)
+            break;
+
+        resistors[i].componentId = comps[i].id;
+        ok = insert(stmt, resistors[i], result);
+        stmt.reset();
+    }
+    stmt.release();
+
+    if (!ok || !tx.commit(result))
+        return false;
+
+    result.clear();
+    return true;
+}
+
+bool ResistorManager::insert(sqlite3_stmt* stmt, const Resistor& r, DbResult& result) {
+    bindResistorInsert(stmt, r);
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Get resistor by component ID
 bool ResistorManager::getByComponentId(int compId, Resistor& r, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
+    CachedStatement stmt;
     const char* sql =
         "SELECT "
         "ComponentID, Resistance, Tolerance, PowerRating, "
@@ -69,7 +145,7 @@ bool ResistorManager::getByComponentId(int compId, Resistor& r, DbResult& result
         "PackageTypeID, CompositionID, LeadSpacing, VoltageRating "
         "FROM Resistors WHERE ComponentID=?;";
 
-    if (!db_.prepare(sql, stmt, result))
+    if (!db_.prepareCached(sql, stmt, result))
         return false;
 
     sqlite3_bind_int(stmt, 1, compId);
@@ -110,18 +186,16 @@ bool ResistorManager::getByComponentId(int compId, Resistor& r, DbResult& result
     }
     else {
         result.setError(sqlite3_errcode(db_.handle()), "Resistor not found");
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Update resistor
 bool ResistorManager::update(const Resistor& r, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
+    CachedStatement stmt;
     const char* sql =
         "UPDATE Resistors SET "
         "Resistance=?, Tolerance=?, PowerRating=?, "
@@ -130,7 +204,7 @@ bool ResistorManager::update(const Resistor& r, DbResult& result) {
         "PackageTypeID=?, CompositionID=?, LeadSpacing=?, VoltageRating=? "
         "WHERE ComponentID=?;";
 
-    if (!db_.prepare(sql, stmt, result))
+    if (!db_.prepareCached(sql, stmt, result))
         return false;
 
     int idx = 1;
@@ -158,98 +232,101 @@ bool ResistorManager::update(const Resistor& r, DbResult& result) {
         sqlite3_bind_null(stmt, idx++);
     }
 
-    sqlite3_bind_int(stmt, idx++, r.packageTypeId);
-    sqlite3_bind_int(stmt, idx++, r.compositionId);
+    bindOptionalId(stmt, idx++, r.packageTypeId);
+    bindOptionalId(stmt, idx++, r.compositionId);
     sqlite3_bind_double(stmt, idx++, r.leadSpacing);
     sqlite3_bind_double(stmt, idx++, r.voltageRating);
     sqlite3_bind_int(stmt, idx++, r.componentId);
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // Delete resistor
 bool ResistorManager::remove(int compId, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
+    CachedStatement stmt;
     const char* sql = "DELETE FROM Resistors WHERE ComponentID=?;";
 
-    if (!db_.prepare(sql, stmt, result))
+    if (!db_.prepareCached(sql, stmt, result))
         return false;
 
     sqlite3_bind_int(stmt, 1, compId);
 
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-        db_.finalize(stmt);
         return false;
     }
 
-    db_.finalize(stmt);
     result.clear();
     return true;
 }
 
 // List all resistors
 bool ResistorManager::list(std::vector<Resistor>& resistors, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
+    return forEach([&](const Resistor& r) {
+        resistors.push_back(r);
+        return true;
+    }, result);
+}
+
+bool ResistorManager::forEach(const std::function<bool(const Resistor&)>& fn, DbResult& result) {
+    CachedStatement stmt;
     const char* sql =
         "SELECT "
         "ComponentID, Resistance, Tolerance, PowerRating, "
         "TempCoeffMin, TempCoeffMax, "
         "TempMin, TempMax, "
         "PackageTypeID, CompositionID, LeadSpacing, VoltageRating "
-        "FROM Resistors;";
+        "FROM Resistors ORDER BY ComponentID;";
 
-    if (!db_.prepare(sql, stmt, result))
+    if (!db_.prepareCached(sql, stmt, result))
         return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
         Resistor r;
         int col = 0;
 
-        r.componentId = sqlite3_column_int(stmt, col++);
-        r.resistance = sqlite3_column_double(stmt, col++);
-        r.tolerance = sqlite3_column_double(stmt, col++);
-        r.powerRating = sqlite3_column_double(stmt, col++);
+        r.componentId = sqlite3_column_int(row, col++);
+        r.resistance = sqlite3_column_double(row, col++);
+        r.tolerance = sqlite3_column_double(row, col++);
+        r.powerRating = sqlite3_column_double(row, col++);
 
         // TCR
-        if (sqlite3_column_type(stmt, col) == SQLITE_NULL) {
+        if (sqlite3_column_type(row, col) == SQLITE_NULL) {
             r.hasTempCoeff = false;
             col += 2;
         }
         else {
-            r.tempCoeffMin = sqlite3_column_double(stmt, col++);
-            r.tempCoeffMax = sqlite3_column_double(stmt, col++);
+            r.tempCoeffMin = sqlite3_column_double(row, col++);
+            r.tempCoeffMax = sqlite3_column_double(row, col++);
             r.hasTempCoeff = true;
         }
 
         // Temperature range
-        if (sqlite3_column_type(stmt, col) == SQLITE_NULL) {
+        if (sqlite3_column_type(row, col) == SQLITE_NULL) {
             r.hasTempRange = false;
             col += 2;
         }
         else {
-            r.tempMin = sqlite3_column_double(stmt, col++);
-            r.tempMax = sqlite3_column_double(stmt, col++);
+            r.tempMin = sqlite3_column_double(row, col++);
+            r.tempMax = sqlite3_column_double(row, col++);
             r.hasTempRange = true;
         }
 
-        r.packageTypeId = sqlite3_column_int(stmt, col++);
-        r.compositionId = sqlite3_column_int(stmt, col++);
-        r.leadSpacing = sqlite3_column_double(stmt, col++);
-        r.voltageRating = sqlite3_column_double(stmt, col++);
+        r.packageTypeId = sqlite3_column_int(row, col++);
+        r.compositionId = sqlite3_column_int(row, col++);
+        r.leadSpacing = sqlite3_column_double(row, col++);
+        r.voltageRating = sqlite3_column_double(row, col++);
 
-        resistors.push_back(r);
-    }
+        return fn(r);
+    }, result);
+}
 
-    db_.finalize(stmt);
-    result.clear();
-    return true;
+bool ResistorManager::find(const ResistorQuery& query, std::vector<int>& componentIds, DbResult& result) {
+    return query.run(db_, componentIds, result);
 }
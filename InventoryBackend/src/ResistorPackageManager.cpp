@@ -17,6 +17,7 @@ bool ResistorPackageManager::add(const ResistorPackage& pkg, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -60,6 +61,7 @@ bool ResistorPackageManager::update(const ResistorPackage& pkg, DbResult& result
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
@@ -79,36 +81,27 @@ bool ResistorPackageManager::remove(int id, DbResult& result) {
     }
 
     db_.finalize(stmt);
+    invalidateCache();
     result.clear();
     return true;
 }
 
 // List all packages
 bool ResistorPackageManager::list(std::vector<ResistorPackage>& pkgs, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID, Name FROM ResistorPackage;", stmt, result))
+    std::vector<LookupItem> items;
+    if (!listLookup(items, result))
         return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    for (const LookupItem& item : items) {
         ResistorPackage pkg;
-        pkg.id = sqlite3_column_int(stmt, 0);
-        pkg.name = safeColumnText(stmt, 1);
+        pkg.id = item.id;
+        pkg.name = item.name;
         pkgs.push_back(pkg);
     }
-
-    db_.finalize(stmt);
-    result.clear();
     return true;
 }
 
 // Get package ID by name
 int ResistorPackageManager::getByName(const std::string& name, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare("SELECT ID FROM ResistorPackage WHERE Name=?;", stmt, result)) return -1;
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-
-    int id = -1;
-    if (sqlite3_step(stmt) == SQLITE_ROW) id = sqlite3_column_int(stmt, 0);
-    sqlite3_finalize(stmt);
-    return id;
+    return getIdByName(name, result);
 }
@@ -1,13 +1,295 @@
 #include "SchemaManager.h"
 #include "DbUtils.h"
+#include "Transaction.h"
+#include <cstdio>
+#include <random>
 #include <string>
 #include <sqlite3.h>
 
+namespace {
+
+// Keep ComponentsFts (migration 9) in step with Components. Shared by the
+// migration and resumeSearchIndex().
+const char* const kSearchTriggersSql = R"SQL(
+        CREATE TRIGGER IF NOT EXISTS components_fts_insert
+        AFTER INSERT ON Components
+        BEGIN
+            INSERT INTO ComponentsFts (rowid, PartNumber, Description, Notes)
+            VALUES (NEW.ID, NEW.PartNumber, NEW.Description, NEW.Notes);
+        END;
+
+        CREATE TRIGGER IF NOT EXISTS components_fts_delete
+        AFTER DELETE ON Components
+        BEGIN
+            INSERT INTO ComponentsFts (ComponentsFts, rowid, PartNumber, Description, Notes)
+            VALUES ('delete', OLD.ID, OLD.PartNumber, OLD.Description, OLD.Notes);
+        END;
+
+        CREATE TRIGGER IF NOT EXISTS components_fts_update
+        AFTER UPDATE OF PartNumber, Description, Notes ON Components
+        BEGIN
+            INSERT INTO ComponentsFts (ComponentsFts, rowid, PartNumber, Description, Notes)
+            VALUES ('delete', OLD.ID, OLD.PartNumber, OLD.Description, OLD.Notes);
+            INSERT INTO ComponentsFts (rowid, PartNumber, Description, Notes)
+            VALUES (NEW.ID, NEW.PartNumber, NEW.Description, NEW.Notes);
+        END;
+)SQL";
+
+// ---- Stock statistics (migration 12) ----
+
+// Subtype tables whose package column feeds PackageStats
+struct PackageSource {
+    const char* family;
+    const char* table;
+    const char* column;
+};
+
+constexpr PackageSource kPackageSources[] = {
+    { "Resistor",   "Resistors",   "PackageTypeID" },
+    { "Capacitor",  "Capacitors",  "PackageTypeID" },
+    { "Transistor", "Transistors", "PackageID" },
+    { "Fuse",       "Fuses",       "PackageId" },
+    { "Diode",      "Diodes",      "PackageId" },
+};
+
+// Count one component with quantity qty into the stats row for key
+std::string addToStats(const std::string& table, const std::string& keyColumns,
+    const std::string& keyValues, const std::string& qty)
+{
+    return "INSERT INTO " + table + " (" + keyColumns + ", Components, TotalQuantity, ZeroStock)"
+        " VALUES (" + keyValues + ", 1, " + qty + ", " + qty + " <= 0)"
+        " ON CONFLICT (" + keyColumns + ") DO UPDATE SET"
+        " Components = Components + 1,"
+        " TotalQuantity = TotalQuantity + excluded.TotalQuantity,"
+        " ZeroStock = ZeroStock + excluded.ZeroStock;\n";
+}
+
+std::string removeFromStats(const std::string& table, const std::string& where,
+    const std::string& qty)
+{
+    return "UPDATE " + table + " SET Components = Components - 1,"
+        " TotalQuantity = TotalQuantity - " + qty + ","
+        " ZeroStock = ZeroStock - (" + qty + " <= 0)"
+        " WHERE " + where + ";\n";
+}
+
+// Move a component's quantity from oldQty to newQty without recounting it
+std::string shiftStats(const std::string& table, const std::string& where,
+    const std::string& oldQty, const std::string& newQty)
+{
+    return "UPDATE " + table + " SET"
+        " TotalQuantity = TotalQuantity - " + oldQty + " + " + newQty + ","
+        " ZeroStock = ZeroStock - (" + oldQty + " <= 0) + (" + newQty + " <= 0)"
+        " WHERE " + where + ";\n";
+}
+
+// Triggers that keep CategoryStats, ManufacturerStats and PackageStats
+// exact. A component counts under its category, its manufacturer (0 for
+// none) and, once it has a subtype row, that row's package (0 for none).
+//
+// Deleting a component cascades to its subtype row after the Components
+// row is gone, so the cascade cannot read the quantity any more: the
+// component's BEFORE DELETE trigger takes it out of PackageStats and the
+// subtype delete triggers only act while the component still exists.
+std::string statsTriggersSql()
+{
+    const std::string newQty = "IFNULL(NEW.Quantity, 0)";
+    const std::string oldQty = "IFNULL(OLD.Quantity, 0)";
+    const std::string oldCategory = "CategoryID = OLD.CategoryID";
+    const std::string oldManufacturer = "ManufacturerID = IFNULL(OLD.ManufacturerID, 0)";
+    const std::string moved = "OLD.CategoryID IS NOT NEW.CategoryID"
+        " OR IFNULL(OLD.ManufacturerID, 0) <> IFNULL(NEW.ManufacturerID, 0)";
+
+    // One keyed statement per family; a family the component is not in
+    // matches no row
+    std::string packageDelete;
+    std::string packageShift;
+    for (const PackageSource& src : kPackageSources) {
+        const std::string packageOf = std::string("Family = '") + src.family + "'"
+            " AND PackageID = (SELECT IFNULL(" + src.column + ", 0) FROM " + src.table
+            + " WHERE ComponentID = ";
+        packageDelete += removeFromStats("PackageStats", packageOf + "OLD.ID)", oldQty);
+        packageShift += shiftStats("PackageStats", packageOf + "NEW.ID)", oldQty, newQty);
+    }
+
+    std::string sql;
+    sql += "CREATE TRIGGER IF NOT EXISTS stats_components_insert AFTER INSERT ON Components BEGIN\n"
+        + addToStats("CategoryStats", "CategoryID", "NEW.CategoryID", newQty)
+        + addToStats("ManufacturerStats", "ManufacturerID", "IFNULL(NEW.ManufacturerID, 0)", newQty)
+        + "END;\n";
+
+    // The package side goes first, while the subtype row still exists
+    sql += "CREATE TRIGGER IF NOT EXISTS stats_components_delete_packages"
+        " BEFORE DELETE ON Components BEGIN\n"
+        + packageDelete
+        + "END;\n";
+
+    sql += "CREATE TRIGGER IF NOT EXISTS stats_components_delete AFTER DELETE ON Components BEGIN\n"
+        + removeFromStats("CategoryStats", oldCategory, oldQty)
+        + removeFromStats("ManufacturerStats", oldManufacturer, oldQty)
+        + "END;\n";
+
+    // Recategorized or new manufacturer: recount under the new keys
+    sql += "CREATE TRIGGER IF NOT EXISTS stats_components_move"
+        " AFTER UPDATE OF CategoryID, ManufacturerID ON Components WHEN " + moved + " BEGIN\n"
+        + removeFromStats("CategoryStats", oldCategory, oldQty)
+        + addToStats("CategoryStats", "CategoryID", "NEW.CategoryID", newQty)
+        + removeFromStats("ManufacturerStats", oldManufacturer, oldQty)
+        + addToStats("ManufacturerStats", "ManufacturerID", "IFNULL(NEW.ManufacturerID, 0)", newQty)
+        + "END;\n";
+
+    // Stock change: adjust the totals in place (the common case, e.g.
+    // every StockLedger movement). Category and manufacturer are left to
+    // stats_components_move when the same update also moved the component.
+    sql += "CREATE TRIGGER IF NOT EXISTS stats_components_quantity"
+        " AFTER UPDATE OF Quantity ON Components"
+        " WHEN OLD.Quantity IS NOT NEW.Quantity BEGIN\n"
+        + shiftStats("CategoryStats", oldCategory + " AND NOT (" + moved + ")", oldQty, newQty)
+        + shiftStats("ManufacturerStats", oldManufacturer + " AND NOT (" + moved + ")", oldQty, newQty)
+        + packageShift
+        + "END;\n";
+
+    for (const PackageSource& src : kPackageSources) {
+        const std::string family = std::string("'") + src.family + "'";
+        const std::string table = src.table;
+        const std::string column = src.column;
+        const std::string oldPackage = "Family = " + family
+            + " AND PackageID = IFNULL(OLD." + column + ", 0)";
+        const std::string newPackage = family + ", IFNULL(NEW." + column + ", 0)";
+        const std::string qtyOf = "IFNULL((SELECT Quantity FROM Components WHERE ID = ";
+        const std::string trigger = "stats_" + table;
+
+        sql += "CREATE TRIGGER IF NOT EXISTS " + trigger + "_insert AFTER INSERT ON " + table + " BEGIN\n"
+            + addToStats("PackageStats", "Family, PackageID", newPackage,
+                qtyOf + "NEW.ComponentID), 0)")
+            + "END;\n";
+
+        sql += "CREATE TRIGGER IF NOT EXISTS " + trigger + "_delete AFTER DELETE ON " + table
+            + " WHEN EXISTS (SELECT 1 FROM Components WHERE ID = OLD.ComponentID) BEGIN\n"
+            + removeFromStats("PackageStats", oldPackage, qtyOf + "OLD.ComponentID), 0)")
+            + "END;\n";
+
+        sql += "CREATE TRIGGER IF NOT EXISTS " + trigger + "_update AFTER UPDATE OF " + column
+            + " ON " + table + " BEGIN\n"
+            + removeFromStats("PackageStats", oldPackage, qtyOf + "OLD.ComponentID), 0)")
+            + addToStats("PackageStats", "Family, PackageID", newPackage,
+                qtyOf + "NEW.ComponentID), 0)")
+            + "END;\n";
+    }
+    return sql;
+}
+
+// Recount every stats table from scratch
+std::string statsRebuildSql()
+{
+    std::string sql =
+        "DELETE FROM CategoryStats;\n"
+        "DELETE FROM ManufacturerStats;\n"
+        "DELETE FROM PackageStats;\n"
+        "INSERT INTO CategoryStats (CategoryID, Components, TotalQuantity, ZeroStock)"
+        " SELECT CategoryID, COUNT(*), SUM(IFNULL(Quantity, 0)), SUM(IFNULL(Quantity, 0) <= 0)"
+        " FROM Components GROUP BY CategoryID;\n"
+        "INSERT INTO ManufacturerStats (ManufacturerID, Components, TotalQuantity, ZeroStock)"
+        " SELECT IFNULL(ManufacturerID, 0), COUNT(*), SUM(IFNULL(Quantity, 0)), SUM(IFNULL(Quantity, 0) <= 0)"
+        " FROM Components GROUP BY 1;\n";
+
+    for (const PackageSource& src : kPackageSources) {
+        sql += std::string("INSERT INTO PackageStats (Family, PackageID, Components, TotalQuantity, ZeroStock)"
+            " SELECT '") + src.family + "', IFNULL(s." + src.column + ", 0), COUNT(*),"
+            " SUM(IFNULL(c.Quantity, 0)), SUM(IFNULL(c.Quantity, 0) <= 0)"
+            " FROM " + src.table + " s JOIN Components c ON c.ID = s.ComponentID GROUP BY 2;\n";
+    }
+    return sql;
+}
+
+// Version of the newest migration in initialize(), stored in PRAGMA
+// user_version once applied
+constexpr int kSchemaVersion = 13;
+
+// ---- Search index suspension ----
+
+// A suspension whose heartbeat is older than this is taken to be left by
+// a load that crashed. Loads refresh it with every committed batch.
+constexpr int kSuspensionTimeoutSeconds = 60;
+
+const char* const kUnixNowSql = "CAST(strftime('%s', 'now') AS INTEGER)";
+
+// ---- Planner statistics ----
+
+// Index rows examined per index by ANALYZE; SQLite's own suggestion
+// for routine use is a few hundred to a thousand
+constexpr int kAnalysisLimit = 1000;
+
+// Tables whose indexes carry the inventory queries
+constexpr const char* kAnalyzedTables[] = {
+    "Components", "Resistors", "Capacitors", "Transistors", "BJTs", "Fuses", "Diodes",
+    "StockMovements",
+};
+
+// sqlite_stat1 rows for seedPlannerStats(): "<rows> <rows per distinct
+// value of the first column> <... first two columns> ...". Modeled on
+// 10k components over five categories and ~200 manufacturers, 40%
+// resistors, a handful of packages per family and a few ledger rows per
+// part. Only the relative selectivity matters to the planner.
+struct SeedStat {
+    const char* table;
+    const char* index;
+    const char* stat;
+};
+
+constexpr SeedStat kSeedStats[] = {
+    { "Components",     "idx_Components_PartNumber",              "10000 1" },
+    { "Components",     "idx_Components_Category_PartNumber",     "10000 2000 1" },
+    { "Components",     "idx_Components_Manufacturer_PartNumber", "10000 50 1" },
+    { "Resistors",      "idx_Resistors_CompositionID",            "4000 800" },
+    { "Resistors",      "idx_Resistors_Resistance",               "4000 4 2 1" },
+    { "Resistors",      "idx_Resistors_Package_Resistance",       "4000 400 2 1 1" },
+    { "Capacitors",     "idx_Capacitors_PackageTypeID",           "3000 300" },
+    { "Capacitors",     "idx_Capacitors_Capacitance",             "3000 5 1" },
+    { "Capacitors",     "idx_Capacitors_Dielectric_Capacitance",  "3000 600 4 1" },
+    { "Transistors",    "idx_Transistors_TypeID",                 "1000 250" },
+    { "Transistors",    "idx_Transistors_PolarityID",             "1000 500" },
+    { "Transistors",    "idx_Transistors_PackageID",              "1000 100" },
+    { "BJTs",           "idx_BJTs_VceMax",                        "800 10 1" },
+    { "Fuses",          "idx_Fuses_PackageId",                    "500 50" },
+    { "Fuses",          "idx_Fuses_TypeId",                       "500 100" },
+    { "Fuses",          "idx_Fuses_CurrentRating",                "500 10 2" },
+    { "Diodes",         "idx_Diodes_PackageId",                   "1000 100" },
+    { "Diodes",         "idx_Diodes_TypeId",                      "1000 200" },
+    { "Diodes",         "idx_Diodes_PolarityId",                  "1000 500" },
+    { "Diodes",         "idx_Diodes_MaxReverseVoltage",           "1000 20 2" },
+    { "StockMovements", "idx_StockMovements_Component",           "50000 5 1" },
+};
+
+const std::string kAnalysisLimitSql =
+    "PRAGMA analysis_limit = " + std::to_string(kAnalysisLimit) + ";";
+
+} // namespace
+
 bool SchemaManager::initialize(DbResult& result) {
-    // Always enforce foreign keys
+    // Always enforce foreign keys. Per connection, and ignored inside a
+    // transaction, so it goes first.
     if (!db_.exec("PRAGMA foreign_keys = ON;", result))
         return false;
 
+    // Fast path: user_version sits in the file header, so a current
+    // database is recognized without reading a table or writing anything
+    int version = 0;
+    if (!storedVersion(version, false, result))
+        return false;
+    if (version >= kSchemaVersion)
+        return true;
+
+    // Every pending migration commits at once: a single sync for a new
+    // database, and a failed upgrade leaves the file as it was
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    // Another connection may have migrated while this one waited
+    if (!storedVersion(version, true, result))
+        return false;
+
     // Ensure SchemaVersion table exists
     if (!db_.exec(R"SQL(
         CREATE TABLE IF NOT EXISTS SchemaVersion (
@@ -17,16 +299,6 @@ bool SchemaManager::initialize(DbResult& result) {
         );
     )SQL", result)) return false;
 
-    // Check current version
-    int version = 0;
-    sqlite3_stmt* stmt = nullptr;
-    if (db_.prepare("SELECT MAX(Version) FROM SchemaVersion;", stmt, result)) {
-        if (sqlite3_step(stmt) == SQLITE_ROW) {
-            version = sqlite3_column_int(stmt, 0);
-        }
-        sqlite3_finalize(stmt);
-    }
-
     // Apply baseline schema if fresh
     if (version < 1) {
         const char* baseline = R"SQL(
@@ -100,24 +372,9 @@ bool SchemaManager::initialize(DbResult& result) {
         if (!db_.exec(baseline, result)) return false;
 
         // Insert baseline version record
-        sqlite3_stmt* insertStmt = nullptr;
-        if (db_.prepare(
-            "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
-            insertStmt,
-            result)) {
-
-            sqlite3_bind_int(insertStmt, 1, 1);
-            sqlite3_bind_text(insertStmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(insertStmt, 3,
-                "Baseline schema with Categories, Manufacturers, Components.Quantity, CreatedOn/ModifiedOn, and trigger.",
-                -1, SQLITE_TRANSIENT);
-
-            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
-                result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-            }
-
-            sqlite3_finalize(insertStmt);
-        }
+        if (!recordVersion(1,
+            "Baseline schema with Categories, Manufacturers, Components.Quantity, CreatedOn/ModifiedOn, and trigger.",
+            result)) return false;
     }
 
     // Future migrations go here:
@@ -129,23 +386,9 @@ bool SchemaManager::initialize(DbResult& result) {
 
         if (!db_.exec(migration2, result)) return false;
 
-        sqlite3_stmt* insertStmt = nullptr;
-        if (db_.prepare(
-            "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
-            insertStmt,
-            result)) {
-
-            sqlite3_bind_int(insertStmt, 1, 2);
-            sqlite3_bind_text(insertStmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(insertStmt, 3,
-                "Added DatasheetLink column to Components table.",
-                -1, SQLITE_TRANSIENT);
-
-            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
-                result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-            }
-            sqlite3_finalize(insertStmt);
-        }
+        if (!recordVersion(2,
+            "Added DatasheetLink column to Components table.",
+            result)) return false;
     }
 
     if (version < 3) {
@@ -188,23 +431,9 @@ bool SchemaManager::initialize(DbResult& result) {
 
         if (!db_.exec(migration3, result)) return false;
 
-        sqlite3_stmt* insertStmt = nullptr;
-        if (db_.prepare(
-            "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
-            insertStmt,
-            result)) {
-
-            sqlite3_bind_int(insertStmt, 1, 3);
-            sqlite3_bind_text(insertStmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(insertStmt, 3,
-                "Added Capacitors table with dielectric/package lookups and unified geometry fields.",
-                -1, SQLITE_TRANSIENT);
-
-            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
-                result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-            }
-            sqlite3_finalize(insertStmt);
-        }
+        if (!recordVersion(3,
+            "Added Capacitors table with dielectric/package lookups and unified geometry fields.",
+            result)) return false;
     }
 
     if (version < 4) {
@@ -255,23 +484,9 @@ bool SchemaManager::initialize(DbResult& result) {
 
         if (!db_.exec(migration4, result)) return false;
 
-        sqlite3_stmt* insertStmt = nullptr;
-        if (db_.prepare(
-            "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
-            insertStmt,
-            result)) {
-
-            sqlite3_bind_int(insertStmt, 1, 4);
-            sqlite3_bind_text(insertStmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(insertStmt, 3,
-                "Added Transistors base table with lookup tables and BJT subtype. Future expansion for MOSFETs, JFETs, IGBTs.",
-                -1, SQLITE_TRANSIENT);
-
-            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
-                result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-            }
-            sqlite3_finalize(insertStmt);
-        }
+        if (!recordVersion(4,
+            "Added Transistors base table with lookup tables and BJT subtype. Future expansion for MOSFETs, JFETs, IGBTs.",
+            result)) return false;
     }
 
     if (version < 5) {
@@ -332,23 +547,9 @@ bool SchemaManager::initialize(DbResult& result) {
 
         if (!db_.exec(migration5, result)) return false;
 
-        sqlite3_stmt* insertStmt = nullptr;
-        if (db_.prepare(
-            "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
-            insertStmt,
-            result)) {
-
-            sqlite3_bind_int(insertStmt, 1, 5);
-            sqlite3_bind_text(insertStmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(insertStmt, 3,
-                "Seeded baseline lookup values for categories, manufacturers, resistor, capacitor, and transistor tables.",
-                -1, SQLITE_TRANSIENT);
-
-            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
-                result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-            }
-            sqlite3_finalize(insertStmt);
-        }
+        if (!recordVersion(5,
+            "Seeded baseline lookup values for categories, manufacturers, resistor, capacitor, and transistor tables.",
+            result)) return false;
     }
 
     if (version < 6) {
@@ -392,23 +593,9 @@ bool SchemaManager::initialize(DbResult& result) {
 
         if (!db_.exec(migration6, result)) return false;
 
-        sqlite3_stmt* insertStmt = nullptr;
-        if (db_.prepare(
-            "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
-            insertStmt,
-            result)) {
-
-            sqlite3_bind_int(insertStmt, 1, 6);
-            sqlite3_bind_text(insertStmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(insertStmt, 3,
-                "Added Fuse support: created FusePackage, FuseType, and Fuses tables with baseline seeds, including current and voltage ratings.",
-                -1, SQLITE_TRANSIENT);
-
-            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
-                result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
-            }
-            sqlite3_finalize(insertStmt);
-        }
+        if (!recordVersion(6,
+            "Added Fuse support: created FusePackage, FuseType, and Fuses tables with baseline seeds, including current and voltage ratings.",
+            result)) return false;
     }
 
     if (version < 7) {
@@ -470,24 +657,425 @@ bool SchemaManager::initialize(DbResult& result) {
 
         if (!db_.exec(migration7, result)) return false;
 
-        sqlite3_stmt* insertStmt = nullptr;
-        if (db_.prepare(
-            "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
-            insertStmt,
-            result)) {
+        if (!recordVersion(7,
+            "Added Diode support: created DiodeType, DiodePackage, DiodePolarity, and Diodes tables with baseline seeds.",
+            result)) return false;
+    }
+
+    if (version < 8) {
+        const char* migration8 = R"SQL(
+        -- Component lookups. PartNumber inherits COLLATE NOCASE from the
+        -- column, so case-insensitive searches can use these indexes.
+        CREATE INDEX IF NOT EXISTS idx_Components_PartNumber
+            ON Components(PartNumber);
+        CREATE INDEX IF NOT EXISTS idx_Components_Category_PartNumber
+            ON Components(CategoryID, PartNumber);
+        CREATE INDEX IF NOT EXISTS idx_Components_Manufacturer_PartNumber
+            ON Components(ManufacturerID, PartNumber);
+
+        -- Subtype FK columns: filtering by package/type and the FK check
+        -- that runs when a lookup row is deleted would otherwise scan
+        -- the whole child table.
+        CREATE INDEX IF NOT EXISTS idx_Resistors_PackageTypeID
+            ON Resistors(PackageTypeID);
+        CREATE INDEX IF NOT EXISTS idx_Resistors_CompositionID
+            ON Resistors(CompositionID);
+
+        CREATE INDEX IF NOT EXISTS idx_Capacitors_PackageTypeID
+            ON Capacitors(PackageTypeID);
+        CREATE INDEX IF NOT EXISTS idx_Capacitors_DielectricTypeID
+            ON Capacitors(DielectricTypeID);
+
+        CREATE INDEX IF NOT EXISTS idx_Transistors_TypeID
+            ON Transistors(TypeID);
+        CREATE INDEX IF NOT EXISTS idx_Transistors_PolarityID
+            ON Transistors(PolarityID);
+        CREATE INDEX IF NOT EXISTS idx_Transistors_PackageID
+            ON Transistors(PackageID);
+
+        CREATE INDEX IF NOT EXISTS idx_Fuses_PackageId
+            ON Fuses(PackageId);
+        CREATE INDEX IF NOT EXISTS idx_Fuses_TypeId
+            ON Fuses(TypeId);
+
+        CREATE INDEX IF NOT EXISTS idx_Diodes_PackageId
+            ON Diodes(PackageId);
+        CREATE INDEX IF NOT EXISTS idx_Diodes_TypeId
+            ON Diodes(TypeId);
+        CREATE INDEX IF NOT EXISTS idx_Diodes_PolarityId
+            ON Diodes(PolarityId);
+    )SQL";
+
+        if (!db_.exec(migration8, result)) return false;
+
+        if (!recordVersion(8,
+            "Added secondary indexes on Components part number/category/manufacturer and on subtype lookup FK columns.",
+            result)) return false;
+    }
+
+    if (version < 9) {
+        const char* migration9 = R"SQL(
+        -- Full-text index over the searchable Components columns. It is an
+        -- external-content table: text lives only in Components and the
+        -- kSearchTriggersSql triggers keep the index in step with it.
+        CREATE VIRTUAL TABLE IF NOT EXISTS ComponentsFts USING fts5(
+            PartNumber,
+            Description,
+            Notes,
+            content = 'Components',
+            content_rowid = 'ID',
+            tokenize = "unicode61 remove_diacritics 2 tokenchars '-_.'",
+            prefix = '2 3'
+        );
+
+    )SQL";
+
+        if (!db_.exec(migration9, result)) return false;
+        if (!db_.exec(kSearchTriggersSql, result)) return false;
+
+        // Index rows that existed before this migration
+        if (!db_.exec("INSERT INTO ComponentsFts (ComponentsFts) VALUES ('rebuild');", result))
+            return false;
+
+        if (!recordVersion(9,
+            "Added ComponentsFts full-text index over part number, description and notes, kept in sync by triggers.",
+            result)) return false;
+    }
+
+    if (version < 10) {
+        const char* migration10 = R"SQL(
+        -- Composite indexes for parametric search. Equality columns
+        -- (package, dielectric) lead, then the range column, then the
+        -- attributes most often filtered alongside it. ComponentID is the
+        -- rowid, so these cover the ID-only parametric queries entirely.
+        CREATE INDEX IF NOT EXISTS idx_Resistors_Resistance
+            ON Resistors(Resistance, Tolerance, PowerRating);
+        CREATE INDEX IF NOT EXISTS idx_Resistors_Package_Resistance
+            ON Resistors(PackageTypeID, Resistance, Tolerance, PowerRating);
+
+        CREATE INDEX IF NOT EXISTS idx_Capacitors_Capacitance
+            ON Capacitors(Capacitance, VoltageRating);
+        CREATE INDEX IF NOT EXISTS idx_Capacitors_Dielectric_Capacitance
+            ON Capacitors(DielectricTypeID, Capacitance, VoltageRating);
+
+        CREATE INDEX IF NOT EXISTS idx_Diodes_MaxReverseVoltage
+            ON Diodes(MaxReverseVoltage, MaxCurrent);
+        CREATE INDEX IF NOT EXISTS idx_Fuses_CurrentRating
+            ON Fuses(CurrentRating, VoltageRating);
+        CREATE INDEX IF NOT EXISTS idx_BJTs_VceMax
+            ON BJTs(VceMax, IcMax);
+
+        -- The new package/dielectric indexes lead with the FK column, so
+        -- they also serve the FK checks the v8 single-column ones did.
+        DROP INDEX IF EXISTS idx_Resistors_PackageTypeID;
+        DROP INDEX IF EXISTS idx_Capacitors_DielectricTypeID;
+    )SQL";
+
+        if (!db_.exec(migration10, result)) return false;
+
+        if (!recordVersion(10,
+            "Added composite indexes for parametric search on resistor, capacitor, diode, fuse and BJT ratings.",
+            result)) return false;
+    }
+
+    if (version < 11) {
+        const char* migration11 = R"SQL(
+        -- Append-only stock history written by StockLedger, one row per
+        -- movement in the same transaction as the Quantity change.
+        CREATE TABLE IF NOT EXISTS StockMovements (
+            ID INTEGER PRIMARY KEY,
+            ComponentID INTEGER NOT NULL,
+            Kind TEXT NOT NULL CHECK (Kind IN ('receive', 'consume', 'adjust')),
+            Delta INTEGER NOT NULL,
+            QuantityAfter INTEGER NOT NULL,
+            Reason TEXT,
+            CreatedOn TEXT NOT NULL DEFAULT (datetime('now')),
+            FOREIGN KEY (ComponentID) REFERENCES Components(ID) ON DELETE CASCADE
+        );
+
+        -- Per-component history in order; also serves the cascade when a
+        -- component is deleted.
+        CREATE INDEX IF NOT EXISTS idx_StockMovements_Component
+            ON StockMovements(ComponentID, ID);
+
+        -- History is never rewritten. Deletes stay possible so the
+        -- cascade can remove a deleted component's movements.
+        CREATE TRIGGER IF NOT EXISTS stock_movements_append_only
+        BEFORE UPDATE ON StockMovements
+        BEGIN
+            SELECT RAISE(ABORT, 'StockMovements rows cannot be changed');
+        END;
+    )SQL";
+
+        if (!db_.exec(migration11, result)) return false;
+
+        if (!recordVersion(11,
+            "Added StockMovements ledger for delta stock changes (receive, consume, adjust).",
+            result)) return false;
+    }
+
+    if (version < 12) {
+        const char* migration12 = R"SQL(
+        -- Running totals per category, manufacturer and subtype package,
+        -- so dashboards read a handful of rows instead of scanning
+        -- Components. Kept exact by the statsTriggersSql() triggers.
+        -- ManufacturerID and PackageID 0 collect rows without one.
+        CREATE TABLE IF NOT EXISTS CategoryStats (
+            CategoryID INTEGER PRIMARY KEY,
+            Components INTEGER NOT NULL,
+            TotalQuantity INTEGER NOT NULL,
+            ZeroStock INTEGER NOT NULL
+        );
+
+        CREATE TABLE IF NOT EXISTS ManufacturerStats (
+            ManufacturerID INTEGER PRIMARY KEY,
+            Components INTEGER NOT NULL,
+            TotalQuantity INTEGER NOT NULL,
+            ZeroStock INTEGER NOT NULL
+        );
+
+        CREATE TABLE IF NOT EXISTS PackageStats (
+            Family TEXT NOT NULL,
+            PackageID INTEGER NOT NULL,
+            Components INTEGER NOT NULL,
+            TotalQuantity INTEGER NOT NULL,
+            ZeroStock INTEGER NOT NULL,
+            PRIMARY KEY (Family, PackageID)
+        ) WITHOUT ROWID;
+    )SQL";
+
+        if (!db_.exec(migration12, result)) return false;
+        if (!db_.exec(statsTriggersSql(), result)) return false;
+
+        // Count rows that existed before this migration
+        if (!db_.exec(statsRebuildSql(), result)) return false;
+
+        if (!recordVersion(12,
+            "Added trigger-maintained stock totals per category, manufacturer and package.",
+            result)) return false;
+    }
+
+    if (version < 13) {
+        const char* migration13 = R"SQL(
+        -- Present while a bulk load runs with the search triggers dropped
+        -- (suspendSearchIndex). Heartbeat is in unix seconds and moves
+        -- with every committed batch, so a marker left by a crashed load
+        -- can be told from a running one.
+        CREATE TABLE IF NOT EXISTS SearchIndexSuspension (
+            ID INTEGER PRIMARY KEY CHECK (ID = 1),
+            Owner TEXT NOT NULL,
+            Heartbeat INTEGER NOT NULL
+        );
+    )SQL";
+
+        if (!db_.exec(migration13, result)) return false;
+
+        if (!recordVersion(13,
+            "Added SearchIndexSuspension marker for bulk loads that defer the search index.",
+            result)) return false;
+    }
+
+    if (!db_.exec("PRAGMA user_version = " + std::to_string(kSchemaVersion) + ";", result))
+        return false;
+    if (!tx.commit(result))
+        return false;
+
+    // Migrations seed lookup tables behind any cached copies
+    db_.invalidateCaches();
+
+    return true;
+}
+
+bool SchemaManager::recordVersion(int version, const char* description, DbResult& result) {
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "INSERT INTO SchemaVersion (Version, AppliedOn, Description) VALUES (?,?,?);",
+        stmt, result))
+        return false;
+    sqlite3_bind_int(stmt, 1, version);
+    sqlite3_bind_text(stmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 3, description, -1, SQLITE_STATIC);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+    result.clear();
+    return true;
+}
+
+bool SchemaManager::storedVersion(int& version, bool withHistory, DbResult& result) {
+    version = 0;
+    {
+        CachedStatement stmt;
+        if (!db_.prepareCached("PRAGMA user_version;", stmt, result))
+            return false;
+        db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+            version = sqlite3_column_int(row, 0);
+            return false;
+        }, result);
+        if (!result.ok())
+            return false;
+    }
+
+    // Files migrated before user_version was kept only have the history
+    if (withHistory && version == 0 && db_.tableExists("SchemaVersion"))
+        version = db_.getMaxSchemaVersion();
+
+    result.clear();
+    return true;
+}
+
+bool SchemaManager::suspendSearchIndex(DbResult& result) {
+    char owner[17];
+    std::snprintf(owner, sizeof(owner), "%016llx",
+        (static_cast<unsigned long long>(std::random_device{}()) << 32) ^ std::random_device{}());
+    suspensionOwner_ = owner;
+
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    if (!db_.exec(R"SQL(
+        DROP TRIGGER IF EXISTS components_fts_insert;
+        DROP TRIGGER IF EXISTS components_fts_delete;
+        DROP TRIGGER IF EXISTS components_fts_update;
+    )SQL", result))
+        return false;
+
+    {
+        CachedStatement stmt;
+        if (!db_.prepareCached(std::string(
+            "INSERT OR REPLACE INTO SearchIndexSuspension (ID, Owner, Heartbeat) VALUES (1, ?, ")
+            + kUnixNowSql + ");", stmt, result))
+            return false;
+        sqlite3_bind_text(stmt, 1, suspensionOwner_.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+            return false;
+        }
+    }
+
+    return tx.commit(result);
+}
+
+bool SchemaManager::touchSearchIndexSuspension(DbResult& result) {
+    CachedStatement stmt;
+    if (!db_.prepareCached(std::string("UPDATE SearchIndexSuspension SET Heartbeat = ")
+        + kUnixNowSql + " WHERE Owner = ?;", stmt, result))
+        return false;
+    sqlite3_bind_text(stmt, 1, suspensionOwner_.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+    result.clear();
+    return true;
+}
+
+bool SchemaManager::resumeSearchIndex(DbResult& result) {
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    if (!db_.exec(kSearchTriggersSql, result)
+        || !db_.exec("INSERT INTO ComponentsFts (ComponentsFts) VALUES ('rebuild');", result)
+        || !db_.exec("DELETE FROM SearchIndexSuspension;", result))
+        return false;
+
+    suspensionOwner_.clear();
+    return tx.commit(result);
+}
+
+bool SchemaManager::recoverSearchIndex(DbResult& result) {
+    const std::string triggerPresent = "type = 'trigger' AND name = 'components_fts_insert'";
+    const std::string liveSuspension = std::string("Heartbeat >= ") + kUnixNowSql
+        + " - " + std::to_string(kSuspensionTimeoutSeconds);
+
+    // The usual case: triggers in place, nothing to take a lock for
+    if (db_.countRows("sqlite_master", triggerPresent) > 0) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    // Under the write lock: the load may have resumed meanwhile, or may
+    // still be running. Triggers missing without a marker were dropped
+    // by a load from before the marker existed.
+    if (db_.countRows("sqlite_master", triggerPresent) > 0
+        || db_.countRows("SearchIndexSuspension", liveSuspension) > 0)
+        return tx.commit(result);
+
+    if (!db_.exec(kSearchTriggersSql, result)
+        || !db_.exec("INSERT INTO ComponentsFts (ComponentsFts) VALUES ('rebuild');", result)
+        || !db_.exec("DELETE FROM SearchIndexSuspension;", result))
+        return false;
 
-            sqlite3_bind_int(insertStmt, 1, 7);
-            sqlite3_bind_text(insertStmt, 2, currentTimestamp().c_str(), -1, SQLITE_TRANSIENT);
-            sqlite3_bind_text(insertStmt, 3,
-                "Added Diode support: created DiodeType, DiodePackage, DiodePolarity, and Diodes tables with baseline seeds.",
-                -1, SQLITE_TRANSIENT);
+    return tx.commit(result);
+}
+
+bool SchemaManager::analyzePlannerStats(DbResult& result) {
+    std::string sql = kAnalysisLimitSql;
+    for (const char* table : kAnalyzedTables)
+        sql += std::string("ANALYZE ") + table + ";";
+
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    if (!db_.exec(sql, result))
+        return false;
 
-            if (sqlite3_step(insertStmt) != SQLITE_DONE) {
+    return tx.commit(result);
+}
+
+bool SchemaManager::optimizePlannerStats(DbResult& result) {
+    return db_.exec(kAnalysisLimitSql + "PRAGMA optimize;", result);
+}
+
+bool SchemaManager::seedPlannerStats(DbResult& result) {
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    // Analyzing the schema table creates sqlite_stat1 without touching
+    // any inventory table
+    if (!db_.exec("ANALYZE sqlite_schema;", result))
+        return false;
+
+    if (db_.countRows("sqlite_stat1", "idx IS NOT NULL") > 0) {
+        result.clear();
+        return true;
+    }
+
+    {
+        // Indexes a future migration drops are skipped
+        CachedStatement stmt;
+        if (!db_.prepareCached(
+            "INSERT INTO sqlite_stat1 (tbl, idx, stat) SELECT ?1, ?2, ?3 "
+            "WHERE EXISTS (SELECT 1 FROM sqlite_schema WHERE type = 'index' AND name = ?2);",
+            stmt, result)) {
+            return false;
+        }
+
+        for (const SeedStat& seed : kSeedStats) {
+            sqlite3_bind_text(stmt, 1, seed.table, -1, SQLITE_STATIC);
+            sqlite3_bind_text(stmt, 2, seed.index, -1, SQLITE_STATIC);
+            sqlite3_bind_text(stmt, 3, seed.stat, -1, SQLITE_STATIC);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
                 result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+                return false;
             }
-            sqlite3_finalize(insertStmt);
+            stmt.reset();
         }
     }
 
-    return true;
+    // The planner only reads sqlite_stat1 when the schema is (re)loaded;
+    // analyzing sqlite_schema again reloads it
+    if (!db_.exec("ANALYZE sqlite_schema;", result))
+        return false;
+
+    return tx.commit(result);
 }
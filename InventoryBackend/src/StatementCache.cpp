@@ -0,0 +1,146 @@
+#include "StatementCache.h"
+
+#include <utility>
+
+// ---- CachedStatement ----
+
+CachedStatement::CachedStatement(CachedStatement&& other) noexcept
+    : owner_(std::exchange(other.owner_, nullptr))
+    , stmt_(std::exchange(other.stmt_, nullptr))
+{
+}
+
+CachedStatement& CachedStatement::operator=(CachedStatement&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        owner_ = std::exchange(other.owner_, nullptr);
+        stmt_ = std::exchange(other.stmt_, nullptr);
+    }
+    return *this;
+}
+
+void CachedStatement::reset()
+{
+    if (stmt_) {
+        sqlite3_reset(stmt_);
+        sqlite3_clear_bindings(stmt_);
+    }
+}
+
+void CachedStatement::release()
+{
+    if (!stmt_)
+        return;
+
+    if (owner_) {
+        reset();
+        owner_->giveBack(stmt_);
+    }
+    else {
+        sqlite3_finalize(stmt_);
+    }
+
+    owner_ = nullptr;
+    stmt_ = nullptr;
+}
+
+// ---- StatementCache ----
+
+int StatementCache::acquire(sqlite3* db, const std::string& sql, CachedStatement& stmt)
+{
+    stmt.release();
+
+    auto it = index_.find(sql);
+    if (it != index_.end()) {
+        auto entry = it->second;
+        if (!entry->inUse) {
+            // Hit: move to the front of the LRU list
+            entries_.splice(entries_.begin(), entries_, entry);
+            entry->inUse = true;
+            stmt = CachedStatement(this, entry->stmt);
+            return SQLITE_OK;
+        }
+
+        // Same SQL is already checked out (e.g. nested use): hand out a
+        // private statement that is finalized on release.
+        sqlite3_stmt* raw = nullptr;
+        int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &raw, nullptr);
+        if (rc != SQLITE_OK) {
+            sqlite3_finalize(raw);
+            return rc;
+        }
+        stmt = CachedStatement(nullptr, raw);
+        return SQLITE_OK;
+    }
+
+    sqlite3_stmt* raw = nullptr;
+    int rc = sqlite3_prepare_v3(db, sql.c_str(), -1,
+        SQLITE_PREPARE_PERSISTENT, &raw, nullptr);
+    if (rc != SQLITE_OK) {
+        sqlite3_finalize(raw);
+        return rc;
+    }
+
+    if (capacity_ == 0) {
+        stmt = CachedStatement(nullptr, raw);
+        return SQLITE_OK;
+    }
+
+    entries_.push_front(Entry{ sql, raw, true });
+    index_.emplace(sql, entries_.begin());
+    byStmt_.emplace(raw, entries_.begin());
+    evictIdle();
+
+    stmt = CachedStatement(this, raw);
+    return SQLITE_OK;
+}
+
+void StatementCache::giveBack(sqlite3_stmt* stmt)
+{
+    auto it = byStmt_.find(stmt);
+    if (it == byStmt_.end()) {
+        // Evicted by clear() while checked out
+        sqlite3_finalize(stmt);
+        return;
+    }
+
+    it->second->inUse = false;
+    evictIdle();
+}
+
+void StatementCache::evictIdle()
+{
+    // Walk from the least recently used end, skipping statements in use
+    auto it = entries_.end();
+    while (entries_.size() > capacity_ && it != entries_.begin()) {
+        --it;
+        if (it->inUse)
+            continue;
+
+        sqlite3_finalize(it->stmt);
+        index_.erase(it->sql);
+        byStmt_.erase(it->stmt);
+        it = entries_.erase(it);
+    }
+}
+
+void StatementCache::clear()
+{
+    // Statements still checked out are only detached here; giveBack()
+    // finalizes them once their handle lets go.
+    for (const Entry& e : entries_) {
+        if (!e.inUse)
+            sqlite3_finalize(e.stmt);
+    }
+
+    entries_.clear();
+    index_.clear();
+    byStmt_.clear();
+}
+
+void StatementCache::setCapacity(std::size_t capacity)
+{
+    capacity_ = capacity;
+    evictIdle();
+}
@@ -0,0 +1,121 @@
+#include "StatsManager.h"
+#include "DbUtils.h"
+#include <sqlite3.h>
+
+namespace {
+
+// Components, TotalQuantity, ZeroStock starting at column first
+StockTotals readTotals(sqlite3_stmt* row, int first)
+{
+    StockTotals t;
+    t.components = sqlite3_column_int64(row, first);
+    t.totalQuantity = sqlite3_column_int64(row, first + 1);
+    t.zeroStock = sqlite3_column_int64(row, first + 2);
+    return t;
+}
+
+} // namespace
+
+bool StatsManager::totals(StockTotals& totals, DbResult& result)
+{
+    totals = StockTotals{};
+
+    // Every component has exactly one category, so the category rows add up
+    // to the whole inventory
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "SELECT TOTAL(Components), TOTAL(TotalQuantity), TOTAL(ZeroStock) FROM CategoryStats;",
+        stmt, result)) {
+        return false;
+    }
+
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        totals = readTotals(row, 0);
+        return false;
+    }, result);
+}
+
+bool StatsManager::categoryTotals(int categoryId, StockTotals& totals, DbResult& result)
+{
+    totals = StockTotals{};
+
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "SELECT Components, TotalQuantity, ZeroStock FROM CategoryStats WHERE CategoryID = ?;",
+        stmt, result)) {
+        return false;
+    }
+    sqlite3_bind_int(stmt, 1, categoryId);
+
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        totals = readTotals(row, 0);
+        return false;
+    }, result);
+}
+
+bool StatsManager::byCategory(std::vector<StockGroup>& groups, DbResult& result)
+{
+    return listGroups(
+        "SELECT s.CategoryID, c.Name, s.Components, s.TotalQuantity, s.ZeroStock "
+        "FROM CategoryStats s LEFT JOIN Categories c ON c.ID = s.CategoryID "
+        "WHERE s.Components > 0 ORDER BY c.Name;",
+        groups, result);
+}
+
+bool StatsManager::byManufacturer(std::vector<StockGroup>& groups, DbResult& result)
+{
+    return listGroups(
+        "SELECT s.ManufacturerID, m.Name, s.Components, s.TotalQuantity, s.ZeroStock "
+        "FROM ManufacturerStats s LEFT JOIN Manufacturers m ON m.ID = s.ManufacturerID "
+        "WHERE s.Components > 0 ORDER BY m.Name;",
+        groups, result);
+}
+
+bool StatsManager::byPackage(std::vector<PackageStockGroup>& groups, DbResult& result)
+{
+    groups.clear();
+
+    // Each family keeps its packages in its own lookup table
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "SELECT Family, PackageID, CASE Family "
+        "WHEN 'Resistor' THEN (SELECT Name FROM ResistorPackage WHERE ID = PackageID) "
+        "WHEN 'Capacitor' THEN (SELECT Name FROM CapacitorPackage WHERE ID = PackageID) "
+        "WHEN 'Transistor' THEN (SELECT Name FROM TransistorPackage WHERE ID = PackageID) "
+        "WHEN 'Fuse' THEN (SELECT Name FROM FusePackage WHERE Id = PackageID) "
+        "WHEN 'Diode' THEN (SELECT Name FROM DiodePackage WHERE Id = PackageID) END AS Name, "
+        "Components, TotalQuantity, ZeroStock "
+        "FROM PackageStats WHERE Components > 0 ORDER BY Family, Name;",
+        stmt, result)) {
+        return false;
+    }
+
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        PackageStockGroup g;
+        g.family = safeColumnText(row, 0);
+        g.packageId = sqlite3_column_int(row, 1);
+        g.name = safeColumnText(row, 2);
+        g.totals = readTotals(row, 3);
+        groups.push_back(std::move(g));
+        return true;
+    }, result);
+}
+
+bool StatsManager::listGroups(const std::string& sql, std::vector<StockGroup>& groups,
+    DbResult& result)
+{
+    groups.clear();
+
+    CachedStatement stmt;
+    if (!db_.prepareCached(sql, stmt, result))
+        return false;
+
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        StockGroup g;
+        g.id = sqlite3_column_int(row, 0);
+        g.name = safeColumnText(row, 1);
+        g.totals = readTotals(row, 2);
+        groups.push_back(std::move(g));
+        return true;
+    }, result);
+}
@@ -0,0 +1,176 @@
+#include "StockLedger.h"
+#include "DbUtils.h"
+#include "Transaction.h"
+#include <sqlite3.h>
+
+namespace {
+
+const char* kindName(StockMovementKind kind)
+{
+    switch (kind) {
+    case StockMovementKind::Receive: return "receive";
+    case StockMovementKind::Consume: return "consume";
+    case StockMovementKind::Adjust:  return "adjust";
+    }
+    return "adjust";
+}
+
+StockMovementKind kindFromName(std::string_view name)
+{
+    if (name == "receive") return StockMovementKind::Receive;
+    if (name == "consume") return StockMovementKind::Consume;
+    return StockMovementKind::Adjust;
+}
+
+bool deltaFits(StockMovementKind kind, int delta)
+{
+    switch (kind) {
+    case StockMovementKind::Receive: return delta > 0;
+    case StockMovementKind::Consume: return delta < 0;
+    case StockMovementKind::Adjust:  return delta != 0;
+    }
+    return false;
+}
+
+} // namespace
+
+bool StockLedger::adjustQuantity(int componentId, int delta, StockMovementKind kind,
+    const std::string& reason, int& newQuantity, DbResult& result)
+{
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    if (!apply(componentId, delta, kind, reason, newQuantity, result) || !tx.commit(result))
+        return false;
+
+    result.clear();
+    return true;
+}
+
+bool StockLedger::adjustQuantity(int componentId, int delta, DbResult& result)
+{
+    int newQuantity = 0;
+    return adjustQuantity(componentId, delta, StockMovementKind::Adjust, "", newQuantity, result);
+}
+
+bool StockLedger::adjustBatch(std::span<const StockAdjustment> adjustments,
+    StockMovementKind kind, const std::string& reason, DbResult& result)
+{
+    if (adjustments.empty()) {
+        result.clear();
+        return true;
+    }
+
+    Transaction tx(db_, result, Transaction::Mode::Immediate);
+    if (!tx.isActive())
+        return false;
+
+    int newQuantity = 0;
+    for (const StockAdjustment& line : adjustments) {
+        if (!apply(line.componentId, line.delta, kind, reason, newQuantity, result))
+            return false;
+    }
+
+    if (!tx.commit(result))
+        return false;
+
+    result.clear();
+    return true;
+}
+
+bool StockLedger::history(int componentId, std::vector<StockMovement>& movements,
+    DbResult& result)
+{
+    movements.clear();
+
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "SELECT ID, ComponentID, Kind, Delta, QuantityAfter, Reason, CreatedOn "
+        "FROM StockMovements WHERE ComponentID = ? ORDER BY ID;",
+        stmt, result)) {
+        return false;
+    }
+    sqlite3_bind_int(stmt, 1, componentId);
+
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        StockMovement m;
+        m.id = sqlite3_column_int64(row, 0);
+        m.componentId = sqlite3_column_int(row, 1);
+        m.kind = kindFromName(safeColumnView(row, 2));
+        m.delta = sqlite3_column_int(row, 3);
+        m.quantityAfter = sqlite3_column_int(row, 4);
+        m.reason = safeColumnText(row, 5);
+        m.createdOn = safeColumnText(row, 6);
+        movements.push_back(std::move(m));
+        return true;
+    }, result);
+}
+
+// One movement inside the caller's transaction
+bool StockLedger::apply(int componentId, int delta, StockMovementKind kind,
+    const std::string& reason, int& newQuantity, DbResult& result)
+{
+    if (!deltaFits(kind, delta)) {
+        result.setError(SQLITE_MISUSE, std::string("Invalid quantity change for a ")
+            + kindName(kind) + " movement: " + std::to_string(delta));
+        return false;
+    }
+
+    {
+        // Relative update: no prior read, so no lost updates
+        CachedStatement update;
+        if (!db_.prepareCached(
+            "UPDATE Components SET Quantity = Quantity + ?1 "
+            "WHERE ID = ?2 AND Quantity + ?1 >= 0 RETURNING Quantity;",
+            update, result)) {
+            return false;
+        }
+        sqlite3_bind_int(update, 1, delta);
+        sqlite3_bind_int(update, 2, componentId);
+
+        int rc = sqlite3_step(update);
+        if (rc == SQLITE_ROW) {
+            newQuantity = sqlite3_column_int(update, 0);
+            rc = sqlite3_step(update);
+        }
+        else if (rc == SQLITE_DONE) {
+            // No row: either no such component or not enough stock
+            const std::string id = std::to_string(componentId);
+            if (db_.countRows("Components", "ID = " + id) == 0)
+                result.setError(SQLITE_NOTFOUND, "Component " + id + " not found");
+            else
+                result.setError(SQLITE_CONSTRAINT, "Not enough stock of component " + id
+                    + " for a change of " + std::to_string(delta));
+            return false;
+        }
+        if (rc != SQLITE_DONE) {
+            result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+            return false;
+        }
+    }
+
+    CachedStatement insert;
+    if (!db_.prepareCached(
+        "INSERT INTO StockMovements (ComponentID, Kind, Delta, QuantityAfter, Reason) "
+        "VALUES (?, ?, ?, ?, ?);",
+        insert, result)) {
+        return false;
+    }
+    sqlite3_bind_int(insert, 1, componentId);
+    sqlite3_bind_text(insert, 2, kindName(kind), -1, SQLITE_STATIC);
+    sqlite3_bind_int(insert, 3, delta);
+    sqlite3_bind_int(insert, 4, newQuantity);
+    if (reason.empty())
+        sqlite3_bind_null(insert, 5);
+    else
+        sqlite3_bind_text(insert, 5, reason.c_str(), -1, SQLITE_TRANSIENT);
+
+    if (sqlite3_step(insert) != SQLITE_DONE) {
+        result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+
+    result.clear();
+    return true;
+}
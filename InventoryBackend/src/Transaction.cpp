@@ -0,0 +1,75 @@
+#include "Transaction.h"
+#include "Database.h"
+
+#include <sqlite3.h>
+
+Transaction::Transaction(Database& db, DbResult& result, Mode mode)
+    : db_(db), active_(false)
+{
+    const int depth = db_.transactionDepth_;
+
+    // Nest with a savepoint if a transaction is already open on this
+    // connection, whether it came from another guard or a raw BEGIN.
+    if (depth > 0 || sqlite3_get_autocommit(db_.handle()) == 0) {
+        savepoint_ = "sp_" + std::to_string(depth + 1);
+        if (!db_.exec("SAVEPOINT " + savepoint_ + ";", result)) {
+            savepoint_.clear();
+            return;
+        }
+    }
+    else {
+        const char* sql = (mode == Mode::Immediate) ? "BEGIN IMMEDIATE;" : "BEGIN;";
+        if (!db_.exec(sql, result))
+            return;
+    }
+
+    if (depth == 0)
+        ++db_.transactionSerial_;
+    ++db_.transactionDepth_;
+    active_ = true;
+}
+
+Transaction::~Transaction()
+{
+    rollback();
+}
+
+bool Transaction::commit(DbResult& result)
+{
+    if (!active_) {
+        result.setError(SQLITE_MISUSE, "Transaction is not active");
+        return false;
+    }
+
+    const std::string sql = isNested()
+        ? "RELEASE " + savepoint_ + ";"
+        : "COMMIT;";
+
+    if (!db_.exec(sql, result))
+        return false;
+
+    --db_.transactionDepth_;
+    active_ = false;
+    return true;
+}
+
+void Transaction::rollback()
+{
+    if (!active_)
+        return;
+
+    // Anything cached from rows written in this transaction is now stale.
+    db_.invalidateCaches();
+
+    // Errors are ignored: SQLite may already have rolled the transaction
+    // back on its own (e.g. after SQLITE_FULL), and there is nothing more
+    // useful to do from a destructor.
+    DbResult ignored;
+    if (isNested())
+        db_.exec("ROLLBACK TO " + savepoint_ + "; RELEASE " + savepoint_ + ";", ignored);
+    else
+        db_.exec("ROLLBACK;", ignored);
+
+    --db_.transactionDepth_;
+    active_ = false;
+}
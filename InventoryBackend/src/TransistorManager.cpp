@@ -5,19 +5,30 @@ TransistorManager::TransistorManager(Database& db)
 }
 
 bool TransistorManager::add(const Transistor& t, DbResult& result) {
-    std::string sql =
-        "INSERT INTO Transistors (ComponentID, TypeID, PolarityID, PackageID) VALUES (" +
-        std::to_string(t.componentId) + "," +
-        std::to_string(t.typeId) + "," +
-        std::to_string(t.polarityId) + "," +
-        std::to_string(t.packageId) + ");";
-
-    return db_.exec(sql, result);
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "INSERT INTO Transistors (ComponentID, TypeID, PolarityID, PackageID) "
+        "VALUES (?, ?, ?, ?);",
+        stmt, result))
+        return false;
+
+    sqlite3_bind_int(stmt, 1, t.componentId);
+    sqlite3_bind_int(stmt, 2, t.typeId);
+    sqlite3_bind_int(stmt, 3, t.polarityId);
+    sqlite3_bind_int(stmt, 4, t.packageId);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+
+    result.clear();
+    return true;
 }
 
 bool TransistorManager::getById(int componentId, Transistor& t, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
+    CachedStatement stmt;
+    if (!db_.prepareCached(
         "SELECT ComponentID, TypeID, PolarityID, PackageID "
         "FROM Transistors WHERE ComponentID=?;",
         stmt, result))
@@ -34,33 +45,45 @@ bool TransistorManager::getById(int componentId, Transistor& t, DbResult& result
         ok = true;
     }
 
-    db_.finalize(stmt);
     return ok;
 }
 
 bool TransistorManager::list(std::vector<Transistor>& ts, DbResult& result) {
-    sqlite3_stmt* stmt = nullptr;
-    if (!db_.prepare(
-        "SELECT ComponentID, TypeID, PolarityID, PackageID FROM Transistors;",
+    return forEach([&](const Transistor& t) {
+        ts.push_back(t);
+        return true;
+    }, result);
+}
+
+bool TransistorManager::forEach(const std::function<bool(const Transistor&)>& fn, DbResult& result) {
+    CachedStatement stmt;
+    if (!db_.prepareCached(
+        "SELECT ComponentID, TypeID, PolarityID, PackageID FROM Transistors ORDER BY ComponentID;",
         stmt, result))
         return false;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Transistor t;
-        t.componentId = sqlite3_column_int(stmt, 0);
-        t.typeId = sqlite3_column_int(stmt, 1);
-        t.polarityId = sqlite3_column_int(stmt, 2);
-        t.packageId = sqlite3_column_int(stmt, 3);
-        ts.push_back(t);
-    }
-
-    db_.finalize(stmt);
-    return true;
+    Transistor t;
+    return db_.stepRows(stmt, [&](sqlite3_stmt* row) {
+        t.componentId = sqlite3_column_int(row, 0);
+        t.typeId = sqlite3_column_int(row, 1);
+        t.polarityId = sqlite3_column_int(row, 2);
+        t.packageId = sqlite3_column_int(row, 3);
+        return fn(t);
+    }, result);
 }
 
 bool TransistorManager::remove(int componentId, DbResult& result) {
-    return db_.exec(
-        "DELETE FROM Transistors WHERE ComponentID=" +
-        std::to_string(componentId) + ";",
-        result);
+    CachedStatement stmt;
+    if (!db_.prepareCached("DELETE FROM Transistors WHERE ComponentID=?;", stmt, result))
+        return false;
+
+    sqlite3_bind_int(stmt, 1, componentId);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        result.setError(sqlite3_errcode(db_.handle()), sqlite3_errmsg(db_.handle()));
+        return false;
+    }
+
+    result.clear();
+    return true;
 }
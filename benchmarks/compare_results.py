@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""Compare two google-benchmark JSON files written by the benchmark_json target.
+
+    compare_results.py baseline.json current.json [--threshold 10]
+
+Prints the change in time per iteration for every benchmark present in
+both files and exits with status 1 if any got slower by more than the
+threshold (percent), so it can gate a release or CI job.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    times = {}
+    for b in data["benchmarks"]:
+        # With repetitions only the aggregates are reported; compare medians
+        if b.get("run_type") == "aggregate" and b.get("aggregate_name") != "median":
+            continue
+        if b.get("error_occurred"):
+            continue
+        times[b.get("run_name", b["name"])] = b["real_time"] * unit_scale(b["time_unit"])
+    return times
+
+
+def unit_scale(unit):
+    return {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}[unit]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="percent slowdown reported as a regression (default 10)")
+    args = parser.parse_args()
+
+    old, new = load(args.baseline), load(args.current)
+    common = [name for name in new if name in old]
+    if not common:
+        print("no benchmarks in common", file=sys.stderr)
+        return 2
+
+    width = max(len(name) for name in common)
+    regressions = 0
+    for name in common:
+        change = (new[name] - old[name]) / old[name] * 100.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}}  {old[name]:>14.0f} ns  {new[name]:>14.0f} ns  {change:+7.1f}%{flag}")
+
+    for name in sorted(set(old) - set(new)):
+        print(f"{name:<{width}}  missing from {args.current}")
+
+    print(f"\n{regressions} regression(s) over {args.threshold:g}% in {len(common)} benchmarks")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,104 @@
+#include "BenchmarkSupport.h"
+
+#include "DatasetGenerator.h"
+#include "DbResult.h"
+#include "DbUtils.h"
+#include "SchemaManager.h"
+
+#include <memory>
+
+namespace {
+
+// Migration 8 and 10 secondary indexes
+const char* const kSecondaryIndexes[] = {
+    "idx_Components_PartNumber",
+    "idx_Components_Category_PartNumber",
+    "idx_Components_Manufacturer_PartNumber",
+    "idx_Resistors_PackageTypeID",
+    "idx_Resistors_CompositionID",
+    "idx_Capacitors_PackageTypeID",
+    "idx_Capacitors_DielectricTypeID",
+    "idx_Transistors_TypeID",
+    "idx_Transistors_PolarityID",
+    "idx_Transistors_PackageID",
+    "idx_Fuses_PackageId",
+    "idx_Fuses_TypeId",
+    "idx_Diodes_PackageId",
+    "idx_Diodes_TypeId",
+    "idx_Diodes_PolarityId",
+    "idx_Resistors_Resistance",
+    "idx_Resistors_Package_Resistance",
+    "idx_Capacitors_Capacitance",
+    "idx_Capacitors_Dielectric_Capacitance",
+    "idx_Diodes_MaxReverseVoltage",
+    "idx_Fuses_CurrentRating",
+    "idx_BJTs_VceMax",
+};
+
+struct CachedDb {
+    long long rows = 0;
+    bool indexed = false;
+    std::unique_ptr<Database> db;
+};
+
+} // namespace
+
+Database& benchDatabase(benchmark::State& state, long long rows, bool secondaryIndexes)
+{
+    static CachedDb cached;
+
+    if (cached.db && cached.rows == rows && cached.indexed == secondaryIndexes)
+        return *cached.db;
+
+    cached.db.reset();
+
+    DbResult result;
+    auto db = std::make_unique<Database>(":memory:", result);
+    SchemaManager schema(*db);
+    if (!db->isOpen() || !schema.initialize(result)) {
+        state.SkipWithError(result.toString().c_str());
+        cached.db = std::move(db);
+        return *cached.db;
+    }
+
+    // Drop before loading so the unindexed case is not charged for
+    // maintaining indexes during the insert.
+    if (!secondaryIndexes) {
+        for (const char* name : kSecondaryIndexes)
+            db->exec(std::string("DROP INDEX IF EXISTS ") + name + ";", result);
+    }
+
+    DatasetOptions options;
+    options.rows = rows;
+    options.seed = kBenchSeed;
+    options.batchRows = 100'000;
+    DatasetReport report;
+    if (!DatasetGenerator(*db).generate(options, report, result))
+        state.SkipWithError(result.toString().c_str());
+
+    cached = CachedDb{ rows, secondaryIndexes, std::move(db) };
+    return *cached.db;
+}
+
+std::string benchPartNumber(Database& db, long long id)
+{
+    DbResult result;
+    CachedStatement stmt;
+    if (!db.prepareCached("SELECT PartNumber FROM Components WHERE ID = ?;", stmt, result))
+        return {};
+    sqlite3_bind_int64(stmt, 1, id);
+    return sqlite3_step(stmt) == SQLITE_ROW ? safeColumnText(stmt, 0) : std::string();
+}
+
+std::vector<int> benchSubtypeIds(Database& db, const char* table)
+{
+    DbResult result;
+    std::vector<int> ids;
+    CachedStatement stmt;
+    if (!db.prepareCached(std::string("SELECT ComponentID FROM ") + table + " ORDER BY ComponentID;",
+        stmt, result))
+        return ids;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+        ids.push_back(sqlite3_column_int(stmt, 0));
+    return ids;
+}
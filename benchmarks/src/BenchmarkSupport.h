@@ -0,0 +1,25 @@
+#pragma once
+#include <benchmark/benchmark.h>
+
+#include "Database.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Seed of every benchmark dataset: the same rows on every run and
+// machine, so any number quoted from these benchmarks can be reproduced
+constexpr std::uint64_t kBenchSeed = 1;
+
+// In-memory inventory of `rows` components generated by DatasetGenerator
+// (kBenchSeed, default mix), built once and reused by consecutive runs
+// asking for the same configuration (a 1M-row build takes seconds). IDs
+// run from 1 to rows. With secondaryIndexes false the migration 8 and 10
+// indexes are dropped before loading. Calls state.SkipWithError on failure.
+Database& benchDatabase(benchmark::State& state, long long rows, bool secondaryIndexes = true);
+
+// Part number of the component with this ID; empty if there is none
+std::string benchPartNumber(Database& db, long long id);
+
+// ComponentIDs of the rows in a subtype table ("Resistors", ...), in ID order
+std::vector<int> benchSubtypeIds(Database& db, const char* table);
@@ -0,0 +1,477 @@
+// Per-call cost of the everyday manager operations: ComponentManager and
+// ResistorManager CRUD, lookup name resolution and creating a schema.
+// These are the regression baseline; see benchmarks/compare_results.py.
+//
+// Argument: {rows} of generated inventory, 1k to 1M. Run e.g.
+//     InventoryBackendBenchmarks --benchmark_filter=Crud
+#include "BenchmarkSupport.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "CategoryManager.h"
+#include "ManufacturerManager.h"
+#include "SchemaManager.h"
+#include "StockLedger.h"
+#include "StatsManager.h"
+#include "Transaction.h"
+#include "Database.h"
+#include "DbResult.h"
+#include "InventoryService.h"
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+void rowArgs(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(10)->Range(1'000, 1'000'000)->ArgName("rows");
+}
+
+// Drop rows a benchmark added, so the cached dataset stays at `rows`
+// for the next one
+void trimTo(benchmark::State& state, Database& db, long long rows)
+{
+    DbResult result;
+    const std::string n = std::to_string(rows);
+    if (!db.exec("DELETE FROM Resistors WHERE ComponentID > " + n + ";"
+                 "DELETE FROM Components WHERE ID > " + n + ";", result))
+        state.SkipWithError(result.toString().c_str());
+}
+
+Component newComponent(long long n)
+{
+    return Component("BENCH" + std::to_string(n), "benchmark part", 1, 1, 1);
+}
+
+Resistor newResistor(int componentId)
+{
+    Resistor r;
+    r.componentId = componentId;
+    r.resistance = 4700.0;
+    r.tolerance = 1.0;
+    r.powerRating = 0.25;
+    r.packageTypeId = 1;
+    r.compositionId = 1;
+    return r;
+}
+
+} // namespace
+
+static void BM_CrudComponentAdd(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    long long n = 0;
+    for (auto _ : state) {
+        Component c = newComponent(n++);
+        if (!mgr.add(c, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    trimTo(state, db, state.range(0));
+}
+BENCHMARK(BM_CrudComponentAdd)->Apply(rowArgs);
+
+static void BM_CrudComponentGetById(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<int> pick(1, static_cast<int>(state.range(0)));
+    Component c;
+    for (auto _ : state) {
+        if (!mgr.getById(pick(rng), c, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(c.quantity);
+    }
+}
+BENCHMARK(BM_CrudComponentGetById)->Apply(rowArgs);
+
+// Whole table into a vector; items/s is rows materialised per second
+static void BM_CrudComponentList(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    std::vector<Component> comps;
+    for (auto _ : state) {
+        if (!mgr.list(comps, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(comps.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CrudComponentList)->Apply(rowArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_CrudComponentUpdate(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    std::mt19937_64 rng(2);
+    std::uniform_int_distribution<int> pick(1, static_cast<int>(state.range(0)));
+    Component c;
+    for (auto _ : state) {
+        state.PauseTiming();
+        mgr.getById(pick(rng), c, result);
+        state.ResumeTiming();
+
+        // Same quantity back: the dataset stays as generated
+        if (!mgr.update(c, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+}
+BENCHMARK(BM_CrudComponentUpdate)->Apply(rowArgs);
+
+// Delta stock change plus its ledger row, against the full-row update
+// above (which also needs the getById it leaves untimed)
+static void BM_CrudStockAdjust(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    StockLedger ledger(db);
+    DbResult result;
+
+    std::mt19937_64 rng(2);
+    std::uniform_int_distribution<int> pick(1, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        if (!ledger.adjustQuantity(pick(rng), 1, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+
+    if (!db.exec("DELETE FROM StockMovements;", result))
+        state.SkipWithError(result.toString().c_str());
+}
+BENCHMARK(BM_CrudStockAdjust)->Apply(rowArgs);
+
+// Inventory totals from the trigger-maintained stats tables, against the
+// same numbers aggregated from Components
+static void BM_CrudStatsTotals(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    StatsManager stats(db);
+    DbResult result;
+
+    StockTotals totals;
+    for (auto _ : state) {
+        if (!stats.totals(totals, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(totals);
+    }
+}
+BENCHMARK(BM_CrudStatsTotals)->Apply(rowArgs);
+
+static void BM_CrudStatsScan(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    DbResult result;
+
+    StockTotals totals;
+    for (auto _ : state) {
+        CachedStatement stmt;
+        if (!db.prepareCached(
+            "SELECT COUNT(*), TOTAL(Quantity), TOTAL(Quantity <= 0) FROM Components;",
+            stmt, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            totals.components = sqlite3_column_int64(stmt, 0);
+        benchmark::DoNotOptimize(totals);
+    }
+}
+BENCHMARK(BM_CrudStatsScan)->Apply(rowArgs);
+
+static void BM_CrudComponentRemove(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    long long n = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Component c = newComponent(n++);
+        mgr.add(c, result);
+        state.ResumeTiming();
+
+        if (!mgr.remove(c.id, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+}
+BENCHMARK(BM_CrudComponentRemove)->Apply(rowArgs);
+
+static void BM_CrudResistorAdd(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager components(db);
+    ResistorManager resistors(db);
+    DbResult result;
+
+    long long n = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Component c = newComponent(n++);
+        components.add(c, result);
+        state.ResumeTiming();
+
+        if (!resistors.add(newResistor(c.id), result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    trimTo(state, db, state.range(0));
+}
+BENCHMARK(BM_CrudResistorAdd)->Apply(rowArgs);
+
+static void BM_CrudResistorGetByComponentId(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ResistorManager mgr(db);
+    DbResult result;
+
+    const std::vector<int> ids = benchSubtypeIds(db, "Resistors");
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+    Resistor r;
+    for (auto _ : state) {
+        if (!mgr.getByComponentId(ids[pick(rng)], r, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(r.resistance);
+    }
+}
+BENCHMARK(BM_CrudResistorGetByComponentId)->Apply(rowArgs);
+
+static void BM_CrudResistorUpdate(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ResistorManager mgr(db);
+    DbResult result;
+
+    const std::vector<int> ids = benchSubtypeIds(db, "Resistors");
+    std::mt19937_64 rng(4);
+    std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+    Resistor r;
+    for (auto _ : state) {
+        state.PauseTiming();
+        mgr.getByComponentId(ids[pick(rng)], r, result);
+        state.ResumeTiming();
+
+        if (!mgr.update(r, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+}
+BENCHMARK(BM_CrudResistorUpdate)->Apply(rowArgs);
+
+static void BM_CrudResistorRemove(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager components(db);
+    ResistorManager resistors(db);
+    DbResult result;
+
+    long long n = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Component c = newComponent(n++);
+        components.add(c, result);
+        resistors.add(newResistor(c.id), result);
+        state.ResumeTiming();
+
+        if (!resistors.remove(c.id, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    trimTo(state, db, state.range(0));
+}
+BENCHMARK(BM_CrudResistorRemove)->Apply(rowArgs);
+
+// Purging {purge} components with resistor rows from {rows}: one remove()
+// per ID (one autocommit each) against a single removeMany()
+namespace {
+
+std::vector<int> addPurgeCandidates(Database& db, long long count, long long& n)
+{
+    ComponentManager components(db);
+    ResistorManager resistors(db);
+    DbResult result;
+    Transaction tx(db, result);
+
+    std::vector<int> ids;
+    for (long long i = 0; i < count; ++i) {
+        Component c = newComponent(n++);
+        components.add(c, result);
+        resistors.add(newResistor(c.id), result);
+        ids.push_back(c.id);
+    }
+    tx.commit(result);
+    return ids;
+}
+
+void purgeArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgsProduct({ { 100'000 }, { 1'000, 10'000 } })
+        ->ArgNames({ "rows", "purge" })
+        ->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+static void BM_CrudPurgeOneByOne(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    long long n = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const std::vector<int> ids = addPurgeCandidates(db, state.range(1), n);
+        state.ResumeTiming();
+
+        for (const int id : ids) {
+            if (!mgr.remove(id, result)) {
+                state.SkipWithError(result.toString().c_str());
+                return;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_CrudPurgeOneByOne)->Apply(purgeArgs);
+
+static void BM_CrudPurgeRemoveMany(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    long long n = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const std::vector<int> ids = addPurgeCandidates(db, state.range(1), n);
+        state.ResumeTiming();
+
+        long long removed = 0;
+        if (!mgr.removeMany(ids, removed, result)) {
+            state.SkipWithError(result.toString().c_str());
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_CrudPurgeRemoveMany)->Apply(purgeArgs);
+
+// Name -> ID through the lookup cache; the table size does not matter
+// here, so one dataset is enough
+static void BM_CrudLookupGetIdByName(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, 1'000);
+    ManufacturerManager manufacturers(db);
+    CategoryManager categories(db);
+    DbResult result;
+
+    std::vector<LookupItem> names;
+    manufacturers.listLookup(names, result);
+    if (names.empty()) {
+        state.SkipWithError("no seeded manufacturers");
+        return;
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manufacturers.getIdByName(names[i++ % names.size()].name, result));
+        benchmark::DoNotOptimize(categories.getIdByName("Capacitor", result));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_CrudLookupGetIdByName);
+
+// Fresh in-memory database through every migration, seeds included
+static void BM_CrudSchemaInitialize(benchmark::State& state)
+{
+    DbResult result;
+    for (auto _ : state) {
+        Database db(":memory:", result);
+        SchemaManager schema(db);
+        if (!schema.initialize(result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+}
+BENCHMARK(BM_CrudSchemaInitialize)->Unit(benchmark::kMicrosecond);
+
+static std::string benchStartupPath(bool fresh)
+{
+    auto path = std::filesystem::temp_directory_path() / "inventory_startup_bench.db";
+    if (fresh) {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path.string() + "-wal");
+        std::filesystem::remove(path.string() + "-shm");
+    }
+    return path.string();
+}
+
+// New file: every migration plus the seeded planner statistics in one commit
+static void BM_CrudOpenFreshFile(benchmark::State& state)
+{
+    DbResult result;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::string path = benchStartupPath(true);
+        state.ResumeTiming();
+        auto service = InventoryService::open(path, DatabaseOptions::interactive(), result);
+        if (!service) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    benchStartupPath(true);
+}
+BENCHMARK(BM_CrudOpenFreshFile)->Unit(benchmark::kMicrosecond);
+
+// Existing current file: the schema check is a header read, nothing is written
+static void BM_CrudOpenCurrentFile(benchmark::State& state)
+{
+    DbResult result;
+    std::string path = benchStartupPath(true);
+    if (!InventoryService::open(path, DatabaseOptions::interactive(), result)) {
+        state.SkipWithError(result.toString().c_str());
+        return;
+    }
+    for (auto _ : state) {
+        auto service = InventoryService::open(path, DatabaseOptions::interactive(), result);
+        if (!service) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    benchStartupPath(true);
+}
+BENCHMARK(BM_CrudOpenCurrentFile)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,49 @@
+// Load throughput of DatasetGenerator into a fresh in-memory database,
+// reported as rows/s. Compares the deferred search index rebuild with
+// maintaining ComponentsFts row by row.
+//
+// Arguments: {rows, deferSearchIndex}. Run e.g.
+//     InventoryBackendBenchmarks --benchmark_filter=Generate
+#include <benchmark/benchmark.h>
+
+#include "DatasetGenerator.h"
+#include "SchemaManager.h"
+#include "Database.h"
+#include "DbResult.h"
+
+#include <memory>
+
+namespace {
+
+void BM_GenerateDataset(benchmark::State& state)
+{
+    DatasetOptions options;
+    options.rows = state.range(0);
+    options.deferSearchIndex = state.range(1) != 0;
+
+    std::unique_ptr<Database> db;
+    for (auto _ : state) {
+        state.PauseTiming();
+        DbResult result;
+        db.reset();   // teardown of the previous run stays out of the timing
+        db = std::make_unique<Database>(":memory:", result);
+        if (!SchemaManager(*db).initialize(result)) {
+            state.SkipWithError(result.toString().c_str());
+            return;
+        }
+        state.ResumeTiming();
+
+        DatasetReport report;
+        if (!DatasetGenerator(*db).generate(options, report, result)) {
+            state.SkipWithError(result.toString().c_str());
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * options.rows);
+}
+BENCHMARK(BM_GenerateDataset)
+    ->ArgsProduct({ { 10'000, 100'000 }, { 0, 1 } })
+    ->ArgNames({ "rows", "deferIndex" })
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,90 @@
+// Fetching components with their subtype row and lookup names: one
+// query per part and table (the editors' old pattern) against a single
+// joined batch query.
+//
+// Arguments: {batch}. Run e.g.
+//     InventoryBackendBenchmarks --benchmark_filter=Details
+#include "BenchmarkSupport.h"
+#include "ComponentDetailsManager.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "ResistorPackageManager.h"
+#include "ResistorCompositionManager.h"
+#include "CategoryManager.h"
+#include "DbResult.h"
+
+#include <vector>
+
+namespace {
+
+constexpr long long kRows = 100'000;
+
+// Resistors spread across the table, so neither variant reads pages in
+// order
+std::vector<int> sampleIds(Database& db, long long batch)
+{
+    const std::vector<int> resistors = benchSubtypeIds(db, "Resistors");
+    std::vector<int> ids;
+    if (resistors.empty())
+        return ids;
+    ids.reserve(static_cast<std::size_t>(batch));
+    for (long long i = 0; i < batch; ++i)
+        ids.push_back(resistors[static_cast<std::size_t>((i * 7919) % static_cast<long long>(resistors.size()))]);
+    return ids;
+}
+
+void batchArgs(benchmark::internal::Benchmark* b)
+{
+    for (long long batch : { 100LL, 10'000LL })
+        b->Arg(batch);
+    b->ArgNames({ "batch" });
+}
+
+} // namespace
+
+static void BM_DetailsPerComponent(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, kRows);
+    ComponentManager components(db);
+    ResistorManager resistors(db);
+    CategoryManager categories(db);
+    ResistorPackageManager packages(db);
+    ResistorCompositionManager compositions(db);
+    DbResult result;
+
+    const std::vector<int> ids = sampleIds(db, state.range(0));
+    for (auto _ : state) {
+        for (int id : ids) {
+            Component c;
+            Resistor r;
+            std::string category, package, composition;
+            if (!components.getById(id, c, result) || !resistors.getByComponentId(id, r, result)) {
+                state.SkipWithError(result.toString().c_str());
+                return;
+            }
+            categories.getNameById(c.categoryId, category, result);
+            packages.getNameById(r.packageTypeId, package, result);
+            compositions.getNameById(r.compositionId, composition, result);
+            benchmark::DoNotOptimize(composition.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DetailsPerComponent)->Apply(batchArgs);
+
+static void BM_DetailsBatch(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, kRows);
+    ComponentDetailsManager details(db);
+    DbResult result;
+
+    const std::vector<int> ids = sampleIds(db, state.range(0));
+    std::vector<ComponentDetails> rows;
+    for (auto _ : state) {
+        if (!details.getByIds(ids, rows, result))
+            state.SkipWithError(result.toString().c_str());
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DetailsBatch)->Apply(batchArgs);
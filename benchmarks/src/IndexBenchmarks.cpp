@@ -0,0 +1,129 @@
+// Part-number lookups and deletes with and without the migration 8
+// secondary indexes.
+//
+// Arguments: {rows, indexed}. Run e.g.
+//     InventoryBackendBenchmarks --benchmark_filter=PartNumber
+#include "BenchmarkSupport.h"
+#include "ComponentManager.h"
+#include "ManufacturerManager.h"
+#include "Database.h"
+#include "DbResult.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// {rows, indexed} from the benchmark arguments
+Database& indexedArgsDatabase(benchmark::State& state)
+{
+    return benchDatabase(state, state.range(0), state.range(1) != 0);
+}
+
+void rowArgs(benchmark::internal::Benchmark* b)
+{
+    for (long long rows : { 10'000LL, 1'000'000LL })
+        for (int indexed : { 0, 1 })
+            b->Args({ rows, indexed });
+    b->ArgNames({ "rows", "indexed" });
+}
+
+} // namespace
+
+// Exact part-number match through ComponentManager
+static void BM_FindByPartNumber(benchmark::State& state)
+{
+    Database& db = indexedArgsDatabase(state);
+    ComponentManager mgr(db);
+    DbResult result;
+
+    // Part numbers of random existing rows, looked up before timing
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<long long> pick(1, state.range(0));
+    std::vector<std::string> partNumbers;
+    for (int i = 0; i < 1024; ++i)
+        partNumbers.push_back(benchPartNumber(db, pick(rng)));
+
+    std::vector<Component> found;
+    std::size_t next = 0;
+    for (auto _ : state) {
+        mgr.findByPartNumber(partNumbers[next++ % partNumbers.size()], found, result);
+        benchmark::DoNotOptimize(found.data());
+    }
+}
+BENCHMARK(BM_FindByPartNumber)->Apply(rowArgs);
+
+// Parts of one manufacturer in part-number order (UI filter)
+static void BM_FilterByManufacturer(benchmark::State& state)
+{
+    Database& db = indexedArgsDatabase(state);
+    DbResult result;
+
+    // Makes parts in every generated category but fuses
+    const int manufacturerId = ManufacturerManager(db).getIdByName("Vishay", result);
+    if (manufacturerId <= 0) {
+        state.SkipWithError("Vishay is not a seeded manufacturer");
+        return;
+    }
+
+    for (auto _ : state) {
+        CachedStatement stmt;
+        db.prepareCached(
+            "SELECT ID, PartNumber FROM Components WHERE ManufacturerID = ? "
+            "ORDER BY PartNumber LIMIT 100;", stmt, result);
+        sqlite3_bind_int(stmt, 1, manufacturerId);
+        int n = 0;
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+            ++n;
+        benchmark::DoNotOptimize(n);
+    }
+}
+BENCHMARK(BM_FilterByManufacturer)->Apply(rowArgs);
+
+// Deleting a component cascades to Resistors through its primary key,
+// so this is the control: it should not move with the indexes.
+static void BM_DeleteComponentCascade(benchmark::State& state)
+{
+    Database& db = indexedArgsDatabase(state);
+    ComponentManager mgr(db);
+    DbResult result;
+
+    for (auto _ : state) {
+        Component c("PNDELETE", "Bench delete", 1, 1, 1);
+        mgr.add(c, result);
+        db.exec("INSERT INTO Resistors (ComponentID, Resistance, PackageTypeID) VALUES ("
+            + std::to_string(c.id) + ", 1.0, 1);", result);
+        mgr.remove(c.id, result);
+    }
+}
+BENCHMARK(BM_DeleteComponentCascade)->Apply(rowArgs);
+
+// Deleting a lookup row makes SQLite prove no child row references it:
+// a full scan of Resistors without idx_Resistors_Package_Resistance.
+static void BM_DeleteUnusedPackage(benchmark::State& state)
+{
+    Database& db = indexedArgsDatabase(state);
+    DbResult result;
+    db.exec("PRAGMA foreign_keys = ON;", result);
+
+    for (auto _ : state) {
+        db.exec("INSERT INTO ResistorPackage (Name) VALUES ('Bench package');", result);
+        db.exec("DELETE FROM ResistorPackage WHERE Name = 'Bench package';", result);
+    }
+}
+BENCHMARK(BM_DeleteUnusedPackage)->Apply(rowArgs);
+
+// Same check against Components.CategoryID
+static void BM_DeleteUnusedCategory(benchmark::State& state)
+{
+    Database& db = indexedArgsDatabase(state);
+    DbResult result;
+    db.exec("PRAGMA foreign_keys = ON;", result);
+
+    for (auto _ : state) {
+        db.exec("INSERT INTO Categories (Name) VALUES ('Bench category');", result);
+        db.exec("DELETE FROM Categories WHERE Name = 'Bench category';", result);
+    }
+}
+BENCHMARK(BM_DeleteUnusedCategory)->Apply(rowArgs);
@@ -0,0 +1,68 @@
+// Parametric resistor searches with and without the migration 10
+// composite indexes.
+//
+// Arguments: {rows, indexed}. Run e.g.
+//     InventoryBackendBenchmarks --benchmark_filter=Parametric
+#include "BenchmarkSupport.h"
+#include "Database.h"
+#include "DbResult.h"
+#include "ParametricQuery.h"
+#include "ResistorManager.h"
+
+#include <vector>
+
+namespace {
+
+void rowArgs(benchmark::internal::Benchmark* b)
+{
+    for (long long rows : { 10'000LL, 1'000'000LL })
+        for (int indexed : { 0, 1 })
+            b->Args({ rows, indexed });
+    b->ArgNames({ "rows", "indexed" });
+}
+
+} // namespace
+
+// 10k +/- 5 %, <= 1 % tolerance, >= 1/8 W in 0805: the typical
+// "find me a substitute" query. Package equality plus a resistance range.
+static void BM_ParametricResistorSubstitute(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0), state.range(1) != 0);
+    ResistorManager mgr(db);
+    DbResult result;
+
+    ResistorQuery q;
+    q.between(ResistorField::Resistance, 9.5e3, 10.5e3)
+     .atMost(ResistorField::Tolerance, 1.0)
+     .atLeast(ResistorField::PowerRating, 0.125)
+     .is(ResistorField::Package, "0805");
+
+    std::vector<int> ids;
+    for (auto _ : state) {
+        if (!mgr.find(q, ids, result))
+            state.SkipWithError(result.toString().c_str());
+        benchmark::DoNotOptimize(ids.data());
+    }
+    state.counters["matches"] = static_cast<double>(ids.size());
+}
+BENCHMARK(BM_ParametricResistorSubstitute)->Apply(rowArgs);
+
+// Resistance range alone, any package
+static void BM_ParametricResistanceRange(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0), state.range(1) != 0);
+    ResistorManager mgr(db);
+    DbResult result;
+
+    ResistorQuery q;
+    q.between(ResistorField::Resistance, 4.7e3, 4.9e3);
+
+    std::vector<int> ids;
+    for (auto _ : state) {
+        if (!mgr.find(q, ids, result))
+            state.SkipWithError(result.toString().c_str());
+        benchmark::DoNotOptimize(ids.data());
+    }
+    state.counters["matches"] = static_cast<double>(ids.size());
+}
+BENCHMARK(BM_ParametricResistanceRange)->Apply(rowArgs);
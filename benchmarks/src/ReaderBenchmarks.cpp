@@ -0,0 +1,100 @@
+// Concurrent reads on a WAL file database: every thread funnelled through
+// the service's single connection (serialised by a mutex, as the managers
+// are not thread-safe) against one pooled read connection per thread.
+//
+// Run with threads 1..8, e.g.
+//     InventoryBackendBenchmarks --benchmark_filter=Readers
+#include "BenchmarkSupport.h"
+#include "InventoryService.h"
+#include "DbResult.h"
+
+#include <filesystem>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr long long kRows = 100'000;
+constexpr int kLookupsPerIteration = 100;
+
+// The generated inventory copied to a temp file and opened once for all
+// threads (static initialisation is thread-safe)
+InventoryService* benchService(benchmark::State& state)
+{
+    static std::unique_ptr<InventoryService> service = [&] {
+        auto path = std::filesystem::temp_directory_path() / "inventory_reader_bench.db";
+        std::filesystem::remove(path);
+        std::filesystem::remove(path.string() + "-wal");
+        std::filesystem::remove(path.string() + "-shm");
+
+        DbResult result;
+        if (!benchDatabase(state, kRows).exec("VACUUM INTO '" + path.string() + "';", result))
+            return std::unique_ptr<InventoryService>();
+        auto opened = InventoryService::open(path.string(), DatabaseOptions::interactive(), result);
+        if (opened)
+            opened->configureReaders(8, DatabaseOptions::readOnlyReporting());
+        return opened;
+    }();
+    if (!service)
+        state.SkipWithError("could not create the benchmark database");
+    return service.get();
+}
+
+bool lookupBatch(ComponentManager& components, std::mt19937_64& rng, DbResult& result)
+{
+    std::uniform_int_distribution<int> pick(1, static_cast<int>(kRows));
+    Component c;
+    for (int i = 0; i < kLookupsPerIteration; ++i) {
+        if (!components.getById(pick(rng), c, result))
+            return false;
+    }
+    benchmark::DoNotOptimize(c.quantity);
+    return true;
+}
+
+} // namespace
+
+static void BM_ReadersSharedConnection(benchmark::State& state)
+{
+    static std::mutex connectionMutex;
+    InventoryService* service = benchService(state);
+    if (!service)
+        return;
+
+    std::mt19937_64 rng(state.thread_index() + 1);
+    DbResult result;
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        if (!lookupBatch(service->components(), rng, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kLookupsPerIteration);
+}
+BENCHMARK(BM_ReadersSharedConnection)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ReadersPooled(benchmark::State& state)
+{
+    InventoryService* service = benchService(state);
+    if (!service)
+        return;
+
+    DbResult result;
+    ReadSession session;
+    if (!service->readSession(session, result)) {
+        state.SkipWithError(result.toString().c_str());
+        return;
+    }
+
+    std::mt19937_64 rng(state.thread_index() + 1);
+    for (auto _ : state) {
+        if (!lookupBatch(session->components(), rng, result)) {
+            state.SkipWithError(result.toString().c_str());
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kLookupsPerIteration);
+}
+BENCHMARK(BM_ReadersPooled)->ThreadRange(1, 8)->UseRealTime();
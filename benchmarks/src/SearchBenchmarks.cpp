@@ -0,0 +1,92 @@
+// Full-text search (ComponentsFts) against the LIKE scan it replaces.
+//
+// Argument: {rows}. Run e.g.
+//     InventoryBackendBenchmarks --benchmark_filter=Search
+#include "BenchmarkSupport.h"
+#include "ComponentManager.h"
+#include "Database.h"
+#include "DbResult.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+void rowArgs(benchmark::internal::Benchmark* b)
+{
+    b->Arg(10'000)->Arg(1'000'000)->ArgName("rows");
+}
+
+// Generated part numbers end in an 8-digit serial, one per row
+// ("R0805-4K70-F-00012345"). Its first seven digits match ten rows.
+std::string serialPrefix(long long n)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%07lld", n);
+    return buf;
+}
+
+} // namespace
+
+// Part-number serial prefix matching ten rows ("0001234" -> 00012340..49)
+static void BM_SearchPartNumberPrefix(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<long long> pick(1, state.range(0) / 10 - 1);
+    std::vector<Component> found;
+
+    for (auto _ : state) {
+        const std::string prefix = serialPrefix(pick(rng));
+        mgr.search(prefix, 50, found, result);
+        benchmark::DoNotOptimize(found.data());
+    }
+}
+BENCHMARK(BM_SearchPartNumberPrefix)->Apply(rowArgs);
+
+// Two-word description search, top 50 by rank
+static void BM_SearchDescriptionWords(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    ComponentManager mgr(db);
+    DbResult result;
+    std::vector<Component> found;
+
+    for (auto _ : state) {
+        mgr.search("obsol stock", 50, found, result);
+        benchmark::DoNotOptimize(found.data());
+    }
+}
+BENCHMARK(BM_SearchDescriptionWords)->Apply(rowArgs);
+
+// Baseline: what a substring filter costs without the FTS index
+static void BM_LikeScanPartNumber(benchmark::State& state)
+{
+    Database& db = benchDatabase(state, state.range(0));
+    DbResult result;
+
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<long long> pick(1, state.range(0) / 10 - 1);
+
+    for (auto _ : state) {
+        const std::string prefix = serialPrefix(pick(rng));
+
+        CachedStatement stmt;
+        db.prepareCached(
+            "SELECT ID FROM Components "
+            "WHERE PartNumber LIKE '%' || ? || '%' OR Description LIKE '%' || ? || '%' "
+            "LIMIT 50;", stmt, result);
+        sqlite3_bind_text(stmt, 1, prefix.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, prefix.c_str(), -1, SQLITE_TRANSIENT);
+        int n = 0;
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+            ++n;
+        benchmark::DoNotOptimize(n);
+    }
+}
+BENCHMARK(BM_LikeScanPartNumber)->Apply(rowArgs);
@@ -6,11 +6,15 @@
 #include <string>
 
 class DbResult;
+class QDialogButtonBox;
 
 class AddLookupDialog : public QDialog {
     Q_OBJECT
 public:
-    using AddFn = std::function<bool(const std::string&, DbResult&)>;
+    // Starts adding the name (e.g. on the DB worker thread) and reports
+    // back through done, called on the GUI thread
+    using DoneFn = std::function<void(const DbResult&)>;
+    using AddFn = std::function<void(const std::string&, DoneFn)>;
 
     AddLookupDialog(
         const QString& title,
@@ -24,8 +28,11 @@ private slots:
     void onAddClicked();
 
 private:
+    void onAddFinished(const std::string& name, const DbResult& res);
+
     AddFn addFn_;
     std::string addedName_;
 
     QLineEdit* nameEdit_;
+    QDialogButtonBox* buttons_;
 };
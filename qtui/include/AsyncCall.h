@@ -0,0 +1,27 @@
+#pragma once
+
+#include "AsyncInventoryService.h"
+
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QPointer>
+
+#include <utility>
+
+// Run work(InventoryService*) on the backend's worker thread, then call
+// done(result) on the GUI thread. done is dropped if context has been
+// destroyed by then, so dialogs may close while a request is in flight.
+template <class Work, class Done>
+void runAsync(AsyncInventoryService& backend, QObject* context, Work work, Done done)
+{
+    QPointer<QObject> guard(context);
+    backend.post([guard, work = std::move(work), done = std::move(done)](InventoryService* service) mutable {
+        auto value = work(service);
+        QMetaObject::invokeMethod(QCoreApplication::instance(),
+            [guard, done, value = std::move(value)]() mutable {
+                if (guard)
+                    done(std::move(value));
+            },
+            Qt::QueuedConnection);
+    });
+}
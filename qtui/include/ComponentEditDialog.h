@@ -1,8 +1,10 @@
 #pragma once
 
 #include "ComponentManager.h"
+#include "ComponentDetailsManager.h"
 #include "ResistorManager.h"
 #include "editors/IComponentEditor.h"
+#include "AddLookupDialog.h"
 #include <QDialog>
 #include <memory>
 
@@ -10,20 +12,27 @@ namespace Ui {
     class ComponentEditDialog;
 }
 
-class InventoryService;
+class ReadConnection;
 
 class ComponentEditDialog : public QDialog
 {
     Q_OBJECT
 
 public:
-    explicit ComponentEditDialog(
-        InventoryService& inventory,
+    // Lookups are read synchronously from a pooled read connection; new
+    // manufacturers are written through addManufacturer.
+    ComponentEditDialog(
+        ReadConnection& inventory,
+        AddLookupDialog::AddFn addManufacturer,
         QWidget* parent = nullptr
     );
     ~ComponentEditDialog() override;
 
     void setComponent(const Component& c);
+
+    // Edit an existing component; the type editor is filled from the
+    // subtype part of details instead of re-querying it.
+    void setDetails(const ComponentDetails& details);
     Component component() const;
 	Resistor resistor() const { return resistor_; }
     IComponentEditor* typeEditor() const { return typeEditor_.get(); }
@@ -48,8 +57,10 @@ private:
     };
 
     Ui::ComponentEditDialog* ui_;
-    InventoryService& inventory_;
+    ReadConnection& inventory_;
+    AddLookupDialog::AddFn addManufacturer_;
     Component component_;
+    ComponentDetails details_;
 	Resistor resistor_;
 
     static constexpr int kAddNewId = -1;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QAbstractTableModel>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 #include "ComponentManager.h"
 
@@ -9,6 +11,12 @@ class ComponentTableModel : public QAbstractTableModel
     Q_OBJECT
 
 public:
+    // Supplies the next page of rows; see ComponentManager::listPage
+    using PageFetcher = std::function<bool(ComponentPageCursor& cursor, int pageSize,
+        std::vector<Component>& page, DbResult& result)>;
+
+    static constexpr int kDefaultPageSize = 500;
+
     explicit ComponentTableModel(QObject* parent = nullptr);
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -17,13 +25,40 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
 
     void setComponents(std::vector<Component>&& comps);
+
+    // Reset the model to an empty, lazily filled table. Rows are pulled
+    // one page at a time as the view scrolls (canFetchMore/fetchMore).
+    void setPageSource(PageFetcher fetcher, ComponentOrder order = ComponentOrder::ById,
+        int pageSize = kDefaultPageSize);
+
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    // Apply a single changed row without resetting the model, so the
+    // view keeps its selection and scroll position. Rows that sort past
+    // the loaded range are left for fetchMore to bring in. A list set with
+    // setComponents (search results) only refreshes rows it already holds.
+    void upsertComponent(const Component& comp);
+    void removeComponent(int componentId);
+    // Bulk form: one row-removal signal per run of adjacent rows
+    void removeComponents(const std::vector<int>& componentIds);
+    int rowOf(int componentId) const;
     int componentIdAt(int row) const;
 
     void setCategoryLookup(std::unordered_map<int, QString> lookup);
     void setManufacturerLookup(std::unordered_map<int, QString> lookup);
 
+signals:
+    void fetchFailed(const QString& message);
+
 private:
+    bool sortsBefore(const Component& a, const Component& b) const;
+    void insertSorted(const Component& comp);
+
     std::vector<Component> components_;
+    PageFetcher fetcher_;
+    ComponentPageCursor cursor_;
+    int pageSize_ = kDefaultPageSize;
     std::unordered_map<int, QString> categoryNames_;
     std::unordered_map<int, QString> manufacturerNames_;
 };
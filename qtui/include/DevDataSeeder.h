@@ -3,5 +3,6 @@
 
 namespace DevDataSeeder
 {
-    void seedComponents(Database& db);
+    // Fill an empty database with `rows` synthetic parts (DatasetGenerator)
+    void seedComponents(Database& db, long long rows = 1000);
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "IComponentEditor.h"
-#include "InventoryService.h"
+#include "ReaderPool.h"
 #include "CapacitorManager.h"
 #include "DbResult.h"
 #include <QWidget>
@@ -14,11 +14,11 @@ class CapacitorEditor : public QWidget, public IComponentEditor {
     Q_OBJECT
 
 public:
-    explicit CapacitorEditor(InventoryService& inventory, QWidget* parent = nullptr);
+    explicit CapacitorEditor(ReadConnection& inventory, QWidget* parent = nullptr);
     ~CapacitorEditor() override;
 
     QWidget* widget() override { return this; }
-    void load(int componentId) override;
+    void load(const ComponentDetails& details) override;
     bool collect(int componentId, DbResult& result) override;
 
     const Capacitor& capacitor() const { return capacitor_; }
@@ -31,7 +31,7 @@ private:
     void setGeometryModeFromPackage(const QString& pkgName);
 
 private:
-    InventoryService& inventory_;
+    ReadConnection& inventory_;
     Ui::CapacitorEditor* ui_;
     Capacitor capacitor_;
 };
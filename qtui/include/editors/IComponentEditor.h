@@ -2,6 +2,7 @@
 
 #include <QWidget>
 #include "DbResult.h"
+#include "ComponentDetailsManager.h"
 
 class IComponentEditor {
 public:
@@ -9,6 +10,8 @@ public:
 
     // Root widget that will be embedded in ComponentEditDialog
     virtual QWidget* widget() = 0;
-    virtual void load(int componentId) = 0;
+    // Fill the fields from an already-fetched component; editors must not
+    // query their subtype row themselves.
+    virtual void load(const ComponentDetails& details) = 0;
     virtual bool collect(int componentId, DbResult& result) = 0;
 };
@@ -3,7 +3,7 @@
 #include "IComponentEditor.h"
 #include "ResistorManager.h"
 #include "DbResult.h"
-#include "InventoryService.h"
+#include "ReaderPool.h"
 #include <vector>
 #include <QWidget>
 
@@ -15,17 +15,17 @@ class ResistorEditor : public QWidget, public IComponentEditor {
     Q_OBJECT
 
 public:
-    explicit ResistorEditor(InventoryService& inventory, QWidget* parent = nullptr);
+    explicit ResistorEditor(ReadConnection& inventory, QWidget* parent = nullptr);
     ~ResistorEditor() override;
 
     QWidget* widget() override { return this; }
-    void load(int componentId) override;
+    void load(const ComponentDetails& details) override;
 	bool collect(int componentId, DbResult& result) override;
 	const Resistor& resistor() const { return resistor_; }
 
 private:
     void populateLookups();
-    InventoryService& inventory_;
+    ReadConnection& inventory_;
     Ui::ResistorEditor* ui_;
     Resistor resistor_;
 };
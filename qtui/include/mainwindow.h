@@ -3,15 +3,21 @@
 #include "Database.h"
 #include "DbResult.h"
 #include "ComponentTableModel.h"
+#include "AsyncInventoryService.h"
+#include "AddLookupDialog.h"
 #include <memory>
 #include <QMainWindow>
 #include <QCloseEvent>
 
+class QLabel;
+class QLineEdit;
+class QTimer;
+
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
-class InventoryService;
+class IComponentEditor;
 
 class MainWindow : public QMainWindow
 {
@@ -21,7 +27,12 @@ public:
     explicit MainWindow(QWidget* parent = nullptr);
     ~MainWindow();
 private:
-    std::unique_ptr<InventoryService> inventory_;
+    // All writes and slow reads run on the backend's worker thread so the
+    // window never waits on SQLite. reader_ is the GUI thread's own read
+    // connection for lookups and table paging; it is released before the
+    // backend closes the database that owns it.
+    AsyncInventoryService backend_;
+    ReadSession reader_;
 protected:
     void closeEvent(QCloseEvent* event) override;
     bool eventFilter(QObject* obj, QEvent* event) override;
@@ -36,6 +47,7 @@ private slots:
     void onActionDeleteComponent();
     void onActionAddTestComponent();
 	void onActionEditComponent();
+    void onSearchTextChanged();
 
 private:
     Ui::MainWindow* ui;
@@ -47,12 +59,28 @@ private:
     ComponentTableModel* componentModel_ = nullptr;
     void clearComponentView();
 
+    // Search box (ComponentManager::search); empty text shows all rows
+    QLineEdit* searchEdit_ = nullptr;
+    QTimer* searchTimer_ = nullptr;
+    static constexpr int kSearchLimit = 500;
+    quint64 searchGeneration_ = 0;   // results of older searches are dropped
+    void applySearch();
+
+    // Inventory totals in the status bar (StatsManager, constant time)
+    QLabel* stockLabel_ = nullptr;
+    void refreshStockTotals();
+
     void reloadComponents();
+    void reloadLookups();
+    void editComponent(const ComponentDetails& details);
+    void saveComponent(const Component& c, IComponentEditor* editor, bool isNew);
+    AddLookupDialog::AddFn manufacturerAdder();
 
     // Helpers
     bool createNewDatabase(const QString& fileName);
     bool openExistingDatabase(const QString& fileName);
-    bool openDatabase(const QString& fileName);
+    void openDatabase(const QString& fileName);
+    bool opening_ = false;
 	bool closeDatabase();
     void enableDatabaseActions();
     void disableDatabaseActions();
@@ -5,6 +5,7 @@
 #include <QLineEdit>
 #include <QDialogButtonBox>
 #include <QMessageBox>
+#include <QPointer>
 
 AddLookupDialog::AddLookupDialog(
     const QString& title,
@@ -20,30 +21,43 @@ AddLookupDialog::AddLookupDialog(
     nameEdit_ = new QLineEdit(this);
     nameEdit_->setPlaceholderText(tr("Enter name"));
 
-    auto* buttons = new QDialogButtonBox(
+    buttons_ = new QDialogButtonBox(
         QDialogButtonBox::Ok | QDialogButtonBox::Cancel,
         this
     );
 
-    connect(buttons, &QDialogButtonBox::accepted,
+    connect(buttons_, &QDialogButtonBox::accepted,
         this, &AddLookupDialog::onAddClicked);
-    connect(buttons, &QDialogButtonBox::rejected,
+    connect(buttons_, &QDialogButtonBox::rejected,
         this, &QDialog::reject);
 
     auto* layout = new QGridLayout(this);
     layout->addWidget(nameLabel, 0, 0);
     layout->addWidget(nameEdit_, 0, 1);
-    layout->addWidget(buttons, 1, 0, 1, 2);
+    layout->addWidget(buttons_, 1, 0, 1, 2);
 
     nameEdit_->setFocus();
 }
 
 void AddLookupDialog::onAddClicked()
 {
-    DbResult res;
     const std::string name = nameEdit_->text().toStdString();
 
-    if (!addFn_(name, res)) {
+    // Keep the dialog responsive but ignore a second click while the
+    // insert is queued
+    buttons_->setEnabled(false);
+    QPointer<AddLookupDialog> self(this);
+    addFn_(name, [self, name](const DbResult& res) {
+        if (self)
+            self->onAddFinished(name, res);
+    });
+}
+
+void AddLookupDialog::onAddFinished(const std::string& name, const DbResult& res)
+{
+    buttons_->setEnabled(true);
+
+    if (!res.ok()) {
         QMessageBox::warning(
             this,
             tr("Error"),
@@ -1,7 +1,7 @@
 
 #include "ComponentEditDialog.h"
 #include "ui_ComponentEditDialog.h"
-#include "InventoryService.h"
+#include "ReaderPool.h"
 #include "AddLookupDialog.h"
 #include "DbResult.h"
 #include "editors/ResistorEditor.h"
@@ -14,12 +14,14 @@
 #include <QPushButton>
 
 ComponentEditDialog::ComponentEditDialog(
-    InventoryService& inventory,
+    ReadConnection& inventory,
+    AddLookupDialog::AddFn addManufacturer,
     QWidget* parent
 )
     : QDialog(parent),
     ui_(new Ui::ComponentEditDialog),
-    inventory_(inventory)
+    inventory_(inventory),
+    addManufacturer_(std::move(addManufacturer))
 {
     ui_->setupUi(this);
     setWindowTitle(tr("Add Component"));
@@ -61,7 +63,7 @@ ComponentEditDialog::ComponentEditDialog(
 
     // Load subtype data if editing an existing component
     if (typeEditor_ && component_.id > 0)
-        typeEditor_->load(component_.id);
+        typeEditor_->load(details_);
 
     // Live validation
     connect(ui_->partNumberEdit, &QLineEdit::textChanged,
@@ -89,7 +91,18 @@ ComponentEditDialog::~ComponentEditDialog()
 
 void ComponentEditDialog::setComponent(const Component& c)
 {
-    component_ = c;
+    ComponentDetails details;
+    details.component = c;
+    setDetails(details);
+}
+
+void ComponentEditDialog::setDetails(const ComponentDetails& details)
+{
+    // Set before touching the combos: a category change reloads the
+    // type editor from details_
+    details_ = details;
+    component_ = details.component;
+    const Component& c = component_;
 
     ui_->partNumberEdit->setText(QString::fromStdString(c.partNumber));
     ui_->descriptionEdit->setText(QString::fromStdString(c.description));
@@ -112,7 +125,7 @@ void ComponentEditDialog::setComponent(const Component& c)
 
     // Let type editor load subtype fields
     if (typeEditor_)
-        typeEditor_->load(c.id); // use component ID
+        typeEditor_->load(details_);
 
     QTimer::singleShot(0, this, [this]() { adjustSize(); });
 }
@@ -266,7 +279,7 @@ void ComponentEditDialog::onCategoryChanged(int index)
 
     // Let the editor load subtype fields (if a component is already set)
     if (typeEditor_ && component_.id > 0)                 // slightly safer
-        typeEditor_->load(component_.id);
+        typeEditor_->load(details_);
 
     QTimer::singleShot(0, this, [this]() { adjustSize(); });
 }
@@ -282,13 +295,7 @@ void ComponentEditDialog::onManufacturerChanged(int index)
         return;
     }
 
-    AddLookupDialog dlg(
-        tr("Add Manufacturer"),
-        [&](const std::string& name, DbResult& r) {
-            return inventory_.manufacturers().addByName(name, r);
-        },
-        this
-    );
+    AddLookupDialog dlg(tr("Add Manufacturer"), addManufacturer_, this);
 
     if (dlg.exec() == QDialog::Accepted) {
         populateLookups();
@@ -1,4 +1,8 @@
 #include "ComponentTableModel.h"
+#include "DbUtils.h"
+
+#include <algorithm>
+#include <unordered_set>
 
 ComponentTableModel::ComponentTableModel(QObject* parent)
     : QAbstractTableModel(parent)
@@ -8,10 +12,151 @@ ComponentTableModel::ComponentTableModel(QObject* parent)
 void ComponentTableModel::setComponents(std::vector<Component>&& comps)
 {
     beginResetModel();
+    fetcher_ = nullptr;
+    cursor_ = ComponentPageCursor{};
     components_ = std::move(comps);
     endResetModel();
 }
 
+void ComponentTableModel::setPageSource(PageFetcher fetcher, ComponentOrder order, int pageSize)
+{
+    beginResetModel();
+    fetcher_ = std::move(fetcher);
+    cursor_ = ComponentPageCursor{};
+    cursor_.order = order;
+    pageSize_ = pageSize > 0 ? pageSize : kDefaultPageSize;
+    components_.clear();
+    endResetModel();
+}
+
+bool ComponentTableModel::canFetchMore(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return false;
+    return fetcher_ && !cursor_.atEnd;
+}
+
+void ComponentTableModel::fetchMore(const QModelIndex& parent)
+{
+    if (!canFetchMore(parent))
+        return;
+
+    std::vector<Component> page;
+    DbResult result;
+    if (!fetcher_(cursor_, pageSize_, page, result)) {
+        // Stop fetching so the view does not retry in a loop
+        cursor_.atEnd = true;
+        emit fetchFailed(QString::fromStdString(result.toString()));
+        return;
+    }
+    if (page.empty())
+        return;
+
+    const int first = static_cast<int>(components_.size());
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(page.size()) - 1);
+    components_.insert(components_.end(),
+        std::make_move_iterator(page.begin()),
+        std::make_move_iterator(page.end()));
+    endInsertRows();
+}
+
+bool ComponentTableModel::sortsBefore(const Component& a, const Component& b) const
+{
+    if (cursor_.order == ComponentOrder::ByPartNumber) {
+        const int cmp = compareNoCase(a.partNumber, b.partNumber);
+        if (cmp != 0)
+            return cmp < 0;
+    }
+    return a.id < b.id;
+}
+
+void ComponentTableModel::insertSorted(const Component& comp)
+{
+    auto pos = std::lower_bound(components_.begin(), components_.end(), comp,
+        [this](const Component& a, const Component& b) { return sortsBefore(a, b); });
+
+    // Past the last loaded row while more pages remain: the next
+    // fetchMore will return it, so inserting now would duplicate it.
+    if (pos == components_.end() && canFetchMore(QModelIndex()))
+        return;
+
+    const int row = static_cast<int>(pos - components_.begin());
+    beginInsertRows(QModelIndex(), row, row);
+    components_.insert(pos, comp);
+    endInsertRows();
+}
+
+void ComponentTableModel::upsertComponent(const Component& comp)
+{
+    // A fixed list (search results) is in relevance order and only holds
+    // rows that matched the query: refresh rows it has, add none
+    const bool fixedList = !fetcher_;
+
+    const int row = rowOf(comp.id);
+    if (row < 0) {
+        if (!fixedList)
+            insertSorted(comp);
+        return;
+    }
+
+    Component& existing = components_[row];
+    const bool keyChanged = !fixedList && cursor_.order == ComponentOrder::ByPartNumber
+        && compareNoCase(existing.partNumber, comp.partNumber) != 0;
+
+    if (!keyChanged) {
+        existing = comp;
+        emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+        return;
+    }
+
+    // Sort key moved: take the row out and put it back in order
+    beginRemoveRows(QModelIndex(), row, row);
+    components_.erase(components_.begin() + row);
+    endRemoveRows();
+    insertSorted(comp);
+}
+
+void ComponentTableModel::removeComponent(int componentId)
+{
+    const int row = rowOf(componentId);
+    if (row < 0)
+        return;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    components_.erase(components_.begin() + row);
+    endRemoveRows();
+}
+
+void ComponentTableModel::removeComponents(const std::vector<int>& componentIds)
+{
+    const std::unordered_set<int> doomed(componentIds.begin(), componentIds.end());
+
+    // Walk up from the bottom so earlier row numbers stay valid
+    int row = static_cast<int>(components_.size()) - 1;
+    while (row >= 0) {
+        if (!doomed.count(components_[row].id)) {
+            --row;
+            continue;
+        }
+
+        const int last = row;
+        while (row > 0 && doomed.count(components_[row - 1].id))
+            --row;
+
+        beginRemoveRows(QModelIndex(), row, last);
+        components_.erase(components_.begin() + row, components_.begin() + last + 1);
+        endRemoveRows();
+        --row;
+    }
+}
+
+int ComponentTableModel::rowOf(int componentId) const
+{
+    auto it = std::find_if(components_.begin(), components_.end(),
+        [componentId](const Component& c) { return c.id == componentId; });
+    return it == components_.end() ? -1 : static_cast<int>(it - components_.begin());
+}
+
 int ComponentTableModel::componentIdAt(int row) const
 {
     if (row < 0 || row >= static_cast<int>(components_.size()))
@@ -22,17 +167,17 @@ int ComponentTableModel::componentIdAt(int row) const
 void ComponentTableModel::setCategoryLookup(
     std::unordered_map<int, QString> lookup)
 {
-    beginResetModel();
     categoryNames_ = std::move(lookup);
-    endResetModel();
+    if (!components_.empty())
+        emit dataChanged(index(0, 1), index(rowCount() - 1, 1));
 }
 
 void ComponentTableModel::setManufacturerLookup(
     std::unordered_map<int, QString> lookup)
 {
-    beginResetModel();
     manufacturerNames_ = std::move(lookup);
-    endResetModel();
+    if (!components_.empty())
+        emit dataChanged(index(0, 3), index(rowCount() - 1, 3));
 }
 
 int ComponentTableModel::rowCount(const QModelIndex&) const
@@ -1,35 +1,21 @@
 #include "DevDataSeeder.h"
-#include "ComponentManager.h"
+#include "DatasetGenerator.h"
 #include "DbResult.h"
 
-void DevDataSeeder::seedComponents(Database& db)
+void DevDataSeeder::seedComponents(Database& db, long long rows)
 {
-    DbResult res;
-    ComponentManager compMgr(db);
-
     // Guard: do not reseed if data exists
     if (db.countRows("Components", "") > 0)
         return;
 
-    // These IDs must exist (Categories, Manufacturers)
-    // You already create them in SchemaManager / test fixture
-    int catId = 1;
-    int manId = 1;
+    // Same seed every time, so every developer sees the same parts
+    DatasetOptions options;
+    options.rows = rows;
 
-    // Create named Component objects so add can update comp.id
-    Component c1("PN123", "Test component", catId, manId, 10, "Notes");
-    if (!compMgr.add(c1, res)) {
+    DatasetGenerator generator(db);
+    DatasetReport report;
+    DbResult res;
+    if (!generator.generate(options, report, res)) {
         // handle error or at least log / ignore for test seeding
     }
-
-    Component c2("PN456", "Another test component", catId, manId, 5, "More notes");
-    if (!compMgr.add(c2, res)) {
-        // handle error
-    }
-
-    Component c3("PN789", "To be updated", catId, manId, 1, "Old notes");
-    if (!compMgr.add(c3, res)) {
-        // handle error
-    }
 }
-
@@ -2,12 +2,12 @@
 #include "CapacitorManager.h"
 #include "CapacitorPackageManager.h"
 #include "CapacitorDielectricManager.h"
-#include "InventoryService.h"
+#include "ReaderPool.h"
 #include "ui_CapacitorEditor.h"
 
 #include <QComboBox>
 
-CapacitorEditor::CapacitorEditor(InventoryService& inventory, QWidget* parent)
+CapacitorEditor::CapacitorEditor(ReadConnection& inventory, QWidget* parent)
     : QWidget(parent),
     inventory_(inventory),
     ui_(new Ui::CapacitorEditor)
@@ -52,15 +52,15 @@ void CapacitorEditor::populateLookups()
 }
 
 //
-// Load capacitor from DB
+// Load capacitor fields from fetched details
 //
-void CapacitorEditor::load(int componentId)
+void CapacitorEditor::load(const ComponentDetails& details)
 {
     capacitor_ = Capacitor(); // reset
-    DbResult result;
 
     // If no capacitor row exists, clear UI and return
-    if (!inventory_.capacitors().getById(componentId, capacitor_, result)) {
+    const CapacitorDetails* cd = details.as<CapacitorDetails>();
+    if (!cd) {
         ui_->capacitanceSpin->setValue(0.0);
         ui_->voltageSpin->setValue(0.0);
         ui_->toleranceSpin->setValue(0.0);
@@ -76,6 +76,7 @@ void CapacitorEditor::load(int componentId)
 
         return;
     }
+    capacitor_ = cd->capacitor;
 
     // Electrical
     ui_->capacitanceSpin->setValue(capacitor_.capacitance);
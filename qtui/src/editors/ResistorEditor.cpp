@@ -4,7 +4,7 @@
 #include "ResistorCompositionManager.h"
 //#include <QDebug>
 
-ResistorEditor::ResistorEditor(InventoryService& inventory, QWidget* parent)
+ResistorEditor::ResistorEditor(ReadConnection& inventory, QWidget* parent)
     : QWidget(parent),
     inventory_(inventory),
     ui_(new Ui::ResistorEditor)
@@ -56,13 +56,11 @@ void ResistorEditor::populateLookups()
     }
 }
 
-void ResistorEditor::load(int componentId)
+void ResistorEditor::load(const ComponentDetails& details)
 {
-    Resistor r;
-    DbResult result;
-
     // If no resistor row exists for this component, just clear UI defaults
-    if (!inventory_.resistors().getByComponentId(componentId, r, result)) {
+    const ResistorDetails* rd = details.as<ResistorDetails>();
+    if (!rd) {
         ui_->resistanceSpin->setValue(0.0);
         ui_->toleranceSpin->setValue(0.0);
         ui_->powerSpin->setValue(0.0);
@@ -79,6 +77,7 @@ void ResistorEditor::load(int componentId)
         return;
     }
 
+    const Resistor& r = rd->resistor;
     ui_->resistanceSpin->setValue(r.resistance);
     ui_->toleranceSpin->setValue(r.tolerance);
     ui_->powerSpin->setValue(r.powerRating);
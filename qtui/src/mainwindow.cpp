@@ -8,11 +8,88 @@
 #include "editors/ResistorEditor.h"
 #include "editors/CapacitorEditor.h"
 #include "DevDataSeeder.h"
+#include "AsyncCall.h"
+#include <QApplication>
 #include <QMessageBox>
 #include <QStatusBar>
 #include <QFileDialog>
+#include <QLabel>
+#include <QLineEdit>
+#include <QTimer>
 #include <QVBoxLayout>
 
+#include <variant>
+
+namespace {
+
+template <class T>
+struct Fetched {
+    T value{};
+    DbResult result;
+};
+
+struct SaveOutcome {
+    Component component;
+    DbResult result;
+    bool subtypeFailed = false;
+};
+
+using SubtypeRow = std::variant<std::monostate, Resistor, Capacitor>;
+
+// Tasks can still be queued when the database is closed under them
+bool serviceOpen(InventoryService* inventory, DbResult& result)
+{
+    if (inventory)
+        return true;
+    result.setError(SQLITE_MISUSE, "No database is open");
+    return false;
+}
+
+// The editor's subtype row, already validated by ComponentEditDialog::accept
+SubtypeRow collectSubtype(IComponentEditor* editor)
+{
+    if (auto* rEditor = dynamic_cast<ResistorEditor*>(editor))
+        return rEditor->resistor();
+    if (auto* cEditor = dynamic_cast<CapacitorEditor*>(editor))
+        return cEditor->capacitor();
+
+    // Future: Transistor, Diode, Fuse
+    return {};
+}
+
+bool saveSubtype(InventoryService& inventory, int componentId, SubtypeRow subtype,
+    DbResult& result)
+{
+    result.clear();
+
+    if (auto* r = std::get_if<Resistor>(&subtype)) {
+        r->componentId = componentId;
+
+        // Insert or update depending on whether the row already exists
+        Resistor existing;
+        DbResult check;
+        if (inventory.resistors().getByComponentId(componentId, existing, check))
+            return inventory.resistors().update(*r, result);
+
+        return inventory.resistors().add(*r, result);
+    }
+
+    if (auto* cap = std::get_if<Capacitor>(&subtype)) {
+        cap->componentId = componentId;
+
+        Capacitor existing;
+        DbResult check;
+        if (inventory.capacitors().getById(componentId, existing, check))
+            return inventory.capacitors().update(*cap, result);
+
+        return inventory.capacitors().add(*cap, result);
+    }
+
+    return true;
+}
+
+} // namespace
+
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent),
@@ -34,12 +111,31 @@ MainWindow::MainWindow(QWidget* parent)
     setCentralWidget(central);
 
     QVBoxLayout* layout = new QVBoxLayout(central);
+
+    // --- Search box ---
+    searchEdit_ = new QLineEdit(central);
+    searchEdit_->setPlaceholderText(tr("Search part number, description or notes"));
+    searchEdit_->setClearButtonEnabled(true);
+    searchEdit_->setEnabled(false);
+    layout->addWidget(searchEdit_);
+
+    // Debounce so typing does not run a query per keystroke
+    searchTimer_ = new QTimer(this);
+    searchTimer_->setSingleShot(true);
+    searchTimer_->setInterval(150);
+    connect(searchEdit_, &QLineEdit::textChanged, this, &MainWindow::onSearchTextChanged);
+    connect(searchTimer_, &QTimer::timeout, this, &MainWindow::applySearch);
+
     layout->addWidget(ui->componentView);
     layout->setContentsMargins(0, 0, 0, 0);
 
     // --- Table model ---
     componentModel_ = new ComponentTableModel(this); // DB set later via InventoryService
     ui->componentView->setModel(componentModel_);
+    connect(componentModel_, &ComponentTableModel::fetchFailed, this,
+        [this](const QString& message) {
+            QMessageBox::critical(this, tr("Error"), message);
+        });
 
     // --- Header resize behavior ---
     ui->componentView->horizontalHeader()
@@ -51,7 +147,8 @@ MainWindow::MainWindow(QWidget* parent)
 
     // --- Selection behavior ---
     ui->componentView->setSelectionBehavior(QAbstractItemView::SelectRows);
-    ui->componentView->setSelectionMode(QAbstractItemView::SingleSelection);
+    // Ctrl/Shift-click selects several rows for bulk delete
+    ui->componentView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 
     // --- Table styling ---
     ui->componentView->setStyleSheet(
@@ -74,6 +171,8 @@ MainWindow::MainWindow(QWidget* parent)
     // --- Window & status ---
     updateWindowTitle();
     statusBar()->showMessage(tr("Ready"));
+    stockLabel_ = new QLabel(this);
+    statusBar()->addPermanentWidget(stockLabel_);
     disableDatabaseActions();
 
 	connectSelectionModel();
@@ -184,10 +283,10 @@ void MainWindow::onActionCloseDatabase()
 
 void MainWindow::onActionAddComponent()
 {
-    if (!inventory_)
+    if (!reader_)
         return;
 
-    ComponentEditDialog dialog(*inventory_, this);
+    ComponentEditDialog dialog(*reader_, manufacturerAdder(), this);
 
     Component c; // blank component
     dialog.setComponent(c);
@@ -195,111 +294,12 @@ void MainWindow::onActionAddComponent()
     if (dialog.exec() != QDialog::Accepted)
         return;
 
-    // 1. Extract base component fields from dialog
-    c = dialog.component();
-    DbResult result;
-
-    // 2. Insert base component first (assigns c.id)
-    if (!inventory_->components().add(c, result)) {
-        QMessageBox::critical(this, tr("Error"),
-            QString::fromStdString(result.toString()));
-        return;
-    }
-
-    // 3. Retrieve subtype editor (if any)
-    IComponentEditor* editor = dialog.typeEditor();
-    if (editor) {
-
-        // Extract subtype model from editor (NO DB writes)
-        DbResult subResult;
-        if (!editor->collect(c.id, subResult)) {
-            QMessageBox::critical(this, tr("Subtype Error"),
-                QString::fromStdString(subResult.toString()));
-            return;
-        }
-
-        // 4. Save subtype based on category
-        switch (c.categoryId) {
-
-        case 1: { // Resistor
-            auto* rEditor = dynamic_cast<ResistorEditor*>(editor);
-            if (rEditor) {
-                const Resistor& r = rEditor->resistor();
-
-                // Check if resistor row already exists
-                Resistor existing;
-                DbResult check;
-                bool exists =
-                    inventory_->resistors().getByComponentId(c.id, existing, check);
-
-                if (exists) {
-                    // UPDATE
-                    if (!inventory_->resistors().update(r, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
-                else {
-                    // INSERT
-                    if (!inventory_->resistors().add(r, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
-            }
-            break;
-        }
-        case 2: { // Capacitor
-            auto* cEditor = dynamic_cast<CapacitorEditor*>(editor);
-            if (cEditor) {
-                const Capacitor& cap = cEditor->capacitor();
-
-                // Check if capacitor row already exists
-                Capacitor existing;
-                DbResult check;
-                bool exists =
-                    inventory_->capacitors().getById(c.id, existing, check);
-
-                if (exists) {
-                    // UPDATE
-                    if (!inventory_->capacitors().update(cap, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
-                else {
-                    // INSERT
-                    if (!inventory_->capacitors().add(cap, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
-            }
-            break;
-        }
-
-              // Future:
-              // case 3: Transistor
-              // case 4: Diode
-              // case 5: Fuse
-
-        default:
-            break;
-        }
-    }
-
-    // 5. Refresh UI
-    reloadComponents();
-    statusBar()->showMessage(tr("Component added"), 3000);
+    saveComponent(dialog.component(), dialog.typeEditor(), true);
 }
 
 void MainWindow::onActionDeleteComponent()
 {
-    if (!inventory_ || !componentModel_)
+    if (!reader_ || !componentModel_)
         return;
 
     auto selection = ui->componentView->selectionModel();
@@ -312,23 +312,34 @@ void MainWindow::onActionDeleteComponent()
         return;
     }
 
-    int row = selection->selectedRows().first().row();
-    int componentId = componentModel_->componentIdAt(row);
-
-    // Pull display values from the model
-    QString partNumber =
-        componentModel_->data(componentModel_->index(row, 2), Qt::DisplayRole).toString();
-    QString category =
-        componentModel_->data(componentModel_->index(row, 1), Qt::DisplayRole).toString();
-    QString manufacturer =
-        componentModel_->data(componentModel_->index(row, 3), Qt::DisplayRole).toString();
-
-    QString message = tr(
-        "Are you sure you want to delete this component?\n\n"
-        "Part Number: %1\n"
-        "Category: %2\n"
-        "Manufacturer: %3"
-    ).arg(partNumber, category, manufacturer);
+    const QModelIndexList rows = selection->selectedRows();
+    std::vector<int> componentIds;
+    componentIds.reserve(rows.size());
+    for (const QModelIndex& index : rows)
+        componentIds.push_back(componentModel_->componentIdAt(index.row()));
+
+    QString message;
+    if (componentIds.size() == 1) {
+        // Pull display values from the model
+        const int row = rows.first().row();
+        QString partNumber =
+            componentModel_->data(componentModel_->index(row, 2), Qt::DisplayRole).toString();
+        QString category =
+            componentModel_->data(componentModel_->index(row, 1), Qt::DisplayRole).toString();
+        QString manufacturer =
+            componentModel_->data(componentModel_->index(row, 3), Qt::DisplayRole).toString();
+
+        message = tr(
+            "Are you sure you want to delete this component?\n\n"
+            "Part Number: %1\n"
+            "Category: %2\n"
+            "Manufacturer: %3"
+        ).arg(partNumber, category, manufacturer);
+    }
+    else {
+        message = tr("Are you sure you want to delete %n selected components?", nullptr,
+            static_cast<int>(componentIds.size()));
+    }
 
     auto reply = QMessageBox::warning(
         this,
@@ -341,23 +352,39 @@ void MainWindow::onActionDeleteComponent()
     if (reply != QMessageBox::Yes)
         return;
 
-    DbResult result;
-    if (!inventory_->components().remove(componentId, result)) {
-        QMessageBox::critical(
-            this,
-            tr("Error"),
-            QString::fromStdString(result.toString())
-        );
-        return;
-    }
+    // One transaction for the whole selection (see ComponentManager::removeMany)
+    runAsync(backend_, this,
+        [componentIds](InventoryService* inventory) {
+            Fetched<long long> out;
+            if (serviceOpen(inventory, out.result))
+                inventory->components().removeMany(componentIds, out.value, out.result);
+            return out;
+        },
+        [this, componentIds](Fetched<long long> out) {
+            if (!out.result.ok()) {
+                QMessageBox::critical(
+                    this,
+                    tr("Error"),
+                    QString::fromStdString(out.result.toString())
+                );
+                return;
+            }
+
+            componentModel_->removeComponents(componentIds);
+            refreshStockTotals();
 
-    reloadComponents();
-    statusBar()->showMessage(tr("Component deleted"), 3000);
+            auto selection = ui->componentView->selectionModel();
+            const int selected = selection ? static_cast<int>(selection->selectedRows().size()) : 0;
+            ui->actionEditComponent->setEnabled(selected == 1);
+            ui->actionDeleteComponent->setEnabled(selected > 0);
+            statusBar()->showMessage(
+                tr("%n component(s) deleted", nullptr, static_cast<int>(out.value)), 3000);
+        });
 }
 
 void MainWindow::onActionAddTestComponent()
 {
-    if (!inventory_)
+    if (!reader_)
         return;
 
     Component c;
@@ -367,18 +394,26 @@ void MainWindow::onActionAddTestComponent()
     c.description = "Phase 1 test component";
     c.quantity = 1;
 
-    DbResult result;
-    if (!inventory_->components().add(c, result)) {
-        QMessageBox::critical(this, tr("Error"), QString::fromStdString(result.toString()));
-        return;
-    }
-
-    reloadComponents();
+    runAsync(backend_, this,
+        [c](InventoryService* inventory) {
+            Fetched<Component> out{ c, {} };
+            if (serviceOpen(inventory, out.result))
+                inventory->components().add(out.value, out.result);
+            return out;
+        },
+        [this](Fetched<Component> out) {
+            if (!out.result.ok()) {
+                QMessageBox::critical(this, tr("Error"), QString::fromStdString(out.result.toString()));
+                return;
+            }
+            componentModel_->upsertComponent(out.value);
+            refreshStockTotals();
+        });
 }
 
 void MainWindow::onActionEditComponent()
 {
-    if (!inventory_ || !componentModel_)
+    if (!reader_ || !componentModel_)
         return;
 
     auto index = ui->componentView->currentIndex();
@@ -388,122 +423,104 @@ void MainWindow::onActionEditComponent()
     int row = index.row();
     int componentId = componentModel_->componentIdAt(row);
 
-    DbResult result;
-    Component c;
+    // Base row, subtype row and lookup names in one query
+    runAsync(backend_, this,
+        [componentId](InventoryService* inventory) {
+            Fetched<ComponentDetails> out;
+            if (serviceOpen(inventory, out.result))
+                inventory->componentDetails().getById(componentId, out.value, out.result);
+            return out;
+        },
+        [this](Fetched<ComponentDetails> out) {
+            if (!out.result.ok()) {
+                QMessageBox::critical(this, tr("Error"),
+                    QString::fromStdString(out.result.toString()));
+                return;
+            }
+            editComponent(out.value);
+        });
+}
 
-    // Load base component
-    if (!inventory_->components().getById(componentId, c, result)) {
-        QMessageBox::critical(this, tr("Error"),
-            QString::fromStdString(result.toString()));
+void MainWindow::editComponent(const ComponentDetails& details)
+{
+    // The database may have been closed while the details were loading
+    if (!reader_)
         return;
-    }
 
-    // Open dialog
-    ComponentEditDialog dialog(*inventory_, this);
-    dialog.setComponent(c);
+    ComponentEditDialog dialog(*reader_, manufacturerAdder(), this);
+    dialog.setDetails(details);
 
     if (dialog.exec() != QDialog::Accepted)
         return;
 
-    // 1. Extract updated base component fields
-    c = dialog.component();
-
-    // 2. Update base component row
-    if (!inventory_->components().update(c, result)) {
-        QMessageBox::critical(this, tr("Error"),
-            QString::fromStdString(result.toString()));
-        return;
-    }
-
-    // 3. Extract subtype editor (if any)
-    IComponentEditor* editor = dialog.typeEditor();
-    if (editor) {
-
-        // Extract subtype model (NO DB writes)
-        DbResult subResult;
-        if (!editor->collect(c.id, subResult)) {
-            QMessageBox::critical(this, tr("Subtype Error"),
-                QString::fromStdString(subResult.toString()));
-            return;
-        }
+    saveComponent(dialog.component(), dialog.typeEditor(), false);
+}
 
-        // 4. Save subtype based on category
-        switch (c.categoryId) {
-
-        case 1: { // Resistor
-            auto* rEditor = dynamic_cast<ResistorEditor*>(editor);
-            if (rEditor) {
-                const Resistor& r = rEditor->resistor();
-
-                // Check if resistor row exists
-                Resistor existing;
-                DbResult check;
-                bool exists =
-                    inventory_->resistors().getByComponentId(c.id, existing, check);
-
-                if (exists) {
-                    // UPDATE resistor row
-                    if (!inventory_->resistors().update(r, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
-                else {
-                    // INSERT resistor row
-                    if (!inventory_->resistors().add(r, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
-            }
-            break;
-        }
-        case 2: { // Capacitor
-            auto* cEditor = dynamic_cast<CapacitorEditor*>(editor);
-            if (cEditor) {
-                const Capacitor& cap = cEditor->capacitor();
-
-                // Check if capacitor row exists
-                Capacitor existing;
-                DbResult check;
-                bool exists =
-                    inventory_->capacitors().getById(c.id, existing, check);
-
-                if (exists) {
-                    // UPDATE capacitor row
-                    if (!inventory_->capacitors().update(cap, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
-                else {
-                    // INSERT capacitor row
-                    if (!inventory_->capacitors().add(cap, result)) {
-                        QMessageBox::critical(this, tr("Error"),
-                            QString::fromStdString(result.toString()));
-                        return;
-                    }
-                }
+void MainWindow::saveComponent(const Component& c, IComponentEditor* editor, bool isNew)
+{
+    // Copied here, on the GUI thread: the editor is gone by the time the
+    // worker runs
+    SubtypeRow subtype = collectSubtype(editor);
+
+    runAsync(backend_, this,
+        [c, subtype, isNew](InventoryService* inventory) {
+            SaveOutcome out{ c, {} };
+            if (!serviceOpen(inventory, out.result))
+                return out;
+
+            // Base and subtype rows are written atomically; returning
+            // before commit() rolls both back.
+            Transaction tx = inventory->transaction(out.result);
+            if (!tx.isActive())
+                return out;
+
+            // 1. Insert (assigns the ID) or update the base row
+            const bool saved = isNew
+                ? inventory->components().add(out.component, out.result)
+                : inventory->components().update(out.component, out.result);
+            if (!saved)
+                return out;
+
+            // 2. Save subtype row (if any)
+            if (!saveSubtype(*inventory, out.component.id, subtype, out.result)) {
+                out.subtypeFailed = true;
+                return out;
             }
-            break;
-        }
-
-              // Future:
-              // case 3: Transistor
-              // case 4: Diode
-              // case 5: Fuse
 
-        default:
-            break;
-        }
-    }
+            tx.commit(out.result);
+            return out;
+        },
+        [this, isNew](SaveOutcome out) {
+            if (!out.result.ok()) {
+                QMessageBox::critical(this,
+                    out.subtypeFailed ? tr("Subtype Error") : tr("Error"),
+                    QString::fromStdString(out.result.toString()));
+                return;
+            }
+            if (!reader_)
+                return;
+
+            // Refresh UI in place: the dialog may have added lookup values,
+            // and the component now holds the stored row (ID and timestamps)
+            reloadLookups();
+            componentModel_->upsertComponent(out.component);
+            refreshStockTotals();
+            statusBar()->showMessage(isNew ? tr("Component added") : tr("Component updated"), 3000);
+        });
+}
 
-    // 5. Refresh UI
-    reloadComponents();
-    statusBar()->showMessage(tr("Component updated"), 3000);
+AddLookupDialog::AddFn MainWindow::manufacturerAdder()
+{
+    return [this](const std::string& name, AddLookupDialog::DoneFn done) {
+        runAsync(backend_, this,
+            [name](InventoryService* inventory) {
+                DbResult result;
+                if (serviceOpen(inventory, result))
+                    inventory->manufacturers().addByName(name, result);
+                return result;
+            },
+            std::move(done));
+    };
 }
 
 // --- Database lifecycle helpers ---
@@ -514,24 +531,108 @@ void MainWindow::clearComponentView()
         componentModel_->setComponents({});
 }
 
+void MainWindow::onSearchTextChanged()
+{
+    searchTimer_->start();
+}
+
+void MainWindow::applySearch()
+{
+    if (!reader_ || !componentModel_)
+        return;
+
+    const std::string text = searchEdit_->text().trimmed().toStdString();
+    if (text.empty()) {
+        reloadComponents();
+        return;
+    }
+
+    const quint64 generation = ++searchGeneration_;
+    runAsync(backend_, this,
+        [text](InventoryService* inventory) {
+            Fetched<std::vector<Component>> out;
+            if (serviceOpen(inventory, out.result))
+                inventory->components().search(text, kSearchLimit, out.value, out.result);
+            return out;
+        },
+        [this, generation](Fetched<std::vector<Component>> out) {
+            // Superseded by newer typing, a reload or a close
+            if (generation != searchGeneration_ || !reader_)
+                return;
+
+            if (!out.result.ok()) {
+                statusBar()->showMessage(QString::fromStdString(out.result.toString()), 5000);
+                return;
+            }
+
+            const auto count = out.value.size();
+            componentModel_->setComponents(std::move(out.value));
+            connectSelectionModel();
+            statusBar()->showMessage(count >= static_cast<std::size_t>(kSearchLimit)
+                ? tr("Showing the best %1 matches").arg(kSearchLimit)
+                : tr("%n match(es)", nullptr, static_cast<int>(count)), 3000);
+        });
+}
+
 void MainWindow::reloadComponents()
 {
-    if (!inventory_ || !componentModel_)
+    if (!reader_ || !componentModel_)
         return;
 
-    DbResult result;
+    ++searchGeneration_;
+    reloadLookups();
+
+    // Components are paged in by the model as the view scrolls. Pages
+    // come from the GUI thread's read connection, which under WAL never
+    // waits for the worker's writes.
+    ComponentManager* components = &reader_->components();
+    componentModel_->setPageSource(
+        [components](ComponentPageCursor& cursor, int pageSize,
+            std::vector<Component>& page, DbResult& result) {
+            return components->listPage(cursor, pageSize, page, result);
+        });
+    connectSelectionModel();
+
+    // Explicitly reset UI state
+    ui->componentView->clearSelection();
+    ui->actionEditComponent->setEnabled(false);
+    ui->actionDeleteComponent->setEnabled(false);
+
+    refreshStockTotals();
+}
+
+void MainWindow::refreshStockTotals()
+{
+    if (!reader_) {
+        stockLabel_->clear();
+        return;
+    }
 
-    // Load components
-    std::vector<Component> components;
-    if (!inventory_->components().list(components, result)) {
-        QMessageBox::critical(this, tr("Error"),
-            QString::fromStdString(result.toString()));
+    // A few rows of CategoryStats, cheap enough for the GUI thread at any
+    // inventory size
+    StockTotals totals;
+    DbResult result;
+    if (!reader_->stats().totals(totals, result)) {
+        stockLabel_->clear();
         return;
     }
 
+    stockLabel_->setText(tr("%1 components, %2 in stock, %3 out of stock")
+        .arg(totals.components)
+        .arg(totals.totalQuantity)
+        .arg(totals.zeroStock));
+}
+
+void MainWindow::reloadLookups()
+{
+    if (!reader_ || !componentModel_)
+        return;
+
+    DbResult result;
+
     // Load categories
     std::vector<Category> categories;
-    inventory_->categories().list(categories, result);
+    reader_->categories().list(categories, result);
 
     std::unordered_map<int, QString> categoryMap;
     for (const auto& c : categories)
@@ -539,7 +640,7 @@ void MainWindow::reloadComponents()
 
     // Load manufacturers
     std::vector<Manufacturer> manufacturers;
-    inventory_->manufacturers().list(manufacturers, result);
+    reader_->manufacturers().list(manufacturers, result);
 
     std::unordered_map<int, QString> manufacturerMap;
     for (const auto& m : manufacturers)
@@ -547,17 +648,13 @@ void MainWindow::reloadComponents()
 
     componentModel_->setCategoryLookup(std::move(categoryMap));
     componentModel_->setManufacturerLookup(std::move(manufacturerMap));
-    componentModel_->setComponents(std::move(components));
-    connectSelectionModel();
-
-    // Explicitly reset UI state
-    ui->componentView->clearSelection();
-    ui->actionEditComponent->setEnabled(false);
-    ui->actionDeleteComponent->setEnabled(false);
 }
 
 bool MainWindow::createNewDatabase(const QString& fileName)
 {
+    if (opening_)
+        return false;
+
     if (QFileInfo::exists(fileName)) {
         auto response = QMessageBox::warning(
             this,
@@ -583,11 +680,15 @@ bool MainWindow::createNewDatabase(const QString& fileName)
     if (!closeDatabase())
         return false;
 
-    return openDatabase(fileName);
+    openDatabase(fileName);
+    return true;
 }
 
 bool MainWindow::openExistingDatabase(const QString& fileName)
 {
+    if (opening_)
+        return false;
+
     if (!QFileInfo::exists(fileName)) {
         QMessageBox::critical(this, tr("Missing"),
             tr("Database not found."));
@@ -597,51 +698,71 @@ bool MainWindow::openExistingDatabase(const QString& fileName)
     if (!closeDatabase())
         return false;
 
-    return openDatabase(fileName);
+    openDatabase(fileName);
+    return true;
 }
 
-bool MainWindow::openDatabase(const QString& fileName)
+void MainWindow::openDatabase(const QString& fileName)
 {
-    DbResult result;
-
-    inventory_ = InventoryService::open(
-        fileName.toStdString(),
-        result
-    );
-
-    if (!inventory_) {
-        QMessageBox::critical(
-            this,
-            tr("Database Error"),
-            QString::fromStdString(result.message)
-        );
-        return false;
-    }
+    opening_ = true;
+    statusBar()->showMessage(tr("Opening %1...").arg(fileName));
+    QApplication::setOverrideCursor(Qt::BusyCursor);
+
+    // Opening a large file and running migrations happen on the worker.
+    // Tasks run in order, so the one queued next sees the open's result.
+    // WAL + busy timeout lets the UI keep reading while the worker, an
+    // importer or another process writes to the same file.
+    auto opened = std::make_shared<std::future<DbResult>>(
+        backend_.open(fileName.toStdString(), DatabaseOptions::interactive()));
+
+    runAsync(backend_, this,
+        [opened](InventoryService*) { return opened->get(); },
+        [this, fileName](DbResult result) {
+            opening_ = false;
+            QApplication::restoreOverrideCursor();
+
+            if (result.ok() && !backend_.readSession(reader_, result))
+                backend_.close();
+
+            if (!result.ok()) {
+                QMessageBox::critical(
+                    this,
+                    tr("Database Error"),
+                    QString::fromStdString(result.message)
+                );
+                statusBar()->showMessage(tr("Ready"));
+                return;
+            }
 
-    currentDatabasePath_ = fileName;
-    enableDatabaseActions();
-    updateWindowTitle(QFileInfo(fileName).fileName());
-    statusBar()->showMessage(tr("Connected to %1").arg(fileName));
+            currentDatabasePath_ = fileName;
+            enableDatabaseActions();
+            updateWindowTitle(QFileInfo(fileName).fileName());
+            statusBar()->showMessage(tr("Connected to %1").arg(fileName));
 
-    reloadComponents();
-    return true;
+            reloadComponents();
+        });
 }
 
 bool MainWindow::closeDatabase()
 {
-    if (!inventory_)
+    if (!reader_)
         return true;
 
     // Future: prompt for unsaved changes here
 
-    inventory_.reset();   // 💥 closes DB via RAII
+    // Drop the model's page source and the read connection it points at
+    // before the worker closes the database that owns them
+    clearComponentView();
+    ++searchGeneration_;
+    reader_.release();
+
+    backend_.close();   // 💥 closes DB via RAII, on the worker
     currentDatabasePath_.clear();
 
     updateWindowTitle();
     statusBar()->showMessage(tr("Database disconnected"));
 
     disableDatabaseActions();
-    clearComponentView();
 
     return true;
 }
@@ -653,6 +774,7 @@ void MainWindow::enableDatabaseActions()
     ui->actionCloseDatabase->setEnabled(true);
     ui->actionAddComponent->setEnabled(true);
     ui->actionAddTestComponent->setEnabled(true);
+    searchEdit_->setEnabled(true);
 }
 
 void MainWindow::disableDatabaseActions()
@@ -662,6 +784,9 @@ void MainWindow::disableDatabaseActions()
     ui->actionEditComponent->setEnabled(false);
 	ui->actionDeleteComponent->setEnabled(false);
 	ui->actionAddTestComponent->setEnabled(false);
+    searchEdit_->setEnabled(false);
+    searchEdit_->clear();
+    stockLabel_->clear();
 }
 
 void MainWindow::updateWindowTitle(const QString& dbName)
@@ -684,8 +809,9 @@ void MainWindow::connectSelectionModel()
         this,
         [this, sel]() // capture sel explicitly
         {
-            const bool hasSelection = sel->hasSelection();
-            ui->actionEditComponent->setEnabled(hasSelection);
-            ui->actionDeleteComponent->setEnabled(hasSelection);
+            // Editing works on one row; delete takes the whole selection
+            const int selected = static_cast<int>(sel->selectedRows().size());
+            ui->actionEditComponent->setEnabled(selected == 1);
+            ui->actionDeleteComponent->setEnabled(selected > 0);
         });
 }
@@ -0,0 +1,113 @@
+#include "BackendTestFixture.h"
+#include "AsyncInventoryService.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class AsyncInventoryServiceTest : public ::testing::Test {
+protected:
+    DbResult res;
+    AsyncInventoryService backend;
+};
+
+// 1. Open_RunsTasksOnWorkerThread
+TEST_F(AsyncInventoryServiceTest, Open_RunsTasksOnWorkerThread) {
+    const std::string path = tempDbPath("inventory_async_test.db");
+    res = backend.open(path, DatabaseOptions::interactive()).get();
+    ASSERT_TRUE(res.ok()) << res.toString();
+
+    const auto caller = std::this_thread::get_id();
+    auto added = backend.submit([&](InventoryService* service) {
+        DbResult r;
+        Component c("LM317T", "regulator",
+            service->categories().getIdByName("Resistor", r), 0, 3);
+        EXPECT_NE(std::this_thread::get_id(), caller);
+        EXPECT_TRUE(backend.onWorkerThread());
+        return service->components().add(c, r) ? c.id : 0;
+    });
+    const int id = added.get();
+    ASSERT_GT(id, 0);
+    EXPECT_FALSE(backend.onWorkerThread());
+
+    // Synchronous reads go through a pooled connection instead
+    ReadSession session;
+    ASSERT_TRUE(backend.readSession(session, res)) << res.toString();
+    Component c;
+    ASSERT_TRUE(session->components().getById(id, c, res)) << res.toString();
+    EXPECT_EQ(c.partNumber, "LM317T");
+    session.release();
+
+    backend.close().get();
+    EXPECT_FALSE(backend.readSession(session, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+}
+
+// 2. Submit_RunsInQueueOrder
+TEST_F(AsyncInventoryServiceTest, Submit_RunsInQueueOrder) {
+    // Queued before the open completes: the query still sees the service
+    auto opened = backend.open(tempDbPath("inventory_async_order_test.db"),
+        DatabaseOptions::interactive());
+    auto seesService = backend.submit([](InventoryService* service) { return service != nullptr; });
+
+    std::vector<int> order;
+    for (int i = 0; i < 100; ++i)
+        backend.post([&order, i](InventoryService*) { order.push_back(i); });
+    auto last = backend.submit([&order](InventoryService*) { return order.size(); });
+
+    EXPECT_TRUE(opened.get().ok());
+    EXPECT_TRUE(seesService.get());
+    EXPECT_EQ(last.get(), 100u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(order[i], i);
+}
+
+// 3. Open_FailureLeavesNoService
+TEST_F(AsyncInventoryServiceTest, Open_FailureLeavesNoService) {
+    res = backend.open("/invalid/path/to/db.sqlite", DatabaseOptions::interactive()).get();
+    EXPECT_FALSE(res.ok());
+
+    auto seesService = backend.submit([](InventoryService* service) { return service != nullptr; });
+    EXPECT_FALSE(seesService.get());
+}
+
+// 4. ReadSession_WaitingDoesNotBlockWorker
+TEST_F(AsyncInventoryServiceTest, ReadSession_WaitingDoesNotBlockWorker) {
+    res = backend.open(tempDbPath("inventory_async_wait_test.db"), DatabaseOptions::interactive()).get();
+    ASSERT_TRUE(res.ok()) << res.toString();
+
+    // Exhaust the pool, so the next readSession() waits
+    std::shared_ptr<ReaderPool> pool = backend.submit(
+        [](InventoryService* service) { return service->readers(); }).get();
+    ASSERT_NE(pool, nullptr);
+    auto held = std::make_shared<std::vector<ReadSession>>();
+    for (;;) {
+        ReadSession session;
+        if (!pool->tryAcquire(session, res))
+            break;
+        held->push_back(std::move(session));
+    }
+    ASSERT_EQ(res.code, SQLITE_BUSY);
+    pool.reset();
+
+    bool acquired = false;
+    std::thread waiter([&] {
+        ReadSession session;
+        DbResult r;
+        acquired = backend.readSession(session, r);
+        if (acquired) {
+            // Still usable after close() dropped the pool
+            Component c;
+            session->components().getById(1, c, r);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // The session the waiter needs comes back from a task queued behind
+    // close(), so close() must not wait for the waiter
+    auto closed = backend.close();
+    backend.post([held](InventoryService*) { held->clear(); });
+    waiter.join();
+    closed.get();
+    EXPECT_TRUE(acquired);
+}
@@ -14,6 +14,19 @@
 #include "CapacitorPackageManager.h"
 #include "CapacitorDielectricManager.h"
 
+#include <filesystem>
+#include <string>
+
+// Fresh on-disk database path in the temp directory, with any file a
+// previous run left behind (WAL, shared memory, journal, partial backup)
+// removed. For tests that need a real file: WAL, mmap, several connections.
+inline std::string tempDbPath(const std::string& name) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    for (const char* suffix : { "", "-wal", "-shm", "-journal", ".partial" })
+        std::filesystem::remove(path.string() + suffix);
+    return path.string();
+}
+
 // A reusable test fixture for all manager tests
 class BackendTestFixture : public ::testing::Test {
 protected:
@@ -143,3 +143,32 @@ TEST_F(CapacitorManagerTest, GeometryFields_RoundTrip) {
     EXPECT_DOUBLE_EQ(fetched.height, 11.0);
     EXPECT_DOUBLE_EQ(fetched.leadSpacing, 2.5);
 }
+
+// 7. AddBatch_WithComponents_InsertsBothRows
+TEST_F(CapacitorManagerTest, AddBatch_WithComponents_InsertsBothRows) {
+    std::vector<Component> comps;
+    std::vector<Capacitor> caps;
+    for (int i = 0; i < 20; ++i) {
+        comps.emplace_back("C-BATCH" + std::to_string(i), "Batch capacitor", catId, manId, 5);
+        caps.emplace_back(0, 1e-9 * (i + 1), 50.0, 5.0, 0.1, 0.001, false, pkgId, dielId);
+    }
+
+    ASSERT_TRUE(capMgr.addBatch(comps, caps, res)) << res.toString();
+
+    for (std::size_t i = 0; i < comps.size(); ++i) {
+        ASSERT_GT(comps[i].id, 0);
+        EXPECT_EQ(caps[i].componentId, comps[i].id);
+    }
+
+    std::vector<Capacitor> all;
+    ASSERT_TRUE(capMgr.list(all, res)) << res.toString();
+    EXPECT_EQ(all.size(), 20u);
+}
+
+// 8. AddBatch_MismatchedSpans_Fails
+TEST_F(CapacitorManagerTest, AddBatch_MismatchedSpans_Fails) {
+    std::vector<Component> comps(2);
+    std::vector<Capacitor> caps(1);
+    EXPECT_FALSE(capMgr.addBatch(comps, caps, res));
+    EXPECT_TRUE(res.hasError());
+}
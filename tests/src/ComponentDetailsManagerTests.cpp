@@ -0,0 +1,134 @@
+#include "BackendTestFixture.h"
+#include "ComponentDetailsManager.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "CapacitorManager.h"
+#include "TransistorManager.h"
+#include "BJTManager.h"
+#include "DiodeManager.h"
+#include "DiodePackageManager.h"
+#include "DiodeTypeManager.h"
+#include "DiodePolarityManager.h"
+
+class ComponentDetailsManagerTest : public BackendTestFixture {
+protected:
+    ComponentDetailsManager detailsMgr;
+    ComponentManager compMgr;
+
+    int resistorId = 0;
+    int capacitorId = 0;
+    int bjtId = 0;
+    int diodeId = 0;
+    int plainId = 0;
+
+    ComponentDetailsManagerTest()
+        : detailsMgr(db), compMgr(db) {
+    }
+
+    int addComponent(const std::string& pn, const std::string& category, int manufacturerId) {
+        Component c(pn, pn + " description", catMgr.getIdByName(category, res), manufacturerId, 5);
+        EXPECT_TRUE(compMgr.add(c, res)) << res.toString();
+        return c.id;
+    }
+
+    void SetUp() override {
+        BackendTestFixture::SetUp();
+
+        resistorId = addComponent("R-10K", "Resistor", manId);
+        Resistor r(resistorId, 10000.0, 1.0, 0.25, true, -100.0, 100.0, false, 0.0, 0.0,
+            ResistorPackageManager(db).getByName("0805", res),
+            ResistorCompositionManager(db).getByName("Metal Film", res), 0.0, 200.0);
+        ASSERT_TRUE(ResistorManager(db).add(r, res)) << res.toString();
+
+        capacitorId = addComponent("C-100N", "Capacitor", 0);
+        Capacitor cap(capacitorId, 100e-9, 50.0, 10.0, 0.0, 0.0, false,
+            0, CapacitorDielectricManager(db).getByName("X7R", res));
+        ASSERT_TRUE(CapacitorManager(db).add(cap, res)) << res.toString();
+
+        bjtId = addComponent("2N3904", "Transistor", manId);
+        Transistor t(bjtId, TransistorTypeManager(db).getByName("BJT", res),
+            TransistorPolarityManager(db).getByName("NPN", res),
+            TransistorPackageManager(db).getByName("TO-92", res));
+        ASSERT_TRUE(TransistorManager(db).add(t, res)) << res.toString();
+        ASSERT_TRUE(BJTManager(db).add(BJT(bjtId, 40.0, 0.2, 0.625, 100.0, 300e6), res)) << res.toString();
+
+        diodeId = addComponent("1N4148", "Diode", manId);
+        Diode d(diodeId, DiodePackageManager(db).getByName("Axial leaded", res),
+            DiodeTypeManager(db).getByName("Rectifier", res),
+            DiodePolarityManager(db).getByName("Anode-Cathode", res), 0.7, 0.3, 100.0, 0.025);
+        ASSERT_TRUE(DiodeManager(db).add(d, res)) << res.toString();
+
+        plainId = addComponent("FUSE-NO-DETAILS", "Fuse", manId);
+    }
+};
+
+// 1. GetById_ReturnsSubtypeAndLookupNames
+TEST_F(ComponentDetailsManagerTest, GetById_ReturnsSubtypeAndLookupNames) {
+    ComponentDetails details;
+    ASSERT_TRUE(detailsMgr.getById(resistorId, details, res)) << res.toString();
+    EXPECT_EQ(details.component.partNumber, "R-10K");
+    EXPECT_EQ(details.categoryName, "Resistor");
+    EXPECT_EQ(details.manufacturerName, "Generic");
+
+    const ResistorDetails* rd = details.as<ResistorDetails>();
+    ASSERT_NE(rd, nullptr);
+    EXPECT_DOUBLE_EQ(rd->resistor.resistance, 10000.0);
+    EXPECT_TRUE(rd->resistor.hasTempCoeff);
+    EXPECT_DOUBLE_EQ(rd->resistor.tempCoeffMin, -100.0);
+    EXPECT_FALSE(rd->resistor.hasTempRange);
+    EXPECT_EQ(rd->packageName, "0805");
+    EXPECT_EQ(rd->compositionName, "Metal Film");
+
+    // Unset manufacturer and package come back as empty names
+    ASSERT_TRUE(detailsMgr.getById(capacitorId, details, res)) << res.toString();
+    EXPECT_EQ(details.manufacturerName, "");
+    const CapacitorDetails* cd = details.as<CapacitorDetails>();
+    ASSERT_NE(cd, nullptr);
+    EXPECT_NEAR(cd->capacitor.capacitance, 100e-9, 1e-15);
+    EXPECT_EQ(cd->packageName, "");
+    EXPECT_EQ(cd->dielectricName, "X7R");
+
+    ASSERT_TRUE(detailsMgr.getById(bjtId, details, res)) << res.toString();
+    const TransistorDetails* td = details.as<TransistorDetails>();
+    ASSERT_NE(td, nullptr);
+    EXPECT_EQ(td->typeName, "BJT");
+    EXPECT_EQ(td->polarityName, "NPN");
+    EXPECT_EQ(td->packageName, "TO-92");
+    ASSERT_TRUE(td->bjt.has_value());
+    EXPECT_DOUBLE_EQ(td->bjt->hfe, 100.0);
+
+    ASSERT_TRUE(detailsMgr.getById(plainId, details, res)) << res.toString();
+    EXPECT_EQ(details.categoryName, "Fuse");
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(details.subtype));
+}
+
+// 2. GetById_MissingIdFails
+TEST_F(ComponentDetailsManagerTest, GetById_MissingIdFails) {
+    ComponentDetails details;
+    EXPECT_FALSE(detailsMgr.getById(999999, details, res));
+    EXPECT_EQ(res.code, SQLITE_NOTFOUND);
+}
+
+// 3. GetByIds_KeepsRequestedOrderAndSkipsMissing
+TEST_F(ComponentDetailsManagerTest, GetByIds_KeepsRequestedOrderAndSkipsMissing) {
+    const std::vector<int> ids = { diodeId, 999999, resistorId, plainId, diodeId };
+    std::vector<ComponentDetails> details;
+    ASSERT_TRUE(detailsMgr.getByIds(ids, details, res)) << res.toString();
+
+    ASSERT_EQ(details.size(), 4u);
+    EXPECT_EQ(details[0].component.id, diodeId);
+    EXPECT_EQ(details[1].component.id, resistorId);
+    EXPECT_EQ(details[2].component.id, plainId);
+    EXPECT_EQ(details[3].component.id, diodeId);
+
+    const DiodeDetails* dd = details[0].as<DiodeDetails>();
+    ASSERT_NE(dd, nullptr);
+    EXPECT_EQ(dd->packageName, "Axial leaded");
+    EXPECT_EQ(dd->typeName, "Rectifier");
+    EXPECT_EQ(dd->polarityName, "Anode-Cathode");
+    EXPECT_DOUBLE_EQ(dd->diode.maxReverseVoltage, 100.0);
+    EXPECT_NE(details[1].as<ResistorDetails>(), nullptr);
+
+    ASSERT_TRUE(detailsMgr.getByIds({}, details, res));
+    EXPECT_TRUE(details.empty());
+}
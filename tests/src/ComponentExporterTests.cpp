@@ -0,0 +1,146 @@
+#include "BackendTestFixture.h"
+#include "ComponentExporter.h"
+#include "CsvImporter.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "CapacitorManager.h"
+#include "FuseManager.h"
+#include "FusePackageManager.h"
+#include "FuseTypeManager.h"
+
+#include <sstream>
+
+class ComponentExporterTest : public BackendTestFixture {
+protected:
+    ComponentExporter exporter;
+    ComponentManager compMgr;
+    ExportOptions options;
+    ExportReport report;
+
+    ComponentExporterTest()
+        : exporter(db), compMgr(db) {
+    }
+
+    void SetUp() override {
+        BackendTestFixture::SetUp();
+
+        CsvImporter importer(db);
+        CsvImportOptions importOptions;
+        ImportReport importReport;
+        std::istringstream in(
+            "PartNumber,Category,Manufacturer,Description,Quantity,Resistance,Tolerance,PowerRating,Package,Capacitance,VoltageRating,Dielectric\n"
+            "RC0805-10K,Resistor,Generic,\"Thick film, \"\"1%\"\"\",250,10k,1,0.125W,0805,,,\n"
+            "GRM21-100N,Capacitor,Murata,\"MLCC\nsecond line\",1000,,,,,100nF,50V,X7R\n");
+        ASSERT_TRUE(importer.importStream(in, importOptions, importReport, res)) << res.toString();
+        ASSERT_EQ(importReport.rowsImported, 2);
+
+        // A fuse, which the importer cannot create
+        Component c("F-500MA", "Glass fuse", catMgr.getIdByName("Fuse", res), manId, 20);
+        ASSERT_TRUE(compMgr.add(c, res)) << res.toString();
+        Fuse f(c.id, FusePackageManager(db).getByName("Cartridge", res),
+            FuseTypeManager(db).getByName("Fast-blow", res), 0.5, 250.0);
+        ASSERT_TRUE(FuseManager(db).add(f, res)) << res.toString();
+    }
+
+    std::string exportText() {
+        std::ostringstream out;
+        EXPECT_TRUE(exporter.exportStream(out, options, report, res)) << res.toString();
+        return out.str();
+    }
+
+    static std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> result;
+        std::istringstream in(text);
+        for (std::string line; std::getline(in, line);)
+            result.push_back(line);
+        return result;
+    }
+};
+
+// 1. Csv_JoinsSubtypesAndLookupNames
+TEST_F(ComponentExporterTest, Csv_JoinsSubtypesAndLookupNames) {
+    const std::string text = exportText();
+    EXPECT_EQ(report.rowsWritten, 3);
+    EXPECT_EQ(report.bytesWritten, static_cast<long long>(text.size()));
+
+    std::vector<std::string> rows = lines(text);
+    ASSERT_GE(rows.size(), 4u);
+    EXPECT_EQ(rows[0].rfind("ID,PartNumber,Category,Manufacturer,Description,", 0), 0u);
+
+    // Embedded delimiter and quotes are escaped, lookup IDs become names
+    EXPECT_NE(rows[1].find(",RC0805-10K,Resistor,Generic,\"Thick film, \"\"1%\"\"\",,250,"), std::string::npos);
+    EXPECT_NE(rows[1].find(",0805,1.0,"), std::string::npos);
+
+    // A quoted newline spans two physical lines
+    EXPECT_NE(text.find(",Murata,\"MLCC\nsecond line\","), std::string::npos);
+    EXPECT_NE(text.find(",X7R,"), std::string::npos);
+
+    // Fuse package and voltage land in the shared columns
+    EXPECT_NE(text.find(",F-500MA,Fuse,Generic,Glass fuse,,20,,"), std::string::npos);
+    EXPECT_NE(text.find(",Cartridge,,250.0,"), std::string::npos);
+    EXPECT_NE(text.find(",Fast-blow,0.5,"), std::string::npos);
+}
+
+// 2. JsonLines_OmitsNullsAndEscapesStrings
+TEST_F(ComponentExporterTest, JsonLines_OmitsNullsAndEscapesStrings) {
+    options.format = ExportFormat::JsonLines;
+    std::vector<std::string> rows = lines(exportText());
+    ASSERT_EQ(rows.size(), 3u);
+
+    EXPECT_EQ(rows[0].front(), '{');
+    EXPECT_EQ(rows[0].back(), '}');
+    EXPECT_NE(rows[0].find("\"PartNumber\":\"RC0805-10K\""), std::string::npos);
+    EXPECT_NE(rows[0].find("\"Description\":\"Thick film, \\\"1%\\\"\""), std::string::npos);
+    EXPECT_NE(rows[0].find("\"Resistance\":10000.0"), std::string::npos);
+    EXPECT_NE(rows[0].find("\"Quantity\":250"), std::string::npos);
+    EXPECT_EQ(rows[0].find("Capacitance"), std::string::npos);
+    EXPECT_EQ(rows[0].find("null"), std::string::npos);
+
+    EXPECT_NE(rows[1].find("\"Description\":\"MLCC\\nsecond line\""), std::string::npos);
+    EXPECT_NE(rows[2].find("\"FuseType\":\"Fast-blow\""), std::string::npos);
+    EXPECT_NE(rows[2].find("\"CurrentRating\":0.5"), std::string::npos);
+}
+
+// 3. Csv_RoundTripsThroughImporter
+TEST_F(ComponentExporterTest, Csv_RoundTripsThroughImporter) {
+    options.bufferBytes = 16;   // flushes after every record
+    const std::string text = exportText();
+
+    DbResult copyRes;
+    Database copy(":memory:", copyRes);
+    ASSERT_TRUE(SchemaManager(copy).initialize(copyRes)) << copyRes.toString();
+
+    CsvImporter importer(copy);
+    CsvImportOptions importOptions;
+    ImportReport importReport;
+    std::istringstream in(text);
+    ASSERT_TRUE(importer.importStream(in, importOptions, importReport, copyRes)) << copyRes.toString();
+    EXPECT_EQ(importReport.rowsImported, 3);
+    EXPECT_EQ(importReport.rowsFailed, 0);
+
+    std::vector<Component> found;
+    ASSERT_TRUE(ComponentManager(copy).findByPartNumber("RC0805-10K", found, copyRes));
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].description, "Thick film, \"1%\"");
+
+    Resistor r;
+    ASSERT_TRUE(ResistorManager(copy).getByComponentId(found[0].id, r, copyRes)) << copyRes.toString();
+    EXPECT_DOUBLE_EQ(r.resistance, 10000.0);
+    EXPECT_DOUBLE_EQ(r.tolerance, 1.0);
+    EXPECT_DOUBLE_EQ(r.powerRating, 0.125);
+    EXPECT_EQ(r.packageTypeId, ResistorPackageManager(copy).getByName("0805", copyRes));
+
+    // Capacitor ratings survive too
+    ASSERT_TRUE(ComponentManager(copy).findByPartNumber("GRM21-100N", found, copyRes));
+    ASSERT_EQ(found.size(), 1u);
+    Capacitor cap;
+    ASSERT_TRUE(CapacitorManager(copy).getById(found[0].id, cap, copyRes)) << copyRes.toString();
+    EXPECT_DOUBLE_EQ(cap.capacitance, 100e-9);
+    EXPECT_DOUBLE_EQ(cap.voltageRating, 50.0);
+
+    // The importer has no fuse columns: the base row comes back alone
+    ASSERT_TRUE(ComponentManager(copy).findByPartNumber("F-500MA", found, copyRes));
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].quantity, 20);
+    EXPECT_EQ(copy.countRows("Fuses", ""), 0);
+}
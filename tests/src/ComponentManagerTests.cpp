@@ -1,5 +1,7 @@
 #include "BackendTestFixture.h"
 #include "ComponentManager.h"
+#include "DbUtils.h"
+#include <algorithm>
 #include <thread>
 #include <chrono>
 
@@ -128,3 +130,358 @@ TEST_F(ComponentManagerTest, Remove_CascadesToSubtables) {
     EXPECT_EQ(db.countRows("Resistors",
         "ComponentID=" + std::to_string(comp.id)), 0);
 }
+
+// 8. AddBatch_AssignsIdsToAllRows
+TEST_F(ComponentManagerTest, AddBatch_AssignsIdsToAllRows) {
+    std::vector<Component> batch;
+    for (int i = 0; i < 100; ++i)
+        batch.emplace_back("PNB" + std::to_string(i), "Batch part", catId, manId, i);
+
+    ASSERT_TRUE(compMgr.addBatch(batch, res)) << res.toString();
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        ASSERT_GT(batch[i].id, 0);
+        if (i > 0) {
+            EXPECT_GT(batch[i].id, batch[i - 1].id);
+        }
+    }
+
+    Component fetched;
+    ASSERT_TRUE(compMgr.getById(batch[42].id, fetched, res)) << res.toString();
+    EXPECT_EQ(fetched.partNumber, "PNB42");
+    EXPECT_EQ(fetched.quantity, 42);
+}
+
+// 9. AddBatch_FailingRow_RollsBackWholeBatch
+TEST_F(ComponentManagerTest, AddBatch_FailingRow_RollsBackWholeBatch) {
+    int before = db.countRows("Components", "");
+
+    std::vector<Component> batch;
+    batch.emplace_back("PNOK1", "Good", catId, manId, 1);
+    batch.emplace_back("PNBAD", "Bad category", 999999, manId, 1);
+    batch.emplace_back("PNOK2", "Good", catId, manId, 1);
+
+    EXPECT_FALSE(compMgr.addBatch(batch, res));
+    EXPECT_TRUE(res.hasError());
+    EXPECT_EQ(db.countRows("Components", ""), before);
+
+    // Connection is usable again after the rollback
+    Component after("PNAFTER", "After rollback", catId, manId, 1);
+    EXPECT_TRUE(compMgr.add(after, res)) << res.toString();
+}
+
+// 10. FindByPartNumber_IsCaseInsensitive
+TEST_F(ComponentManagerTest, FindByPartNumber_IsCaseInsensitive) {
+    Component a("LM317T", "Regulator", catId, manId, 3);
+    Component b("lm317t", "Regulator, second reel", catId, manId, 7);
+    Component c("LM337T", "Negative regulator", catId, manId, 1);
+    ASSERT_TRUE(compMgr.add(a, res));
+    ASSERT_TRUE(compMgr.add(b, res));
+    ASSERT_TRUE(compMgr.add(c, res));
+
+    std::vector<Component> found;
+    ASSERT_TRUE(compMgr.findByPartNumber("Lm317T", found, res)) << res.toString();
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0].id, a.id);
+    EXPECT_EQ(found[1].id, b.id);
+
+    ASSERT_TRUE(compMgr.findByPartNumber("NOPE", found, res));
+    EXPECT_TRUE(found.empty());
+}
+
+// 11. ForEach_VisitsRowsInIdOrderAndStopsEarly
+TEST_F(ComponentManagerTest, ForEach_VisitsRowsInIdOrderAndStopsEarly) {
+    std::vector<Component> batch;
+    for (int i = 0; i < 20; ++i)
+        batch.emplace_back("PNEACH" + std::to_string(i), "Streamed part", catId, manId, i);
+    ASSERT_TRUE(compMgr.addBatch(batch, res)) << res.toString();
+
+    std::vector<int> ids;
+    ASSERT_TRUE(compMgr.forEach([&](const Component& c) {
+        ids.push_back(c.id);
+        return true;
+    }, res)) << res.toString();
+    ASSERT_EQ(ids.size(), batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        EXPECT_EQ(ids[i], batch[i].id);
+
+    int visited = 0;
+    ASSERT_TRUE(compMgr.forEach([&](const Component&) {
+        return ++visited < 5;
+    }, res));
+    EXPECT_EQ(visited, 5);
+}
+
+// 12. ForEachView_BorrowsColumnText
+TEST_F(ComponentManagerTest, ForEachView_BorrowsColumnText) {
+    Component c("PNVIEW", "Viewed part", catId, manId, 4, "", "https://example.com/ds.pdf");
+    ASSERT_TRUE(compMgr.add(c, res)) << res.toString();
+
+    Component copy;
+    ASSERT_TRUE(compMgr.forEachView([&](const ComponentView& v) {
+        if (v.id != c.id)
+            return true;
+        EXPECT_EQ(v.partNumber, "PNVIEW");
+        EXPECT_EQ(v.description, "Viewed part");
+        EXPECT_TRUE(v.notes.empty());
+        EXPECT_EQ(v.datasheetLink, "https://example.com/ds.pdf");
+        copy = v.toComponent();
+        return false;
+    }, res)) << res.toString();
+
+    EXPECT_EQ(copy.id, c.id);
+    EXPECT_EQ(copy.partNumber, "PNVIEW");
+    EXPECT_EQ(copy.quantity, 4);
+}
+
+// 13. ListPage_ById_WalksAllRowsOnce
+TEST_F(ComponentManagerTest, ListPage_ById_WalksAllRowsOnce) {
+    std::vector<Component> batch;
+    for (int i = 0; i < 25; ++i)
+        batch.emplace_back("PNPAGE" + std::to_string(i), "Paged part", catId, manId, i);
+    ASSERT_TRUE(compMgr.addBatch(batch, res)) << res.toString();
+
+    const int total = db.countRows("Components", "");
+
+    ComponentPageCursor cursor;
+    std::vector<Component> page;
+    std::vector<int> ids;
+    int pages = 0;
+    while (!cursor.atEnd) {
+        ASSERT_TRUE(compMgr.listPage(cursor, 10, page, res)) << res.toString();
+        ASSERT_LE(page.size(), 10u);
+        for (const Component& c : page)
+            ids.push_back(c.id);
+        ++pages;
+    }
+
+    EXPECT_EQ(static_cast<int>(ids.size()), total);
+    EXPECT_EQ(pages, total / 10 + 1);
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+    EXPECT_EQ(std::adjacent_find(ids.begin(), ids.end()), ids.end());
+
+    // Exhausted cursor returns empty pages
+    ASSERT_TRUE(compMgr.listPage(cursor, 10, page, res));
+    EXPECT_TRUE(page.empty());
+}
+
+// 14. ListPage_ByPartNumber_OrdersCaseInsensitivelyAcrossTies
+TEST_F(ComponentManagerTest, ListPage_ByPartNumber_OrdersCaseInsensitivelyAcrossTies) {
+    std::vector<Component> batch;
+    batch.emplace_back("b-200", "", catId, manId, 1);
+    batch.emplace_back("A-100", "", catId, manId, 1);
+    batch.emplace_back("a-100", "", catId, manId, 1);   // tie with A-100
+    batch.emplace_back("C-300", "", catId, manId, 1);
+    batch.emplace_back("a-100", "", catId, manId, 1);   // second tie
+    ASSERT_TRUE(compMgr.addBatch(batch, res)) << res.toString();
+
+    ComponentPageCursor cursor;
+    cursor.order = ComponentOrder::ByPartNumber;
+
+    // Page size 2 forces page boundaries inside the run of ties
+    std::vector<int> ids;
+    std::vector<Component> page;
+    while (!cursor.atEnd) {
+        ASSERT_TRUE(compMgr.listPage(cursor, 2, page, res)) << res.toString();
+        for (const Component& c : page)
+            ids.push_back(c.id);
+    }
+
+    std::vector<int> expected = { batch[1].id, batch[2].id, batch[4].id, batch[0].id, batch[3].id };
+    EXPECT_EQ(ids, expected);
+}
+
+// 15. ListPage_InvalidPageSize_Fails
+TEST_F(ComponentManagerTest, ListPage_InvalidPageSize_Fails) {
+    ComponentPageCursor cursor;
+    std::vector<Component> page;
+    EXPECT_FALSE(compMgr.listPage(cursor, 0, page, res));
+    EXPECT_TRUE(res.hasError());
+}
+
+// 16. Add_FillsGeneratedFields
+TEST_F(ComponentManagerTest, Add_FillsGeneratedFields) {
+    Component comp("PNRET", "Returning", catId, manId, 1);
+    ASSERT_TRUE(compMgr.add(comp, res)) << res.toString();
+
+    Component fetched;
+    ASSERT_TRUE(compMgr.getById(comp.id, fetched, res)) << res.toString();
+    EXPECT_FALSE(comp.createdOn.empty());
+    EXPECT_EQ(comp.createdOn, fetched.createdOn);
+    EXPECT_EQ(comp.modifiedOn, fetched.modifiedOn);
+}
+
+// 17. Update_FillsModifiedOn_AndRejectsMissingRow
+TEST_F(ComponentManagerTest, Update_FillsModifiedOn_AndRejectsMissingRow) {
+    Component comp("PNUPD", "Before", catId, manId, 1);
+    ASSERT_TRUE(compMgr.add(comp, res)) << res.toString();
+
+    comp.description = "After";
+    comp.modifiedOn.clear();
+    ASSERT_TRUE(compMgr.update(comp, res)) << res.toString();
+
+    Component fetched;
+    ASSERT_TRUE(compMgr.getById(comp.id, fetched, res)) << res.toString();
+    EXPECT_EQ(comp.modifiedOn, fetched.modifiedOn);
+
+    Component missing = comp;
+    missing.id = 999999;
+    EXPECT_FALSE(compMgr.update(missing, res));
+    EXPECT_TRUE(res.hasError());
+}
+
+// 18. Search_PrefixMatchesAcrossColumns
+TEST_F(ComponentManagerTest, Search_PrefixMatchesAcrossColumns) {
+    Component reg("LM317T", "Adjustable voltage regulator", catId, manId, 5);
+    Component ref("TL431", "Shunt reference", catId, manId, 5, "Pairs with LM317T");
+    Component cap("GRM188R71", "MLCC 100nF", catId, manId, 5);
+    ASSERT_TRUE(compMgr.add(reg, res));
+    ASSERT_TRUE(compMgr.add(ref, res));
+    ASSERT_TRUE(compMgr.add(cap, res));
+
+    std::vector<Component> found;
+    ASSERT_TRUE(compMgr.search("lm31", 10, found, res)) << res.toString();
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0].id, reg.id);   // part-number hit ranks above notes hit
+    EXPECT_EQ(found[1].id, ref.id);
+
+    // Every term must match
+    ASSERT_TRUE(compMgr.search("lm317 regul", 10, found, res)) << res.toString();
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].id, reg.id);
+
+    ASSERT_TRUE(compMgr.search("lm31", 1, found, res));
+    EXPECT_EQ(found.size(), 1u);
+
+    ASSERT_TRUE(compMgr.search("   ", 10, found, res));
+    EXPECT_TRUE(found.empty());
+}
+
+// 19. Search_FollowsUpdatesAndDeletes
+TEST_F(ComponentManagerTest, Search_FollowsUpdatesAndDeletes) {
+    Component comp("BC547", "NPN transistor", catId, manId, 10);
+    ASSERT_TRUE(compMgr.add(comp, res));
+
+    comp.partNumber = "BC337";
+    ASSERT_TRUE(compMgr.update(comp, res)) << res.toString();
+
+    std::vector<Component> found;
+    ASSERT_TRUE(compMgr.search("BC547", 10, found, res));
+    EXPECT_TRUE(found.empty());
+    ASSERT_TRUE(compMgr.search("BC337", 10, found, res));
+    ASSERT_EQ(found.size(), 1u);
+
+    ASSERT_TRUE(compMgr.remove(comp.id, res));
+    ASSERT_TRUE(compMgr.search("BC337", 10, found, res));
+    EXPECT_TRUE(found.empty());
+}
+
+// 20. Search_TreatsInputAsPlainText
+TEST_F(ComponentManagerTest, Search_TreatsInputAsPlainText) {
+    Component comp("RC0805FR-0710KL", "Resistor 10k \"thick film\"", catId, manId, 100);
+    ASSERT_TRUE(compMgr.add(comp, res));
+
+    std::vector<Component> found;
+    ASSERT_TRUE(compMgr.search("RC0805FR-07", 10, found, res)) << res.toString();
+    ASSERT_EQ(found.size(), 1u);
+
+    // FTS5 operators and quotes are searched for, not interpreted
+    EXPECT_TRUE(compMgr.search("\"thick AND OR NOT ( *", 10, found, res)) << res.toString();
+    EXPECT_TRUE(found.empty());
+}
+
+// 21. RemoveMany_CascadesAndSkipsUnknownIds
+TEST_F(ComponentManagerTest, RemoveMany_CascadesAndSkipsUnknownIds) {
+    std::vector<int> ids;
+    for (int i = 0; i < 5; ++i) {
+        Component comp("PURGE" + std::to_string(i), "obsolete regulator", catId, manId, 1);
+        ASSERT_TRUE(compMgr.add(comp, res)) << res.toString();
+        ASSERT_TRUE(db.exec("INSERT INTO Resistors (ComponentID, Resistance) VALUES ("
+            + std::to_string(comp.id) + ", 100);", res)) << res.toString();
+        ids.push_back(comp.id);
+    }
+
+    // Duplicates and IDs that do not exist are ignored
+    const std::vector<int> doomed = { ids[0], ids[2], ids[2], ids[4], 999999 };
+    long long removed = -1;
+    ASSERT_TRUE(compMgr.removeMany(doomed, removed, res)) << res.toString();
+    EXPECT_EQ(removed, 3);
+
+    EXPECT_EQ(db.countRows("Components", ""), 2);
+    EXPECT_EQ(db.countRows("Resistors", ""), 2);
+    Component left;
+    EXPECT_TRUE(compMgr.getById(ids[1], left, res));
+    EXPECT_TRUE(compMgr.getById(ids[3], left, res));
+
+    // The search index follows
+    std::vector<Component> found;
+    ASSERT_TRUE(compMgr.search("obsolete", 10, found, res)) << res.toString();
+    EXPECT_EQ(found.size(), 2u);
+
+    // Nothing staged is left behind for the next call
+    ASSERT_TRUE(compMgr.removeMany(std::vector<int>{ ids[1] }, removed, res)) << res.toString();
+    EXPECT_EQ(removed, 1);
+    EXPECT_EQ(db.countRows("temp.PurgeIds", ""), 0);
+}
+
+// 22. RemoveWhere_DeletesMatchingRowsOnly
+TEST_F(ComponentManagerTest, RemoveWhere_DeletesMatchingRowsOnly) {
+    const int otherCat = catMgr.getIdByName("Capacitor", res);
+    ASSERT_GT(otherCat, 0);
+
+    for (int i = 0; i < 6; ++i) {
+        Component comp("PN" + std::to_string(i), "part", i % 2 ? otherCat : catId, manId, i);
+        ASSERT_TRUE(compMgr.add(comp, res)) << res.toString();
+    }
+
+    // Empty stock in one category: quantities 0, 2 in catId
+    ComponentFilter filter;
+    filter.categoryId = catId;
+    filter.maxQuantity = 2;
+    long long removed = -1;
+    ASSERT_TRUE(compMgr.removeWhere(filter, removed, res)) << res.toString();
+    EXPECT_EQ(removed, 2);
+    EXPECT_EQ(db.countRows("Components", ""), 4);
+
+    // Everything last touched before the far future
+    ComponentFilter old;
+    old.modifiedBefore = "9999-01-01";
+    ASSERT_TRUE(compMgr.removeWhere(old, removed, res)) << res.toString();
+    EXPECT_EQ(removed, 4);
+
+    // An empty filter is refused rather than purging the table
+    Component keep("KEEP", "part", catId, manId, 1);
+    ASSERT_TRUE(compMgr.add(keep, res));
+    EXPECT_FALSE(compMgr.removeWhere(ComponentFilter{}, removed, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+    EXPECT_EQ(removed, 0);
+    EXPECT_EQ(db.countRows("Components", ""), 1);
+}
+
+// 23. ListPage_ByPartNumber_MatchesCompareNoCase
+TEST_F(ComponentManagerTest, ListPage_ByPartNumber_MatchesCompareNoCase) {
+    // '_' and '[' sit between the cases; UTF-8 bytes sort after ASCII
+    std::vector<Component> batch;
+    for (const char* pn : { "b_2", "B-2", "_lead", "[x]", "Z9", "\xC3\xA9" "clair", "\xC3\x89" "CLAIR", "a", "A1" })
+        batch.emplace_back(pn, "", catId, manId, 1);
+    ASSERT_TRUE(compMgr.addBatch(batch, res)) << res.toString();
+
+    ComponentPageCursor cursor;
+    cursor.order = ComponentOrder::ByPartNumber;
+    std::vector<Component> listed;
+    std::vector<Component> page;
+    while (!cursor.atEnd) {
+        ASSERT_TRUE(compMgr.listPage(cursor, 4, page, res)) << res.toString();
+        listed.insert(listed.end(), page.begin(), page.end());
+    }
+
+    ASSERT_EQ(listed.size(), batch.size());
+    for (std::size_t i = 1; i < listed.size(); ++i) {
+        const int cmp = compareNoCase(listed[i - 1].partNumber, listed[i].partNumber);
+        EXPECT_TRUE(cmp < 0 || (cmp == 0 && listed[i - 1].id < listed[i].id))
+            << listed[i - 1].partNumber << " before " << listed[i].partNumber;
+    }
+    EXPECT_EQ(compareNoCase("b_2", "B-2"), 1);
+    EXPECT_LT(compareNoCase("[x]", "_lead"), 0);
+    EXPECT_GT(compareNoCase("Z9", "[x]"), 0);   // folds to z, past [
+}
@@ -0,0 +1,183 @@
+#include "BackendTestFixture.h"
+#include "CsvImporter.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "CapacitorManager.h"
+
+#include <sstream>
+
+class CsvImporterTest : public BackendTestFixture {
+protected:
+    CsvImporter importer;
+    ComponentManager compMgr;
+    ResistorManager resistorMgr;
+    CapacitorManager capMgr;
+    CsvImportOptions options;
+    ImportReport report;
+
+    CsvImporterTest()
+        : importer(db), compMgr(db), resistorMgr(db), capMgr(db) {
+        // Small chunks across several threads, so ordering is exercised
+        options.parseThreads = 3;
+        options.chunkRows = 2;
+        options.queueChunks = 2;
+    }
+
+    bool import(const std::string& csv) {
+        std::istringstream in(csv);
+        return importer.importStream(in, options, report, res);
+    }
+
+    int componentId(const std::string& pn) {
+        std::vector<Component> found;
+        EXPECT_TRUE(compMgr.findByPartNumber(pn, found, res)) << res.toString();
+        return found.size() == 1 ? found[0].id : -1;
+    }
+};
+
+// 1. Import_WritesComponentsAndSubtypes
+TEST_F(CsvImporterTest, Import_WritesComponentsAndSubtypes) {
+    ASSERT_TRUE(import(
+        "\xEF\xBB\xBFPart Number,Category,Manufacturer,Description,Quantity,Resistance,Tolerance,Power Rating,Package,Capacitance,Voltage Rating,Dielectric,Unused\r\n"
+        "RC0805-10K,Resistor,Generic,\"Thick film, 1%\",250,10k,1,0.125W,0805,,,,x\r\n"
+        "GRM21-100N,Capacitor,Generic,\"MLCC\nsecond line\",1000,,,,Radial leaded,100nF,50V,X7R,x\r\n"
+        "1N4148,Diode,,Signal diode,5,,,,,,,,x\r\n"
+        "RES-NOVALUE,resistor,,No ratings,1,,,,,,,,x\r\n"
+        "\r\n")) << res.toString();
+    EXPECT_TRUE(res.ok()) << res.toString();
+
+    EXPECT_EQ(report.rowsRead, 4);
+    EXPECT_EQ(report.rowsImported, 4);
+    EXPECT_EQ(report.rowsFailed, 0);
+    EXPECT_EQ(report.transactions, 1);
+
+    // Written in file order
+    int r = componentId("RC0805-10K");
+    int c = componentId("GRM21-100N");
+    int t = componentId("1N4148");
+    ASSERT_GT(r, 0);
+    EXPECT_LT(r, c);
+    EXPECT_LT(c, t);
+
+    Component comp;
+    ASSERT_TRUE(compMgr.getById(c, comp, res)) << res.toString();
+    EXPECT_EQ(comp.description, "MLCC\nsecond line");
+    EXPECT_EQ(comp.quantity, 1000);
+
+    Resistor resistor;
+    ASSERT_TRUE(resistorMgr.getByComponentId(r, resistor, res)) << res.toString();
+    EXPECT_DOUBLE_EQ(resistor.resistance, 10000.0);
+    EXPECT_DOUBLE_EQ(resistor.powerRating, 0.125);
+    EXPECT_EQ(resistor.packageTypeId, ResistorPackageManager(db).getByName("0805", res));
+
+    Capacitor cap;
+    ASSERT_TRUE(capMgr.getById(c, cap, res)) << res.toString();
+    EXPECT_NEAR(cap.capacitance, 100e-9, 1e-15);
+    EXPECT_DOUBLE_EQ(cap.voltageRating, 50.0);
+
+    // A resistor row without a resistance value is a plain component
+    EXPECT_EQ(db.countRows("Resistors", "ComponentID=" + std::to_string(componentId("RES-NOVALUE"))), 0);
+}
+
+// 2. Import_ReportsBadRowsAndKeepsGoodOnes
+TEST_F(CsvImporterTest, Import_ReportsBadRowsAndKeepsGoodOnes) {
+    ASSERT_TRUE(import(
+        "PartNumber,Category,Manufacturer,Quantity,Resistance\n"
+        "GOOD-1,Resistor,Generic,1,1k\n"
+        ",Resistor,Generic,1,1k\n"
+        "BAD-MAN,Resistor,NoSuchCorp,1,1k\n"
+        "BAD-QTY,Resistor,Generic,lots,1k\n"
+        "BAD-OHMS,Resistor,Generic,1,ten\n"
+        "GOOD-2,Resistor,Generic,1,2.2k\n"
+        "BAD-QUOTE,Resistor,Generic,1,\"1k\n")) << res.toString();
+
+    EXPECT_TRUE(res.hasWarning());
+    EXPECT_EQ(report.rowsRead, 7);
+    EXPECT_EQ(report.rowsImported, 2);
+    EXPECT_EQ(report.rowsFailed, 5);
+
+    ASSERT_EQ(report.errors.size(), 5u);
+    EXPECT_EQ(report.errors[0].line, 3);
+    EXPECT_EQ(report.errors[0].result.code, static_cast<int>(ImportError::MissingField));
+    EXPECT_EQ(report.errors[1].line, 4);
+    EXPECT_EQ(report.errors[1].result.code, static_cast<int>(ImportError::UnknownLookup));
+    EXPECT_NE(report.errors[1].result.message.find("NoSuchCorp"), std::string::npos);
+    EXPECT_EQ(report.errors[2].result.code, static_cast<int>(ImportError::InvalidNumber));
+    EXPECT_EQ(report.errors[3].result.code, static_cast<int>(ImportError::InvalidNumber));
+    EXPECT_EQ(report.errors[4].line, 8);
+    EXPECT_EQ(report.errors[4].result.code, static_cast<int>(ImportError::MalformedRecord));
+
+    EXPECT_GT(componentId("GOOD-1"), 0);
+    EXPECT_GT(componentId("GOOD-2"), 0);
+    EXPECT_EQ(db.countRows("Components", "PartNumber LIKE 'BAD-%'"), 0);
+}
+
+// 3. Import_AddMissingLookups_CreatesNames
+TEST_F(CsvImporterTest, Import_AddMissingLookups_CreatesNames) {
+    options.addMissingLookups = true;
+    ASSERT_TRUE(import(
+        "PartNumber,Category,Manufacturer,Resistance,Package\n"
+        "NEW-1,Resistor,Brand New Corp,1k,1206\n"
+        "NEW-2,Resistor,brand new corp,2k,1206\n")) << res.toString();
+    EXPECT_TRUE(res.ok()) << res.toString();
+    EXPECT_EQ(report.rowsImported, 2);
+
+    EXPECT_EQ(db.countRows("Manufacturers", "Name='Brand New Corp'"), 1);
+    EXPECT_EQ(db.countRows("ResistorPackage", "Name='1206'"), 1);
+    EXPECT_EQ(db.countRows("Resistors",
+        "PackageTypeID=(SELECT ID FROM ResistorPackage WHERE Name='1206')"), 2);
+}
+
+// 4. Import_MissingRequiredColumn_Fails
+TEST_F(CsvImporterTest, Import_MissingRequiredColumn_Fails) {
+    EXPECT_FALSE(import("PartNumber,Manufacturer\nX,Generic\n"));
+    EXPECT_EQ(res.code, static_cast<int>(ImportError::MissingColumn));
+    EXPECT_EQ(db.countRows("Components", "1=1"), 0);
+
+    ImportReport fileReport;
+    EXPECT_FALSE(importer.importFile("/nonexistent/bom.csv", options, fileReport, res));
+    EXPECT_EQ(res.code, SQLITE_CANTOPEN);
+}
+
+// 5. Import_CommitsInBatchesAndRebuildsSearchIndex
+TEST_F(CsvImporterTest, Import_CommitsInBatchesAndRebuildsSearchIndex) {
+    std::string csv = "PartNumber,Category,Quantity\n";
+    for (int i = 0; i < 5000; ++i)
+        csv += "BULK-" + std::to_string(i) + ",Resistor," + std::to_string(i) + "\n";
+
+    options.chunkRows = 256;
+    options.batchRows = 1000;
+    options.deferSearchIndex = true;
+    ASSERT_TRUE(import(csv)) << res.toString();
+
+    EXPECT_EQ(report.rowsImported, 5000);
+    EXPECT_EQ(report.transactions, 5);
+    EXPECT_GT(report.rowsPerSecond(), 0.0);
+    EXPECT_EQ(db.countRows("Components", "PartNumber LIKE 'BULK-%'"), 5000);
+    EXPECT_FALSE(db.inTransaction());
+
+    // Triggers are back and the deferred rows are searchable
+    EXPECT_EQ(db.countRows("sqlite_master", "type='trigger' AND name='components_fts_insert'"), 1);
+    EXPECT_EQ(db.countRows("ComponentsFts", "ComponentsFts MATCH 'bulk*'"), 5000);
+}
+
+// 6. Import_OneChunkWindowKeepsFileOrder
+TEST_F(CsvImporterTest, Import_OneChunkWindowKeepsFileOrder) {
+    std::string csv = "PartNumber,Category,Quantity\n";
+    for (int i = 0; i < 400; ++i)
+        csv += "ORDER-" + std::to_string(i) + ",Resistor,1\n";
+
+    // Every parse thread but the one holding the next chunk must wait
+    options.parseThreads = 6;
+    options.chunkRows = 1;
+    options.queueChunks = 1;
+    ASSERT_TRUE(import(csv)) << res.toString();
+    EXPECT_EQ(report.rowsImported, 400);
+
+    int previous = 0;
+    for (int i = 0; i < 400; i += 37) {
+        const int id = componentId("ORDER-" + std::to_string(i));
+        EXPECT_GT(id, previous) << "row " << i;
+        previous = id;
+    }
+}
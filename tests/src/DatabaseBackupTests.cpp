@@ -0,0 +1,140 @@
+#include "BackendTestFixture.h"
+#include "InventoryService.h"
+#include "DatabaseBackup.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+
+class DatabaseBackupTest : public ::testing::Test {
+protected:
+    DbResult res;
+    std::unique_ptr<InventoryService> service;
+    std::string sourcePath = tempDbPath("inventory_backup_test.db");
+    std::string backupPath = tempDbPath("inventory_backup_copy.db");
+    int categoryId = 0;
+
+    void SetUp() override {
+        service = InventoryService::open(sourcePath, DatabaseOptions::interactive(), res);
+        ASSERT_NE(service, nullptr) << res.toString();
+        categoryId = service->categories().getIdByName("Resistor", res);
+    }
+
+    void addComponents(int first, int count) {
+        Transaction tx = service->transaction(res);
+        ASSERT_TRUE(tx.isActive()) << res.toString();
+        for (int i = first; i < first + count; ++i) {
+            Component c("BK" + std::to_string(i), "backup test part with a longer description",
+                categoryId, 0, 1);
+            ASSERT_TRUE(service->components().add(c, res)) << res.toString();
+        }
+        ASSERT_TRUE(tx.commit(res)) << res.toString();
+    }
+
+    // Components in the backup, -1 if it does not open or is corrupt
+    int componentsInBackup() {
+        DbResult r;
+        Database copy(backupPath, DatabaseOptions::readOnlyReporting(), r);
+        if (!copy.isOpen())
+            return -1;
+        sqlite3_stmt* stmt = nullptr;
+        if (!copy.prepare("PRAGMA integrity_check;", stmt, r))
+            return -1;
+        const bool intact = sqlite3_step(stmt) == SQLITE_ROW
+            && std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))) == "ok";
+        copy.finalize(stmt);
+        return intact ? copy.countRows("Components", "") : -1;
+    }
+};
+
+// 1. BackupTo_CopiesSnapshotWhileWriterCommits
+TEST_F(DatabaseBackupTest, BackupTo_CopiesSnapshotWhileWriterCommits) {
+    addComponents(0, 3000);
+
+    std::atomic<int> steps{ 0 };
+    BackupProgress last;
+    BackupOptions options;
+    options.pagesPerStep = 8;
+    options.pause = std::chrono::milliseconds(1);
+    auto backup = service->backupTo(backupPath, [&](const BackupProgress& p) {
+        ++steps;
+        last = p;
+    }, options);
+
+    // The service keeps committing while the copy runs
+    int added = 0;
+    while (backup.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) {
+        addComponents(3000 + added, 10);
+        added += 10;
+    }
+
+    const DbResult result = backup.get();
+    ASSERT_TRUE(result.ok()) << result.toString();
+    EXPECT_GT(steps, 1);
+    EXPECT_GT(added, 0);
+    EXPECT_EQ(last.pagesCopied, last.pagesTotal);
+    EXPECT_FALSE(std::filesystem::exists(backupPath + ".partial"));
+
+    const int copied = componentsInBackup();
+    EXPECT_GE(copied, 3000);
+    EXPECT_LE(copied, 3000 + added);
+    EXPECT_EQ(copied % 10, 0);      // whole transactions only
+}
+
+// 2. BackupTo_CancelLeavesNoFile
+TEST_F(DatabaseBackupTest, BackupTo_CancelLeavesNoFile) {
+    addComponents(0, 3000);
+
+    std::stop_source stop;
+    BackupOptions options;
+    options.pagesPerStep = 4;
+    options.cancel = stop.get_token();
+    const DbResult result = service->backupTo(backupPath, [&](const BackupProgress&) {
+        stop.request_stop();
+    }, options).get();
+
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(result.code, SQLITE_INTERRUPT);
+    EXPECT_FALSE(std::filesystem::exists(backupPath));
+    EXPECT_FALSE(std::filesystem::exists(backupPath + ".partial"));
+
+    // Cancelled before starting, compact mode stops as well
+    options.compact = true;
+    const DbResult compacted = service->backupTo(backupPath, {}, options).get();
+    EXPECT_EQ(compacted.code, SQLITE_INTERRUPT);
+    EXPECT_FALSE(std::filesystem::exists(backupPath));
+}
+
+// 3. BackupTo_CompactWritesSmallerCopy
+TEST_F(DatabaseBackupTest, BackupTo_CompactWritesSmallerCopy) {
+    addComponents(0, 3000);
+    ComponentFilter filter;
+    filter.categoryId = categoryId;
+    long long removed = 0;
+    ASSERT_TRUE(service->components().removeWhere(filter, removed, res)) << res.toString();
+    addComponents(5000, 10);
+
+    DbResult result = service->backupTo(backupPath).get();
+    ASSERT_TRUE(result.ok()) << result.toString();
+    const auto pageCopySize = std::filesystem::file_size(backupPath);
+    EXPECT_EQ(componentsInBackup(), 10);
+
+    BackupOptions options;
+    options.compact = true;
+    BackupProgress last;
+    result = service->backupTo(backupPath, [&](const BackupProgress& p) { last = p; }, options).get();
+    ASSERT_TRUE(result.ok()) << result.toString();
+    EXPECT_LT(std::filesystem::file_size(backupPath), pageCopySize);
+    EXPECT_GT(last.pagesTotal, 0);
+    EXPECT_EQ(componentsInBackup(), 10);
+}
+
+// 4. BackupTo_RejectsInMemoryAndSelf
+TEST_F(DatabaseBackupTest, BackupTo_RejectsInMemoryAndSelf) {
+    auto memory = InventoryService::open(":memory:", res);
+    ASSERT_NE(memory, nullptr) << res.toString();
+    EXPECT_EQ(memory->backupTo(backupPath).get().code, SQLITE_MISUSE);
+
+    const DbResult self = service->backupTo(sourcePath).get();
+    EXPECT_EQ(self.code, SQLITE_MISUSE);
+}
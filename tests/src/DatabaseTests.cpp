@@ -48,3 +48,201 @@ TEST_F(DatabaseTest, ExecuteInvalidSQL_ReturnsError) {
     EXPECT_FALSE(ok);
     EXPECT_FALSE(res.ok());  // DbResult should indicate error
 }
+
+// 5. PrepareCached_ReusesStatement
+TEST_F(DatabaseTest, PrepareCached_ReusesStatement) {
+    Database db(":memory:", res);
+    ASSERT_TRUE(db.isOpen());
+    ASSERT_TRUE(db.exec("CREATE TABLE Test (ID INTEGER PRIMARY KEY, Name TEXT);", res));
+
+    sqlite3_stmt* first = nullptr;
+    {
+        CachedStatement stmt;
+        ASSERT_TRUE(db.prepareCached("SELECT Name FROM Test WHERE ID=?;", stmt, res)) << res.toString();
+        first = stmt.get();
+    }
+
+    CachedStatement stmt;
+    ASSERT_TRUE(db.prepareCached("SELECT Name FROM Test WHERE ID=?;", stmt, res)) << res.toString();
+    EXPECT_EQ(stmt.get(), first);
+    EXPECT_EQ(db.statementCache().size(), 1u);
+}
+
+// 6. PrepareCached_ReleaseResetsAndClearsBindings
+TEST_F(DatabaseTest, PrepareCached_ReleaseResetsAndClearsBindings) {
+    Database db(":memory:", res);
+    ASSERT_TRUE(db.isOpen());
+    ASSERT_TRUE(db.exec("CREATE TABLE Test (ID INTEGER PRIMARY KEY, Name TEXT);", res));
+    ASSERT_TRUE(db.exec("INSERT INTO Test (ID, Name) VALUES (1, 'Row1');", res));
+
+    {
+        CachedStatement stmt;
+        ASSERT_TRUE(db.prepareCached("SELECT ?;", stmt, res));
+        sqlite3_bind_int(stmt, 1, 42);
+        ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+        // Left mid-step on purpose
+    }
+
+    CachedStatement stmt;
+    ASSERT_TRUE(db.prepareCached("SELECT ?;", stmt, res));
+    EXPECT_FALSE(sqlite3_stmt_busy(stmt));
+    ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+    EXPECT_EQ(sqlite3_column_type(stmt, 0), SQLITE_NULL);
+}
+
+// 7. PrepareCached_EvictsLeastRecentlyUsed
+TEST_F(DatabaseTest, PrepareCached_EvictsLeastRecentlyUsed) {
+    Database db(":memory:", res);
+    ASSERT_TRUE(db.isOpen());
+    db.statementCache().setCapacity(2);
+
+    for (const char* sql : { "SELECT 1;", "SELECT 2;", "SELECT 1;", "SELECT 3;" }) {
+        CachedStatement stmt;
+        ASSERT_TRUE(db.prepareCached(sql, stmt, res)) << res.toString();
+    }
+
+    EXPECT_EQ(db.statementCache().size(), 2u);
+
+    // "SELECT 2;" was least recently used and should have been evicted
+    sqlite3_stmt* again = nullptr;
+    {
+        CachedStatement stmt;
+        ASSERT_TRUE(db.prepareCached("SELECT 1;", stmt, res));
+        again = stmt.get();
+    }
+    CachedStatement stmt;
+    ASSERT_TRUE(db.prepareCached("SELECT 1;", stmt, res));
+    EXPECT_EQ(stmt.get(), again);
+}
+
+// 8. PrepareCached_NestedSameSqlGetsDistinctStatement
+TEST_F(DatabaseTest, PrepareCached_NestedSameSqlGetsDistinctStatement) {
+    Database db(":memory:", res);
+    ASSERT_TRUE(db.isOpen());
+
+    CachedStatement outer;
+    ASSERT_TRUE(db.prepareCached("SELECT 1;", outer, res));
+
+    CachedStatement inner;
+    ASSERT_TRUE(db.prepareCached("SELECT 1;", inner, res));
+    EXPECT_NE(outer.get(), inner.get());
+    EXPECT_EQ(db.statementCache().size(), 1u);
+}
+
+// 9. PrepareCached_InvalidSql_ReturnsError
+TEST_F(DatabaseTest, PrepareCached_InvalidSql_ReturnsError) {
+    Database db(":memory:", res);
+    ASSERT_TRUE(db.isOpen());
+
+    CachedStatement stmt;
+    EXPECT_FALSE(db.prepareCached("SELECT FROM nowhere;", stmt, res));
+    EXPECT_TRUE(res.hasError());
+    EXPECT_FALSE(stmt);
+    EXPECT_EQ(db.statementCache().size(), 0u);
+}
+
+namespace {
+
+std::string pragmaText(Database& db, const std::string& pragma) {
+    sqlite3_stmt* stmt = nullptr;
+    DbResult r;
+    std::string value;
+    if (db.prepare("PRAGMA " + pragma + ";", stmt, r) && sqlite3_step(stmt) == SQLITE_ROW)
+        value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    db.finalize(stmt);
+    return value;
+}
+
+} // namespace
+
+// 10. OpenInteractiveProfile_AppliesPragmas
+TEST_F(DatabaseTest, OpenInteractiveProfile_AppliesPragmas) {
+    const std::string path = tempDbPath("inventory_interactive_test.db");
+    Database db(path, DatabaseOptions::interactive(), res);
+    ASSERT_TRUE(db.isOpen()) << res.toString();
+
+    EXPECT_EQ(pragmaText(db, "journal_mode"), "wal");
+    EXPECT_EQ(pragmaText(db, "synchronous"), "1");      // NORMAL
+    EXPECT_EQ(pragmaText(db, "temp_store"), "2");       // MEMORY
+    EXPECT_EQ(pragmaText(db, "busy_timeout"), "5000");
+    EXPECT_FALSE(db.isReadOnly());
+}
+
+// 11. OpenReadOnlyProfile_RejectsWrites
+TEST_F(DatabaseTest, OpenReadOnlyProfile_RejectsWrites) {
+    const std::string path = tempDbPath("inventory_readonly_test.db");
+    {
+        Database writer(path, DatabaseOptions::interactive(), res);
+        ASSERT_TRUE(writer.isOpen());
+        ASSERT_TRUE(writer.exec("CREATE TABLE Test (ID INTEGER PRIMARY KEY, Name TEXT);", res));
+        ASSERT_TRUE(writer.exec("INSERT INTO Test (Name) VALUES ('Row1');", res));
+    }
+
+    Database reader(path, DatabaseOptions::readOnlyReporting(), res);
+    ASSERT_TRUE(reader.isOpen()) << res.toString();
+    EXPECT_TRUE(reader.isReadOnly());
+    EXPECT_EQ(reader.countRows("Test", ""), 1);
+
+    EXPECT_FALSE(reader.exec("INSERT INTO Test (Name) VALUES ('Row2');", res));
+    EXPECT_FALSE(res.ok());
+}
+
+// 12. OpenReadOnlyProfile_MissingFile_Fails
+TEST_F(DatabaseTest, OpenReadOnlyProfile_MissingFile_Fails) {
+    const std::string path = tempDbPath("inventory_missing_test.db");
+    Database db(path, DatabaseOptions::readOnlyReporting(), res);
+    EXPECT_FALSE(db.isOpen());
+    EXPECT_FALSE(res.ok());
+}
+
+// 13. WalReaderSeesCommittedDataWhileWriterHoldsTransaction
+TEST_F(DatabaseTest, WalReaderSeesCommittedDataWhileWriterHoldsTransaction) {
+    const std::string path = tempDbPath("inventory_wal_concurrency_test.db");
+    Database writer(path, DatabaseOptions::bulkLoad(), res);
+    ASSERT_TRUE(writer.isOpen());
+    ASSERT_TRUE(writer.exec("CREATE TABLE Test (ID INTEGER PRIMARY KEY, Name TEXT);", res));
+    ASSERT_TRUE(writer.exec("INSERT INTO Test (Name) VALUES ('Row1');", res));
+
+    Database reader(path, DatabaseOptions::interactive(), res);
+    ASSERT_TRUE(reader.isOpen());
+
+    // An open write transaction must not block readers under WAL
+    ASSERT_TRUE(writer.exec("BEGIN IMMEDIATE; INSERT INTO Test (Name) VALUES ('Row2');", res));
+    EXPECT_EQ(reader.countRows("Test", ""), 1);
+    ASSERT_TRUE(writer.exec("COMMIT;", res));
+    EXPECT_EQ(reader.countRows("Test", ""), 2);
+}
+
+// 14. FromProfileName_ResolvesKnownProfiles
+TEST_F(DatabaseTest, FromProfileName_ResolvesKnownProfiles) {
+    DatabaseOptions options;
+    EXPECT_TRUE(DatabaseOptions::fromProfileName("interactive", options));
+    EXPECT_EQ(options.journalMode, DatabaseOptions::JournalMode::Wal);
+
+    EXPECT_TRUE(DatabaseOptions::fromProfileName("bulk-load", options));
+    EXPECT_EQ(options.synchronous, DatabaseOptions::Synchronous::Off);
+
+    EXPECT_TRUE(DatabaseOptions::fromProfileName("read-only-reporting", options));
+    EXPECT_TRUE(options.readOnly);
+
+    EXPECT_FALSE(DatabaseOptions::fromProfileName("turbo", options));
+}
+
+// 15. Destructor_ClosesOnceStrayStatementIsFinalized
+TEST_F(DatabaseTest, Destructor_ClosesOnceStrayStatementIsFinalized) {
+    { Database warmUp(":memory:", res); }   // SQLite's one-time allocations
+    const sqlite3_int64 before = sqlite3_memory_used();
+
+    sqlite3_stmt* stray = nullptr;
+    {
+        Database db(":memory:", res);
+        ASSERT_TRUE(db.exec("CREATE TABLE t(x); INSERT INTO t VALUES (1), (2);", res)) << res.toString();
+        ASSERT_TRUE(db.prepare("SELECT x FROM t;", stray, res)) << res.toString();
+        ASSERT_EQ(sqlite3_step(stray), SQLITE_ROW);
+    }
+
+    // The connection outlives its Database only until the statement goes
+    EXPECT_EQ(sqlite3_step(stray), SQLITE_ROW);
+    sqlite3_finalize(stray);
+    EXPECT_EQ(sqlite3_memory_used(), before);
+}
@@ -0,0 +1,117 @@
+#include "BackendTestFixture.h"
+#include "DatasetGenerator.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "ParametricQuery.h"
+
+class DatasetGeneratorTest : public BackendTestFixture {
+protected:
+    DatasetGenerator generator;
+    DatasetReport report;
+
+    DatasetGeneratorTest() : generator(db) {}
+
+    // Same options against a second, freshly migrated database
+    std::vector<Component> generateElsewhere(const DatasetOptions& options) {
+        DbResult r;
+        Database other(":memory:", r);
+        SchemaManager(other).initialize(r);
+        DatasetReport otherReport;
+        EXPECT_TRUE(DatasetGenerator(other).generate(options, otherReport, r)) << r.toString();
+
+        std::vector<Component> comps;
+        ComponentManager(other).list(comps, r);
+        return comps;
+    }
+};
+
+// 1. Generate_WritesRowsAcrossAllCategories
+TEST_F(DatasetGeneratorTest, Generate_WritesRowsAcrossAllCategories) {
+    DatasetOptions options;
+    options.rows = 3000;
+    options.batchRows = 1000;
+    ASSERT_TRUE(generator.generate(options, report, res)) << res.toString();
+
+    EXPECT_EQ(report.rows, 3000);
+    EXPECT_EQ(report.transactions, 3);
+    EXPECT_EQ(report.resistors + report.capacitors + report.transistors + report.diodes + report.fuses, 3000);
+    EXPECT_GT(report.resistors, report.fuses);
+    EXPECT_GT(report.fuses, 0);
+
+    // Every component has its subtype row
+    EXPECT_EQ(db.countRows("Components", ""), 3000);
+    EXPECT_EQ(db.countRows("Resistors", ""), report.resistors);
+    EXPECT_EQ(db.countRows("Capacitors", ""), report.capacitors);
+    EXPECT_EQ(db.countRows("Transistors", ""), report.transistors);
+    EXPECT_EQ(db.countRows("Diodes", ""), report.diodes);
+    EXPECT_EQ(db.countRows("Fuses", ""), report.fuses);
+    EXPECT_GT(db.countRows("BJTs", ""), 0);
+
+    // The search index was rebuilt after the load
+    std::vector<Component> found;
+    ASSERT_TRUE(ComponentManager(db).search("schottky", 10, found, res)) << res.toString();
+    EXPECT_FALSE(found.empty());
+
+    // Values come from the E24 series
+    std::vector<int> ids;
+    ResistorQuery query;
+    query.between(ResistorField::Resistance, 4699.0, 4701.0);
+    ASSERT_TRUE(ResistorManager(db).find(query, ids, res)) << res.toString();
+    EXPECT_FALSE(ids.empty());
+}
+
+// 2. Generate_SameSeedGivesSameRows
+TEST_F(DatasetGeneratorTest, Generate_SameSeedGivesSameRows) {
+    DatasetOptions options;
+    options.rows = 2500;
+    options.seed = 42;
+    ASSERT_TRUE(generator.generate(options, report, res)) << res.toString();
+    std::vector<Component> mine;
+    ASSERT_TRUE(ComponentManager(db).list(mine, res));
+
+    // Batch size changes only the commits, not the data
+    DatasetOptions smallBatches = options;
+    smallBatches.batchRows = 700;
+    const std::vector<Component> same = generateElsewhere(smallBatches);
+    ASSERT_EQ(same.size(), mine.size());
+    for (std::size_t i = 0; i < mine.size(); ++i) {
+        EXPECT_EQ(same[i].id, mine[i].id);
+        EXPECT_EQ(same[i].partNumber, mine[i].partNumber);
+        EXPECT_EQ(same[i].description, mine[i].description);
+        EXPECT_EQ(same[i].manufacturerId, mine[i].manufacturerId);
+        EXPECT_EQ(same[i].quantity, mine[i].quantity);
+    }
+
+    DatasetOptions otherSeed = options;
+    otherSeed.seed = 43;
+    const std::vector<Component> different = generateElsewhere(otherSeed);
+    ASSERT_EQ(different.size(), mine.size());
+    EXPECT_NE(different[0].partNumber, mine[0].partNumber);
+}
+
+// 3. Generate_RejectsEmptyMix
+TEST_F(DatasetGeneratorTest, Generate_RejectsEmptyMix) {
+    DatasetOptions options;
+    options.mix = DatasetMix{ 0, 0, 0, 0, 0 };
+    EXPECT_FALSE(generator.generate(options, report, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+    EXPECT_EQ(db.countRows("Components", ""), 0);
+
+    // A single-category mix is fine
+    options.mix = DatasetMix{ 0, 0, 0, 0, 1 };
+    options.rows = 50;
+    ASSERT_TRUE(generator.generate(options, report, res)) << res.toString();
+    EXPECT_EQ(report.fuses, 50);
+}
+
+// 4. Generate_SmallBatchesCommitAtBatchRows
+TEST_F(DatasetGeneratorTest, Generate_SmallBatchesCommitAtBatchRows) {
+    DatasetOptions options;
+    options.rows = 1000;
+    options.batchRows = 300;
+    ASSERT_TRUE(generator.generate(options, report, res)) << res.toString();
+
+    EXPECT_EQ(report.rows, 1000);
+    EXPECT_EQ(report.transactions, 4);
+    EXPECT_EQ(db.countRows("Components", ""), 1000);
+}
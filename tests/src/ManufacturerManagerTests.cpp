@@ -1,6 +1,8 @@
 #include "BackendTestFixture.h"
 #include "ManufacturerManager.h"
 #include "LookupItem.h"
+#include "Transaction.h"
+#include "QueryProfiler.h"
 
 class ManufacturerManagerTest : public BackendTestFixture {
 protected:
@@ -140,3 +142,102 @@ TEST_F(ManufacturerManagerTest, AddByName_NormalizesWhitespace) {
     EXPECT_FALSE(manMgr.addByName("Test Manufacturer   Name", res));
     EXPECT_EQ(res.code, static_cast<int>(LookupError::AlreadyExists));
 }
+
+// 9. LookupCache_FollowsWritesOnThisConnection
+TEST_F(ManufacturerManagerTest, LookupCache_FollowsWritesOnThisConnection) {
+    // Warm the cache, then change the table through every write path
+    ASSERT_GT(manMgr.getIdByName("Generic", res), 0);
+    EXPECT_EQ(manMgr.getIdByName("generic", res), manMgr.getIdByName("GENERIC", res));
+
+    ASSERT_TRUE(manMgr.add(Manufacturer("CacheMan"), res)) << res.toString();
+    int id = manMgr.getIdByName("cacheman", res);
+    ASSERT_GT(id, 0);
+
+    std::string name;
+    ASSERT_TRUE(manMgr.getNameById(id, name, res)) << res.toString();
+    EXPECT_EQ(name, "CacheMan");
+
+    Manufacturer renamed;
+    ASSERT_TRUE(manMgr.getById(id, renamed, res)) << res.toString();
+    renamed.name = "CacheManRenamed";
+    ASSERT_TRUE(manMgr.update(renamed, res)) << res.toString();
+    EXPECT_EQ(manMgr.getIdByName("CacheMan", res), -1);
+    EXPECT_EQ(manMgr.getIdByName("CacheManRenamed", res), id);
+
+    ASSERT_TRUE(manMgr.remove(id, res)) << res.toString();
+    EXPECT_EQ(manMgr.getIdByName("CacheManRenamed", res), -1);
+    EXPECT_FALSE(manMgr.getNameById(id, name, res));
+    EXPECT_EQ(res.code, SQLITE_NOTFOUND);
+
+    // A rolled-back insert must not linger in the cache
+    {
+        Transaction tx(db, res);
+        ASSERT_TRUE(tx.isActive()) << res.toString();
+        ASSERT_TRUE(manMgr.addByName("RolledBack", res)) << res.toString();
+        EXPECT_GT(manMgr.getIdByName("RolledBack", res), 0);
+    }
+    EXPECT_EQ(manMgr.getIdByName("RolledBack", res), -1);
+}
+
+// 10. LookupCache_SeesCommitsFromOtherConnections
+TEST_F(ManufacturerManagerTest, LookupCache_SeesCommitsFromOtherConnections) {
+    const std::string path = tempDbPath("inventory_lookup_cache_test.db");
+
+    Database reader(path, res);
+    ASSERT_TRUE(reader.isOpen()) << res.toString();
+    SchemaManager readerSchema(reader);
+    ASSERT_TRUE(readerSchema.initialize(res)) << res.toString();
+
+    ManufacturerManager readerMgr(reader);
+    EXPECT_EQ(readerMgr.getIdByName("OtherConn", res), -1);
+
+    {
+        Database writer(path, res);
+        ASSERT_TRUE(writer.isOpen()) << res.toString();
+        ASSERT_TRUE(writer.exec("INSERT INTO Manufacturers (Name) VALUES ('OtherConn');", res))
+            << res.toString();
+    }
+
+    EXPECT_GT(readerMgr.getIdByName("OtherConn", res), 0);
+}
+
+// 11. LookupCache_ChecksDataVersionOncePerTransaction
+TEST_F(ManufacturerManagerTest, LookupCache_ChecksDataVersionOncePerTransaction) {
+    auto profiler = std::make_shared<QueryProfiler>();
+    db.setProfiler(profiler);
+
+    auto dataVersionCalls = [&profiler] {
+        for (const QueryStats& stats : profiler->snapshot())
+            if (stats.sql == "PRAGMA data_version;")
+                return stats.calls;
+        return 0LL;
+    };
+
+    {
+        Transaction tx(db, res);
+        ASSERT_TRUE(tx.isActive()) << res.toString();
+        for (int i = 0; i < 10; ++i)
+            ASSERT_GT(manMgr.getIdByName("Generic", res), 0);
+        EXPECT_EQ(dataVersionCalls(), 1);
+
+        // Own writes still reload the copy
+        ASSERT_TRUE(manMgr.addByName("InTransaction", res)) << res.toString();
+        EXPECT_GT(manMgr.getIdByName("InTransaction", res), 0);
+        ASSERT_TRUE(tx.commit(res)) << res.toString();
+    }
+
+    // A new transaction checks again; outside one every call does
+    profiler->reset();
+    {
+        Transaction tx(db, res);
+        ASSERT_TRUE(tx.isActive()) << res.toString();
+        ASSERT_GT(manMgr.getIdByName("Generic", res), 0);
+        ASSERT_GT(manMgr.getIdByName("Generic", res), 0);
+    }
+    EXPECT_EQ(dataVersionCalls(), 1);
+    ASSERT_GT(manMgr.getIdByName("Generic", res), 0);
+    ASSERT_GT(manMgr.getIdByName("Generic", res), 0);
+    EXPECT_EQ(dataVersionCalls(), 3);
+
+    db.setProfiler(nullptr);
+}
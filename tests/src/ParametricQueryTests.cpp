@@ -0,0 +1,158 @@
+#include "BackendTestFixture.h"
+#include "ComponentManager.h"
+#include "ResistorManager.h"
+#include "CapacitorManager.h"
+#include "FuseManager.h"
+#include "ParametricQuery.h"
+
+#include <algorithm>
+
+class ParametricQueryTest : public BackendTestFixture {
+protected:
+    ComponentManager compMgr;
+    ResistorManager resistorMgr;
+    CapacitorManager capMgr;
+    FuseManager fuseMgr;
+
+    ParametricQueryTest()
+        : compMgr(db), resistorMgr(db), capMgr(db), fuseMgr(db) {
+    }
+
+    int addComponent(const std::string& pn) {
+        Component c(pn, "Parametric test part", catId, manId, 1);
+        EXPECT_TRUE(compMgr.add(c, res)) << res.toString();
+        return c.id;
+    }
+
+    // Package names are the Migration 5 seeds
+    int addResistor(const std::string& pn, double ohms, double tol, double watts,
+                    const std::string& package) {
+        int id = addComponent(pn);
+        EXPECT_TRUE(db.exec(
+            "INSERT INTO Resistors (ComponentID, Resistance, Tolerance, PowerRating, PackageTypeID) "
+            "VALUES (" + std::to_string(id) + ", " + std::to_string(ohms) + ", "
+            + std::to_string(tol) + ", " + std::to_string(watts) + ", "
+            "(SELECT ID FROM ResistorPackage WHERE Name = '" + package + "'));", res)) << res.toString();
+        return id;
+    }
+
+    int addCapacitor(const std::string& pn, double farads, double volts,
+                     const std::string& dielectric) {
+        int id = addComponent(pn);
+        EXPECT_TRUE(db.exec(
+            "INSERT INTO Capacitors (ComponentID, Capacitance, VoltageRating, DielectricTypeID) "
+            "VALUES (" + std::to_string(id) + ", " + std::to_string(farads) + ", "
+            + std::to_string(volts) + ", "
+            "(SELECT ID FROM CapacitorDielectric WHERE Name = '" + dielectric + "'));", res)) << res.toString();
+        return id;
+    }
+
+    static std::string queryPlan(Database& db, const std::string& sql) {
+        DbResult r;
+        sqlite3_stmt* stmt = nullptr;
+        if (!db.prepare("EXPLAIN QUERY PLAN " + sql, stmt, r))
+            return r.toString();
+        std::string plan;
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+            plan += reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+        db.finalize(stmt);
+        return plan;
+    }
+};
+
+// 1. ResistorQuery_CombinesRangesAndPackage
+TEST_F(ParametricQueryTest, ResistorQuery_CombinesRangesAndPackage) {
+    int match1 = addResistor("R_MATCH_1", 10000.0, 1.0, 0.25, "0805");
+    int match2 = addResistor("R_MATCH_2", 9530.0, 0.1, 0.5, "0805");
+    addResistor("R_WRONG_VALUE", 12000.0, 1.0, 0.25, "0805");
+    addResistor("R_WRONG_TOL", 10000.0, 5.0, 0.25, "0805");
+    addResistor("R_WRONG_POWER", 10000.0, 1.0, 0.125, "0805");
+    addResistor("R_WRONG_PKG", 10000.0, 1.0, 0.25, "0603");
+
+    ResistorQuery q;
+    q.between(ResistorField::Resistance, 9.5e3, 10.5e3)
+     .atMost(ResistorField::Tolerance, 1.0)
+     .atLeast(ResistorField::PowerRating, 0.25)
+     .is(ResistorField::Package, "0805");
+
+    std::vector<int> ids;
+    ASSERT_TRUE(resistorMgr.find(q, ids, res)) << res.toString();
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<int>{ match1, match2 }));
+
+    // Bounds are inclusive, and LIMIT caps the result
+    ResistorQuery exact;
+    exact.between(ResistorField::Resistance, 10000.0, 10000.0).limit(2);
+    ASSERT_TRUE(resistorMgr.find(exact, ids, res)) << res.toString();
+    EXPECT_EQ(ids.size(), 2u);
+}
+
+// 2. CapacitorQuery_MatchesDielectricByIdOrName
+TEST_F(ParametricQueryTest, CapacitorQuery_MatchesDielectricByIdOrName) {
+    int match = addCapacitor("C_MATCH", 22e-6, 25.0, "X7R");
+    addCapacitor("C_LOW_V", 22e-6, 16.0, "X7R");
+    addCapacitor("C_SMALL", 1e-6, 50.0, "X7R");
+    addCapacitor("C_Y5V", 22e-6, 50.0, "Y5V");
+
+    CapacitorQuery byName;
+    byName.atLeast(CapacitorField::Capacitance, 10e-6)
+          .atLeast(CapacitorField::VoltageRating, 25.0)
+          .is(CapacitorField::Dielectric, "X7R");
+
+    std::vector<int> ids;
+    ASSERT_TRUE(capMgr.find(byName, ids, res)) << res.toString();
+    EXPECT_EQ(ids, (std::vector<int>{ match }));
+
+    CapacitorDielectricManager dielectricMgr(db);
+    int x7r = dielectricMgr.getByName("X7R", res);
+    ASSERT_GT(x7r, 0);
+
+    CapacitorQuery byId;
+    byId.atLeast(CapacitorField::Capacitance, 10e-6)
+        .atLeast(CapacitorField::VoltageRating, 25.0)
+        .is(CapacitorField::Dielectric, x7r);
+    ASSERT_TRUE(capMgr.find(byId, ids, res)) << res.toString();
+    EXPECT_EQ(ids, (std::vector<int>{ match }));
+
+    // Unknown lookup names match nothing rather than failing
+    CapacitorQuery unknown;
+    unknown.is(CapacitorField::Dielectric, "Unobtainium");
+    ASSERT_TRUE(capMgr.find(unknown, ids, res)) << res.toString();
+    EXPECT_TRUE(ids.empty());
+}
+
+// 3. Query_RejectsMismatchedPredicates
+TEST_F(ParametricQueryTest, Query_RejectsMismatchedPredicates) {
+    std::vector<int> ids;
+
+    FuseQuery rangeOnLookup;
+    rangeOnLookup.atLeast(FuseField::Package, 1.0);
+    EXPECT_FALSE(fuseMgr.find(rangeOnLookup, ids, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+
+    ResistorQuery lookupOnNumeric;
+    lookupOnNumeric.is(ResistorField::Resistance, "10k");
+    EXPECT_FALSE(resistorMgr.find(lookupOnNumeric, ids, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+}
+
+// 4. Queries_UseCompositeIndexes
+TEST_F(ParametricQueryTest, Queries_UseCompositeIndexes) {
+    ResistorQuery withPackage;
+    withPackage.between(ResistorField::Resistance, 9.5e3, 10.5e3)
+               .atMost(ResistorField::Tolerance, 1.0)
+               .is(ResistorField::Package, 3);
+    std::string plan = queryPlan(db, withPackage.sql());
+    EXPECT_NE(plan.find("COVERING INDEX idx_Resistors_Package_Resistance"), std::string::npos) << plan;
+
+    ResistorQuery rangeOnly;
+    rangeOnly.between(ResistorField::Resistance, 9.5e3, 10.5e3);
+    plan = queryPlan(db, rangeOnly.sql());
+    EXPECT_NE(plan.find("COVERING INDEX idx_Resistors_Resistance"), std::string::npos) << plan;
+
+    CapacitorQuery cap;
+    cap.atLeast(CapacitorField::Capacitance, 10e-6)
+       .is(CapacitorField::Dielectric, "X7R");
+    plan = queryPlan(db, cap.sql());
+    EXPECT_NE(plan.find("idx_Capacitors_Dielectric_Capacitance"), std::string::npos) << plan;
+}
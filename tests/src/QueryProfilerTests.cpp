@@ -0,0 +1,143 @@
+#include "BackendTestFixture.h"
+#include "QueryProfiler.h"
+#include "InventoryService.h"
+
+#include <sstream>
+
+namespace {
+
+const QueryStats* findStats(const std::vector<QueryStats>& stats, const std::string& sql) {
+    for (const QueryStats& s : stats)
+        if (s.sql == sql)
+            return &s;
+    return nullptr;
+}
+
+} // namespace
+
+class QueryProfilerTest : public BackendTestFixture {
+protected:
+    std::shared_ptr<QueryProfiler> profiler = std::make_shared<QueryProfiler>();
+
+    void SetUp() override {
+        BackendTestFixture::SetUp();
+        ASSERT_TRUE(db.exec("CREATE TABLE Samples (ID INTEGER PRIMARY KEY, Value INTEGER);"
+                            "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 100)"
+                            " INSERT INTO Samples (Value) SELECT (i * 37) % 100 FROM n;", res));
+    }
+
+    long long run(const std::string& sql) {
+        CachedStatement stmt;
+        EXPECT_TRUE(db.prepareCached(sql, stmt, res)) << res.toString();
+        long long rows = 0;
+        EXPECT_TRUE(db.stepRows(stmt, [&](sqlite3_stmt*) { ++rows; return true; }, res));
+        return rows;
+    }
+};
+
+// 1. Profiler_RecordsCallsRowsAndCounters
+TEST_F(QueryProfilerTest, Profiler_RecordsCallsRowsAndCounters) {
+    const std::string scan = "SELECT Value FROM Samples WHERE Value < 50;";
+    run(scan);   // counters from before profiling are not charged
+
+    db.setProfiler(profiler);
+    EXPECT_EQ(db.profiler(), profiler.get());
+    EXPECT_EQ(run(scan), 50);
+    EXPECT_EQ(run(scan), 50);
+
+    const auto stats = profiler->snapshot();
+    const QueryStats* s = findStats(stats, scan);
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->calls, 2);
+    EXPECT_EQ(s->rows, 100);
+    EXPECT_EQ(s->fullScanSteps, 2 * 99);
+    EXPECT_EQ(s->sorts, 0);
+    EXPECT_GT(s->vmSteps, 0);
+    EXPECT_GE(s->totalMs, s->maxMs);
+    EXPECT_LE(s->p50Ms, s->p99Ms);
+    EXPECT_LE(s->p99Ms, s->maxMs);
+}
+
+// 2. Profiler_CountsSortsAndStopsWhenDetached
+TEST_F(QueryProfilerTest, Profiler_CountsSortsAndStopsWhenDetached) {
+    const std::string sorted = "SELECT ID FROM Samples ORDER BY Value;";
+    db.setProfiler(profiler);
+    run(sorted);
+    run("SELECT ID FROM Samples WHERE ID = 7;");
+
+    auto stats = profiler->snapshot();
+    ASSERT_NE(findStats(stats, sorted), nullptr);
+    EXPECT_EQ(findStats(stats, sorted)->sorts, 1);
+    ASSERT_NE(findStats(stats, "SELECT ID FROM Samples WHERE ID = 7;"), nullptr);
+    EXPECT_EQ(findStats(stats, "SELECT ID FROM Samples WHERE ID = 7;")->fullScanSteps, 0);
+
+    db.setProfiler(nullptr);
+    run(sorted);
+    stats = profiler->snapshot();
+    EXPECT_EQ(findStats(stats, sorted)->calls, 1);
+
+    profiler->reset();
+    EXPECT_TRUE(profiler->snapshot().empty());
+}
+
+// 3. Profiler_WritesEscapedJson
+TEST_F(QueryProfilerTest, Profiler_WritesEscapedJson) {
+    db.setProfiler(profiler);
+    ASSERT_TRUE(db.exec("SELECT 'say \"hi\"',\n1;", res));
+
+    std::ostringstream out;
+    QueryProfiler::writeJson(out, profiler->snapshot());
+    const std::string json = out.str();
+    EXPECT_EQ(json.rfind("{\"queries\": [", 0), 0u);
+    EXPECT_NE(json.find("\"sql\": \"SELECT 'say \\\"hi\\\"',\\n1;\""), std::string::npos) << json;
+    EXPECT_NE(json.find("\"calls\": 1, \"rows\": 1,"), std::string::npos) << json;
+
+    std::ostringstream empty;
+    QueryProfiler::writeJson(empty, {});
+    EXPECT_EQ(empty.str(), "{\"queries\": []}\n");
+}
+
+// 4. Service_ProfilesWriterAndReaders
+TEST(QueryProfilerServiceTest, Service_ProfilesWriterAndReaders) {
+    DbResult res;
+    auto service = InventoryService::open(tempDbPath("inventory_profiler_test.db"),
+        DatabaseOptions::interactive(), res);
+    ASSERT_NE(service, nullptr) << res.toString();
+    EXPECT_FALSE(service->isProfiling());
+    EXPECT_EQ(service->profiler(), nullptr);
+
+    // A reader opened before profiling picks it up on its next acquire
+    {
+        ReadSession session;
+        ASSERT_TRUE(service->readSession(session, res)) << res.toString();
+    }
+
+    service->setProfiling(true);
+    ASSERT_NE(service->profiler(), nullptr);
+    const int categoryId = service->categories().getIdByName("Resistor", res);
+    Component c("LM317T", "regulator", categoryId, 0, 1);
+    ASSERT_TRUE(service->components().add(c, res)) << res.toString();
+
+    {
+        ReadSession session;
+        ASSERT_TRUE(service->readSession(session, res)) << res.toString();
+        EXPECT_EQ(session->database().profiler(), service->profiler());
+        Component read;
+        ASSERT_TRUE(session->components().getById(c.id, read, res)) << res.toString();
+    }
+
+    long long writes = 0, rows = 0;
+    for (const QueryStats& s : service->profiler()->snapshot()) {
+        if (s.sql.rfind("INSERT INTO Components", 0) == 0)
+            writes += s.calls;
+        if (s.sql.find("FROM Components") != std::string::npos)
+            rows += s.rows;
+    }
+    EXPECT_EQ(writes, 1);
+    EXPECT_GE(rows, 1);
+
+    // Totals survive disabling
+    service->setProfiling(false);
+    EXPECT_FALSE(service->isProfiling());
+    EXPECT_FALSE(service->profiler()->snapshot().empty());
+}
@@ -0,0 +1,131 @@
+#include "BackendTestFixture.h"
+#include "InventoryService.h"
+
+#include <atomic>
+#include <thread>
+
+class ReaderPoolTest : public ::testing::Test {
+protected:
+    DbResult res;
+    std::unique_ptr<InventoryService> service;
+    int categoryId = 0;
+
+    void SetUp() override {
+        service = InventoryService::open(tempDbPath("inventory_reader_pool_test.db"),
+            DatabaseOptions::interactive(), res);
+        ASSERT_NE(service, nullptr) << res.toString();
+        categoryId = service->categories().getIdByName("Resistor", res);
+    }
+
+    int addComponent(const std::string& pn) {
+        Component c(pn, pn + " regulator", categoryId, 0, 1);
+        EXPECT_TRUE(service->components().add(c, res)) << res.toString();
+        return c.id;
+    }
+};
+
+// 1. ReadSession_SeesCommittedWrites
+TEST_F(ReaderPoolTest, ReadSession_SeesCommittedWrites) {
+    const int id = addComponent("LM317T");
+
+    ReadSession session;
+    ASSERT_TRUE(service->readSession(session, res)) << res.toString();
+    ASSERT_TRUE(session);
+
+    Component c;
+    ASSERT_TRUE(session->components().getById(id, c, res)) << res.toString();
+    EXPECT_EQ(c.partNumber, "LM317T");
+
+    // Readers are read-only
+    Component other("NE555", "timer", categoryId, 0, 1);
+    EXPECT_FALSE(session->components().add(other, res));
+
+    // A later commit is visible to the next query on the same session
+    const int id2 = addComponent("LM7805");
+    EXPECT_TRUE(session->components().getById(id2, c, res)) << res.toString();
+}
+
+// 2. Acquire_CapsAndReusesConnections
+TEST_F(ReaderPoolTest, Acquire_CapsAndReusesConnections) {
+    service->configureReaders(2, DatabaseOptions::readOnlyReporting());
+    std::shared_ptr<ReaderPool> pool = service->readers();
+    ASSERT_NE(pool, nullptr);
+
+    ReadSession a, b, c;
+    ASSERT_TRUE(pool->acquire(a, res)) << res.toString();
+    ASSERT_TRUE(pool->acquire(b, res)) << res.toString();
+    EXPECT_NE(&*a, &*b);
+
+    EXPECT_FALSE(pool->tryAcquire(c, res));
+    EXPECT_EQ(res.code, SQLITE_BUSY);
+    EXPECT_FALSE(c);
+
+    // A blocked acquire completes once another thread hands a connection back
+    ReadConnection* first = &*a;
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        a.release();
+    });
+    DbResult waitRes;
+    EXPECT_TRUE(pool->acquire(c, waitRes)) << waitRes.toString();
+    releaser.join();
+
+    EXPECT_EQ(&*c, first);
+    EXPECT_EQ(pool->openConnections(), 2);
+}
+
+// 3. ConcurrentReaders_RunWhileWriterCommits
+TEST_F(ReaderPoolTest, ConcurrentReaders_RunWhileWriterCommits) {
+    for (int i = 0; i < 50; ++i)
+        addComponent("LM" + std::to_string(i));
+
+    std::atomic<bool> writing{ true };
+    std::atomic<int> failures{ 0 };
+    std::atomic<long> queries{ 0 };
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            DbResult r;
+            ReadSession session;
+            if (!service->readSession(session, r)) {
+                ++failures;
+                return;
+            }
+            std::vector<Component> found;
+            while (writing || queries == 0) {
+                if (!session->components().search("regul", 20, found, r) || found.empty())
+                    ++failures;
+                ++queries;
+            }
+        });
+    }
+
+    // The writer keeps committing on its own connection meanwhile
+    for (int i = 0; i < 100; ++i)
+        addComponent("LT" + std::to_string(i));
+    writing = false;
+    for (auto& t : readers)
+        t.join();
+
+    EXPECT_EQ(failures, 0);
+    EXPECT_GT(queries, 0);
+
+    ReadSession session;
+    ASSERT_TRUE(service->readSession(session, res)) << res.toString();
+    std::vector<Component> all;
+    ASSERT_TRUE(session->components().list(all, res)) << res.toString();
+    EXPECT_EQ(all.size(), 150u);
+}
+
+// 4. ReadSession_InMemoryDatabaseFails
+TEST_F(ReaderPoolTest, ReadSession_InMemoryDatabaseFails) {
+    auto memory = InventoryService::open(":memory:", res);
+    ASSERT_NE(memory, nullptr) << res.toString();
+    EXPECT_EQ(memory->readers(), nullptr);
+
+    ReadSession session;
+    EXPECT_FALSE(memory->readSession(session, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+    EXPECT_FALSE(session);
+}
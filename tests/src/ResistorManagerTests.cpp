@@ -309,3 +309,77 @@ TEST_F(ResistorManagerTest, GetByComponentId_Nonexistent_ReturnsFalse) {
     Resistor r;
     EXPECT_FALSE(resistorMgr.getByComponentId(999999, r, res));
 }
+
+//
+// 9. AddBatch_WithComponents_InsertsBothRows
+//
+TEST_F(ResistorManagerTest, AddBatch_WithComponents_InsertsBothRows) {
+    std::vector<Component> comps;
+    std::vector<Resistor> resistors;
+    for (int i = 0; i < 50; ++i) {
+        comps.emplace_back("TEST_RES_BATCH" + std::to_string(i), "Batch resistor", catId, manId, 1);
+        resistors.emplace_back(0, 100.0 * (i + 1), 1.0, 0.25,
+            false, 0.0, 0.0, false, 0.0, 0.0, pkgId, compTypeId, 5.0, 200.0);
+    }
+
+    ASSERT_TRUE(resistorMgr.addBatch(comps, resistors, res)) << res.toString();
+
+    for (std::size_t i = 0; i < comps.size(); ++i) {
+        ASSERT_GT(comps[i].id, 0);
+        EXPECT_EQ(resistors[i].componentId, comps[i].id);
+    }
+
+    Resistor fetched;
+    ASSERT_TRUE(resistorMgr.getByComponentId(comps[9].id, fetched, res)) << res.toString();
+    EXPECT_DOUBLE_EQ(fetched.resistance, 1000.0);
+}
+
+//
+// 10. AddBatch_WithComponents_FailureLeavesNoComponents
+//
+TEST_F(ResistorManagerTest, AddBatch_WithComponents_FailureLeavesNoComponents) {
+    int before = db.countRows("Components", "");
+
+    std::vector<Component> comps;
+    comps.emplace_back("TEST_RES_OK", "Good", catId, manId, 1);
+    comps.emplace_back("TEST_RES_BAD", "Bad package", catId, manId, 1);
+
+    std::vector<Resistor> resistors;
+    resistors.emplace_back(0, 100.0, 1.0, 0.25,
+        false, 0.0, 0.0, false, 0.0, 0.0, pkgId, compTypeId, 5.0, 200.0);
+    resistors.emplace_back(0, 100.0, 1.0, 0.25,
+        false, 0.0, 0.0, false, 0.0, 0.0, 999999, compTypeId, 5.0, 200.0);
+
+    EXPECT_FALSE(resistorMgr.addBatch(comps, resistors, res));
+    EXPECT_EQ(db.countRows("Components", ""), before);
+    EXPECT_EQ(db.countRows("Resistors", ""), 0);
+}
+
+//
+// 11. ForEach_StreamsRowsAndStopsEarly
+//
+TEST_F(ResistorManagerTest, ForEach_StreamsRowsAndStopsEarly) {
+    std::vector<Component> comps;
+    std::vector<Resistor> resistors;
+    for (int i = 0; i < 10; ++i) {
+        comps.emplace_back("TEST_RES_EACH" + std::to_string(i), "Streamed resistor", catId, manId, 1);
+        resistors.emplace_back(0, 10.0 * (i + 1), 1.0, 0.25,
+            i % 2 == 0, -50.0, 50.0, false, 0.0, 0.0, pkgId, compTypeId, 5.0, 200.0);
+    }
+    ASSERT_TRUE(resistorMgr.addBatch(comps, resistors, res)) << res.toString();
+
+    int seen = 0;
+    ASSERT_TRUE(resistorMgr.forEach([&](const Resistor& r) {
+        EXPECT_EQ(r.componentId, comps[seen].id);
+        EXPECT_EQ(r.hasTempCoeff, seen % 2 == 0);
+        ++seen;
+        return true;
+    }, res)) << res.toString();
+    EXPECT_EQ(seen, 10);
+
+    seen = 0;
+    ASSERT_TRUE(resistorMgr.forEach([&](const Resistor&) {
+        return ++seen < 3;
+    }, res));
+    EXPECT_EQ(seen, 3);
+}
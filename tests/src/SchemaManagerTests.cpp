@@ -1,12 +1,44 @@
 #include "BackendTestFixture.h"
 #include "SchemaManager.h"
+#include "ComponentManager.h"
 
 class SchemaManagerTest : public BackendTestFixture {
 protected:
     SchemaManager schemaMgr;
     SchemaManagerTest() : schemaMgr(db) {}
+
+    std::string queryPlan(const std::string& sql) {
+        sqlite3_stmt* stmt = nullptr;
+        EXPECT_TRUE(db.prepare("EXPLAIN QUERY PLAN " + sql, stmt, res)) << res.toString();
+        std::string plan;
+        while (stmt && sqlite3_step(stmt) == SQLITE_ROW)
+            plan += reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)) + std::string("\n");
+        db.finalize(stmt);
+        return plan;
+    }
+
+    // Resistors in one package, 1 in 100 in another; parts spread evenly
+    // over 200 manufacturers
+    void loadSkewedResistors(int rows) {
+        ASSERT_TRUE(db.exec(
+            "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 200) "
+            "INSERT INTO Manufacturers (Name) SELECT 'Skew ' || i FROM n;"
+            "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < "
+            + std::to_string(rows) + ") "
+            "INSERT INTO Components (CategoryID, PartNumber, ManufacturerID, Quantity) "
+            "SELECT 1, 'SKEW' || i, (SELECT MIN(ID) FROM Manufacturers) + i % 200, 1 FROM n;"
+            "INSERT INTO Resistors (ComponentID, Resistance, PackageTypeID) "
+            "SELECT ID, ID, CASE WHEN ID % 100 = 0 THEN 2 ELSE 1 END FROM Components;",
+            res)) << res.toString();
+    }
 };
 
+// Join written package-first: driving from the package index reads
+// nearly every resistor, the manufacturer index only 1 in 200 parts
+static const char* const kSkewedJoinSql =
+    "SELECT c.ID FROM Resistors r JOIN Components c ON c.ID = r.ComponentID "
+    "WHERE r.PackageTypeID = 1 AND c.ManufacturerID = 7;";
+
 // 1. Initialize_CreatesAllTables
 TEST_F(SchemaManagerTest, Initialize_CreatesAllTables) {
     ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
@@ -90,3 +122,196 @@ TEST_F(SchemaManagerTest, Migration_AddsNewColumnsAndTables) {
     int version = db.getMaxSchemaVersion();
     EXPECT_GE(version, 6);
 }
+
+// 4. Migration8_CreatesLookupIndexes
+TEST_F(SchemaManagerTest, Migration8_CreatesLookupIndexes) {
+    ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
+
+    EXPECT_TRUE(db.indexExists("idx_Components_PartNumber"));
+    EXPECT_TRUE(db.indexExists("idx_Components_Category_PartNumber"));
+    EXPECT_TRUE(db.indexExists("idx_Components_Manufacturer_PartNumber"));
+    EXPECT_TRUE(db.indexExists("idx_Resistors_CompositionID"));
+    EXPECT_TRUE(db.indexExists("idx_Capacitors_PackageTypeID"));
+    EXPECT_TRUE(db.indexExists("idx_Transistors_PackageID"));
+    EXPECT_TRUE(db.indexExists("idx_Fuses_TypeId"));
+    EXPECT_TRUE(db.indexExists("idx_Diodes_PolarityId"));
+    EXPECT_GE(db.getMaxSchemaVersion(), 8);
+
+    // Part-number lookups must be served by the index, not a table scan
+    sqlite3_stmt* stmt = nullptr;
+    ASSERT_TRUE(db.prepare(
+        "EXPLAIN QUERY PLAN SELECT ID FROM Components WHERE PartNumber = 'x';",
+        stmt, res));
+    std::string plan;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+        plan += reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+    db.finalize(stmt);
+    EXPECT_NE(plan.find("USING COVERING INDEX idx_Components_PartNumber"), std::string::npos) << plan;
+}
+
+// 5. Migration9_IndexesExistingComponentsForSearch
+TEST_F(SchemaManagerTest, Migration9_IndexesExistingComponentsForSearch) {
+    ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
+    EXPECT_TRUE(db.tableExists("ComponentsFts"));
+    EXPECT_GE(db.getMaxSchemaVersion(), 9);
+
+    // Simulate a pre-v9 database: rows written while the index was absent
+    ASSERT_TRUE(db.exec(
+        "DROP TRIGGER components_fts_insert;"
+        "INSERT INTO Components (PartNumber, Description, CategoryID) VALUES ('NE555P', 'Timer', 1);"
+        "DROP TABLE ComponentsFts;"
+        "DELETE FROM SchemaVersion WHERE Version >= 9;"
+        "PRAGMA user_version = 0;", res)) << res.toString();
+
+    ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
+    EXPECT_EQ(db.countRows("ComponentsFts", "ComponentsFts MATCH 'ne555*'"), 1);
+}
+
+// 6. RecoverSearchIndex_OnlyAfterHeartbeatStops
+TEST_F(SchemaManagerTest, RecoverSearchIndex_OnlyAfterHeartbeatStops) {
+    ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
+    ASSERT_TRUE(schemaMgr.suspendSearchIndex(res)) << res.toString();
+    EXPECT_EQ(db.countRows("SearchIndexSuspension", ""), 1);
+
+    // A bulk load in progress: another connection must not rebuild
+    ASSERT_TRUE(db.exec(
+        "INSERT INTO Components (PartNumber, Description, CategoryID) VALUES ('LM317T', 'Regulator', 1);",
+        res)) << res.toString();
+    ASSERT_TRUE(schemaMgr.touchSearchIndexSuspension(res)) << res.toString();
+    SchemaManager other(db);
+    ASSERT_TRUE(other.recoverSearchIndex(res)) << res.toString();
+    EXPECT_EQ(db.countRows("ComponentsFts", "ComponentsFts MATCH 'lm317*'"), 0);
+    EXPECT_EQ(db.countRows("sqlite_master", "type='trigger' AND name LIKE 'components_fts_%'"), 0);
+
+    // The load died: its heartbeat goes stale
+    ASSERT_TRUE(db.exec("UPDATE SearchIndexSuspension SET Heartbeat = Heartbeat - 3600;", res))
+        << res.toString();
+    ASSERT_TRUE(other.recoverSearchIndex(res)) << res.toString();
+    EXPECT_EQ(db.countRows("ComponentsFts", "ComponentsFts MATCH 'lm317*'"), 1);
+    EXPECT_EQ(db.countRows("sqlite_master", "type='trigger' AND name LIKE 'components_fts_%'"), 3);
+    EXPECT_EQ(db.countRows("SearchIndexSuspension", ""), 0);
+
+    // Triggers dropped without a marker are restored as well
+    ASSERT_TRUE(db.exec("DROP TRIGGER components_fts_insert;", res)) << res.toString();
+    ASSERT_TRUE(other.recoverSearchIndex(res)) << res.toString();
+    EXPECT_EQ(db.countRows("sqlite_master", "type='trigger' AND name LIKE 'components_fts_%'"), 3);
+
+    // resumeSearchIndex() clears the marker
+    ASSERT_TRUE(schemaMgr.suspendSearchIndex(res)) << res.toString();
+    ASSERT_TRUE(schemaMgr.resumeSearchIndex(res)) << res.toString();
+    EXPECT_EQ(db.countRows("SearchIndexSuspension", ""), 0);
+}
+
+// 7. AnalyzePlannerStats_ChoosesSelectiveIndexOnSkewedData
+TEST_F(SchemaManagerTest, AnalyzePlannerStats_ChoosesSelectiveIndexOnSkewedData) {
+    ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
+    loadSkewedResistors(20000);
+
+    // Without statistics every index looks equally selective
+    EXPECT_NE(queryPlan(kSkewedJoinSql).find("idx_Resistors_Package"), std::string::npos)
+        << queryPlan(kSkewedJoinSql);
+
+    ASSERT_TRUE(schemaMgr.analyzePlannerStats(res)) << res.toString();
+    EXPECT_GT(db.countRows("sqlite_stat1", "tbl = 'Components'"), 0);
+    const std::string plan = queryPlan(kSkewedJoinSql);
+    EXPECT_NE(plan.find("idx_Components_Manufacturer_PartNumber"), std::string::npos) << plan;
+    EXPECT_EQ(plan.find("idx_Resistors_Package"), std::string::npos) << plan;
+
+    // PRAGMA optimize keeps fresh statistics as they are
+    ASSERT_TRUE(schemaMgr.optimizePlannerStats(res)) << res.toString();
+    EXPECT_NE(queryPlan(kSkewedJoinSql).find("idx_Components_Manufacturer_PartNumber"),
+        std::string::npos);
+}
+
+// 8. SeedPlannerStats_GivesFreshDatabaseTypicalEstimates
+TEST_F(SchemaManagerTest, SeedPlannerStats_GivesFreshDatabaseTypicalEstimates) {
+    ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
+    ASSERT_TRUE(schemaMgr.seedPlannerStats(res)) << res.toString();
+
+    EXPECT_EQ(db.countRows("sqlite_stat1", "idx = 'idx_Components_Category_PartNumber'"), 1);
+    const std::string plan = queryPlan(kSkewedJoinSql);
+    EXPECT_NE(plan.find("idx_Components_Manufacturer_PartNumber"), std::string::npos) << plan;
+
+    // Real statistics are never replaced by the seed
+    loadSkewedResistors(2000);
+    ASSERT_TRUE(schemaMgr.analyzePlannerStats(res)) << res.toString();
+    ASSERT_TRUE(schemaMgr.seedPlannerStats(res)) << res.toString();
+    EXPECT_EQ(db.countRows("sqlite_stat1", "idx = 'idx_Components_PartNumber' AND stat LIKE '10000 %'"), 0);
+    EXPECT_EQ(db.countRows("sqlite_stat1", "idx = 'idx_Components_PartNumber'"), 1);
+}
+
+// 9. RemoveWhere_LargePurgeRefreshesPlannerStats
+TEST_F(SchemaManagerTest, RemoveWhere_LargePurgeRefreshesPlannerStats) {
+    ASSERT_TRUE(schemaMgr.initialize(res)) << res.toString();
+    loadSkewedResistors(5000);
+    ASSERT_TRUE(schemaMgr.analyzePlannerStats(res)) << res.toString();
+    ASSERT_GT(db.countRows("sqlite_stat1", "tbl = 'Components'"), 0);
+
+    ComponentManager components(db);
+    ComponentFilter filter;
+    filter.maxQuantity = 5;
+    long long removed = 0;
+    ASSERT_TRUE(components.removeWhere(filter, removed, res)) << res.toString();
+    EXPECT_EQ(removed, 5000);
+
+    // Re-analyzed: an empty table has no statistics rows
+    EXPECT_EQ(db.countRows("sqlite_stat1", "tbl = 'Components'"), 0);
+}
+
+// 10. Initialize_FreshInOneCommitCurrentInNone
+TEST_F(SchemaManagerTest, Initialize_FreshInOneCommitCurrentInNone) {
+    Database fresh(":memory:", res);
+    ASSERT_TRUE(fresh.isOpen());
+    int commits = 0;
+    sqlite3_commit_hook(fresh.handle(), [](void* n) { ++*static_cast<int*>(n); return 0; }, &commits);
+
+    SchemaManager freshSchema(fresh);
+    ASSERT_TRUE(freshSchema.initialize(res)) << res.toString();
+    EXPECT_EQ(commits, 1);
+    EXPECT_EQ(fresh.getMaxSchemaVersion(), 13);
+
+    // Current schema: header check only
+    commits = 0;
+    ASSERT_TRUE(freshSchema.initialize(res)) << res.toString();
+    EXPECT_EQ(commits, 0);
+
+    // A file from before user_version was kept is recognized from its
+    // history and only gets the header written
+    ASSERT_TRUE(fresh.exec("PRAGMA user_version = 0;", res)) << res.toString();
+    commits = 0;
+    ASSERT_TRUE(freshSchema.initialize(res)) << res.toString();
+    EXPECT_EQ(commits, 1);
+    EXPECT_EQ(fresh.countRows("SchemaVersion", ""), 13);
+    sqlite3_stmt* stmt = nullptr;
+    ASSERT_TRUE(fresh.prepare("PRAGMA user_version;", stmt, res));
+    ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+    EXPECT_EQ(sqlite3_column_int(stmt, 0), 13);
+    fresh.finalize(stmt);
+    sqlite3_commit_hook(fresh.handle(), nullptr, nullptr);
+}
+
+// 11. Initialize_FailedMigrationRollsBackEverything
+TEST_F(SchemaManagerTest, Initialize_FailedMigrationRollsBackEverything) {
+    Database old(":memory:", res);
+    ASSERT_TRUE(old.isOpen());
+    SchemaManager oldSchema(old);
+    ASSERT_TRUE(oldSchema.initialize(res)) << res.toString();
+
+    // Back to version 12, with the history insert of migration 13 failing
+    ASSERT_TRUE(old.exec(
+        "DROP TABLE SearchIndexSuspension;"
+        "DELETE FROM SchemaVersion WHERE Version = 13;"
+        "PRAGMA user_version = 12;"
+        "CREATE TRIGGER block_history BEFORE INSERT ON SchemaVersion "
+        "BEGIN SELECT RAISE(ABORT, 'history is read-only'); END;",
+        res)) << res.toString();
+
+    EXPECT_FALSE(oldSchema.initialize(res));
+    EXPECT_FALSE(res.ok());
+    EXPECT_FALSE(old.tableExists("SearchIndexSuspension"));
+    sqlite3_stmt* stmt = nullptr;
+    ASSERT_TRUE(old.prepare("PRAGMA user_version;", stmt, res));
+    ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+    EXPECT_EQ(sqlite3_column_int(stmt, 0), 12);
+    old.finalize(stmt);
+}
@@ -0,0 +1,185 @@
+#include "BackendTestFixture.h"
+#include "StatsManager.h"
+#include "ComponentManager.h"
+#include "StockLedger.h"
+#include "DbUtils.h"
+
+#include <map>
+#include <tuple>
+
+class StatsManagerTest : public BackendTestFixture {
+protected:
+    ComponentManager compMgr{ db };
+    StatsManager stats{ db };
+
+    int addComponent(const std::string& pn, int quantity, int manufacturer) {
+        Component c(pn, "part", catId, manufacturer, quantity);
+        EXPECT_TRUE(compMgr.add(c, res)) << res.toString();
+        return c.id;
+    }
+
+    int resistorPackage(const std::string& name) {
+        EXPECT_TRUE(db.exec("INSERT OR IGNORE INTO ResistorPackage (Name) VALUES ('" + name + "');", res))
+            << res.toString();
+        return scalar("SELECT ID FROM ResistorPackage WHERE Name = '" + name + "';");
+    }
+
+    void addResistor(int componentId, int packageId) {
+        const std::string package = packageId ? std::to_string(packageId) : "NULL";
+        ASSERT_TRUE(db.exec("INSERT INTO Resistors (ComponentID, Resistance, PackageTypeID) VALUES ("
+            + std::to_string(componentId) + ", 1000, " + package + ");", res)) << res.toString();
+    }
+
+    long long scalar(const std::string& sql) {
+        long long value = 0;
+        sqlite3_stmt* stmt = nullptr;
+        EXPECT_TRUE(db.prepare(sql, stmt, res)) << res.toString();
+        if (stmt && sqlite3_step(stmt) == SQLITE_ROW)
+            value = sqlite3_column_int64(stmt, 0);
+        db.finalize(stmt);
+        return value;
+    }
+
+    using Key = std::tuple<std::string, long long>;
+    using Counts = std::tuple<long long, long long, long long>;
+
+    // Non-empty rows of a stats table, or the same groups recounted from
+    // Components; both queries yield (key1, key2, count, quantity, zero)
+    std::map<Key, Counts> groups(const std::string& sql) {
+        std::map<Key, Counts> out;
+        sqlite3_stmt* stmt = nullptr;
+        EXPECT_TRUE(db.prepare(sql, stmt, res)) << res.toString();
+        while (stmt && sqlite3_step(stmt) == SQLITE_ROW) {
+            out[{ safeColumnText(stmt, 0), sqlite3_column_int64(stmt, 1) }] = {
+                sqlite3_column_int64(stmt, 2), sqlite3_column_int64(stmt, 3),
+                sqlite3_column_int64(stmt, 4) };
+        }
+        db.finalize(stmt);
+        return out;
+    }
+
+    void expectStatsMatchRecount() {
+        EXPECT_EQ(groups("SELECT '', CategoryID, Components, TotalQuantity, ZeroStock "
+                "FROM CategoryStats WHERE Components > 0;"),
+            groups("SELECT '', CategoryID, COUNT(*), SUM(Quantity), SUM(Quantity <= 0) "
+                "FROM Components GROUP BY CategoryID;"));
+        EXPECT_EQ(groups("SELECT '', ManufacturerID, Components, TotalQuantity, ZeroStock "
+                "FROM ManufacturerStats WHERE Components > 0;"),
+            groups("SELECT '', IFNULL(ManufacturerID, 0), COUNT(*), SUM(Quantity), "
+                "SUM(Quantity <= 0) FROM Components GROUP BY 2;"));
+        EXPECT_EQ(groups("SELECT Family, PackageID, Components, TotalQuantity, ZeroStock "
+                "FROM PackageStats WHERE Family = 'Resistor' AND Components > 0;"),
+            groups("SELECT 'Resistor', IFNULL(r.PackageTypeID, 0), COUNT(*), SUM(c.Quantity), "
+                "SUM(c.Quantity <= 0) FROM Resistors r JOIN Components c ON c.ID = r.ComponentID "
+                "GROUP BY 2;"));
+    }
+};
+
+// 1. Migration_CreatesStatsTablesAndCountsExistingRows
+TEST_F(StatsManagerTest, Migration_CreatesStatsTablesAndCountsExistingRows) {
+    EXPECT_GE(db.getMaxSchemaVersion(), 12);
+
+    addComponent("R1", 10, manId);
+    addComponent("R2", 0, manId);
+
+    // Rebuild from scratch as an upgrade from version 11 would
+    ASSERT_TRUE(db.exec("DROP TABLE CategoryStats; DROP TABLE ManufacturerStats; "
+        "DROP TABLE PackageStats; DELETE FROM SchemaVersion WHERE Version >= 12; "
+        "PRAGMA user_version = 0;", res))
+        << res.toString();
+    ASSERT_TRUE(schema.initialize(res)) << res.toString();
+
+    StockTotals totals;
+    ASSERT_TRUE(stats.totals(totals, res)) << res.toString();
+    EXPECT_EQ(totals.components, 2);
+    EXPECT_EQ(totals.totalQuantity, 10);
+    EXPECT_EQ(totals.zeroStock, 1);
+    expectStatsMatchRecount();
+}
+
+// 2. Triggers_StayExactThroughInsertUpdateDeleteAndCascade
+TEST_F(StatsManagerTest, Triggers_StayExactThroughInsertUpdateDeleteAndCascade) {
+    Manufacturer other("Stats Test Mfr");
+    ASSERT_TRUE(manMgr.add(other, res)) << res.toString();
+    const int otherId = manMgr.getIdByName("Stats Test Mfr", res);
+    const int capCat = catMgr.getIdByName("Capacitor", res);
+    const int pkgA = resistorPackage("StatsPkgA");
+    const int pkgB = resistorPackage("StatsPkgB");
+
+    const int a = addComponent("A", 5, manId);
+    const int b = addComponent("B", 0, otherId);
+    const int c = addComponent("C", 7, 0);
+    const int d = addComponent("D", 3, manId);
+    addResistor(a, pkgA);
+    addResistor(b, pkgA);
+    addResistor(c, 0);
+    expectStatsMatchRecount();
+
+    // Full update through the manager: category, manufacturer, quantity
+    Component comp;
+    ASSERT_TRUE(compMgr.getById(a, comp, res)) << res.toString();
+    comp.categoryId = capCat;
+    comp.manufacturerId = otherId;
+    comp.quantity = 0;
+    ASSERT_TRUE(compMgr.update(comp, res)) << res.toString();
+    expectStatsMatchRecount();
+
+    // Ledger deltas and a package move
+    StockLedger ledger(db);
+    ASSERT_TRUE(ledger.adjustQuantity(b, 4, res)) << res.toString();
+    ASSERT_TRUE(ledger.adjustQuantity(c, -7, res)) << res.toString();
+    ASSERT_TRUE(db.exec("UPDATE Resistors SET PackageTypeID = " + std::to_string(pkgB)
+        + " WHERE ComponentID = " + std::to_string(b) + ";", res)) << res.toString();
+    expectStatsMatchRecount();
+
+    // Subtype row removed on its own, then components removed with cascade
+    ASSERT_TRUE(db.exec("DELETE FROM Resistors WHERE ComponentID = " + std::to_string(c) + ";", res))
+        << res.toString();
+    expectStatsMatchRecount();
+    ASSERT_TRUE(compMgr.remove(a, res)) << res.toString();
+    ASSERT_TRUE(compMgr.remove(d, res)) << res.toString();
+    long long removed = 0;
+    const int ids[] = { b };
+    ASSERT_TRUE(compMgr.removeMany(ids, removed, res)) << res.toString();
+    EXPECT_EQ(removed, 1);
+    expectStatsMatchRecount();
+    EXPECT_EQ(scalar("SELECT COUNT(*) FROM PackageStats WHERE Components <> 0 OR TotalQuantity <> 0 "
+        "OR ZeroStock <> 0;"), 0);
+}
+
+// 3. Queries_ReturnNamedGroups
+TEST_F(StatsManagerTest, Queries_ReturnNamedGroups) {
+    const int pkg = resistorPackage("StatsPkgA");
+    const int a = addComponent("A", 5, manId);
+    addComponent("B", 0, 0);
+    addResistor(a, pkg);
+
+    std::vector<StockGroup> categories;
+    ASSERT_TRUE(stats.byCategory(categories, res)) << res.toString();
+    ASSERT_EQ(categories.size(), 1u);
+    EXPECT_EQ(categories[0].id, catId);
+    EXPECT_EQ(categories[0].name, "Resistor");
+    EXPECT_EQ(categories[0].totals.components, 2);
+    EXPECT_EQ(categories[0].totals.totalQuantity, 5);
+    EXPECT_EQ(categories[0].totals.zeroStock, 1);
+
+    std::vector<StockGroup> manufacturers;
+    ASSERT_TRUE(stats.byManufacturer(manufacturers, res)) << res.toString();
+    ASSERT_EQ(manufacturers.size(), 2u);
+    EXPECT_EQ(manufacturers[0].id, 0);      // no manufacturer sorts first
+    EXPECT_EQ(manufacturers[0].totals.zeroStock, 1);
+    EXPECT_EQ(manufacturers[1].id, manId);
+
+    std::vector<PackageStockGroup> packages;
+    ASSERT_TRUE(stats.byPackage(packages, res)) << res.toString();
+    ASSERT_EQ(packages.size(), 1u);
+    EXPECT_EQ(packages[0].family, "Resistor");
+    EXPECT_EQ(packages[0].name, "StatsPkgA");
+    EXPECT_EQ(packages[0].totals.totalQuantity, 5);
+
+    StockTotals one;
+    ASSERT_TRUE(stats.categoryTotals(catId, one, res)) << res.toString();
+    EXPECT_EQ(one.components, 2);
+    ASSERT_TRUE(stats.categoryTotals(-1, one, res)) << res.toString();
+    EXPECT_EQ(one.components, 0);
+}
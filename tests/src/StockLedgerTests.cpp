@@ -0,0 +1,149 @@
+#include "BackendTestFixture.h"
+#include "StockLedger.h"
+#include "ComponentManager.h"
+
+#include <thread>
+
+class StockLedgerTest : public BackendTestFixture {
+protected:
+    ComponentManager compMgr{ db };
+    StockLedger ledger{ db };
+
+    int addComponent(const std::string& pn, int quantity) {
+        Component c(pn, "part", catId, manId, quantity);
+        EXPECT_TRUE(compMgr.add(c, res)) << res.toString();
+        return c.id;
+    }
+
+    int quantityOf(int id) {
+        Component c;
+        EXPECT_TRUE(compMgr.getById(id, c, res)) << res.toString();
+        return c.quantity;
+    }
+};
+
+// 1. AdjustQuantity_UpdatesStockAndAppendsMovement
+TEST_F(StockLedgerTest, AdjustQuantity_UpdatesStockAndAppendsMovement) {
+    const int id = addComponent("LM317T", 5);
+
+    int after = 0;
+    ASSERT_TRUE(ledger.adjustQuantity(id, 10, StockMovementKind::Receive, "PO 1042", after, res))
+        << res.toString();
+    EXPECT_EQ(after, 15);
+    ASSERT_TRUE(ledger.adjustQuantity(id, -3, StockMovementKind::Consume, "kit A", after, res))
+        << res.toString();
+    EXPECT_EQ(after, 12);
+    ASSERT_TRUE(ledger.adjustQuantity(id, -2, res)) << res.toString();
+    EXPECT_EQ(quantityOf(id), 10);
+
+    std::vector<StockMovement> history;
+    ASSERT_TRUE(ledger.history(id, history, res)) << res.toString();
+    ASSERT_EQ(history.size(), 3u);
+    EXPECT_EQ(history[0].kind, StockMovementKind::Receive);
+    EXPECT_EQ(history[0].delta, 10);
+    EXPECT_EQ(history[0].quantityAfter, 15);
+    EXPECT_EQ(history[0].reason, "PO 1042");
+    EXPECT_FALSE(history[0].createdOn.empty());
+    EXPECT_EQ(history[1].kind, StockMovementKind::Consume);
+    EXPECT_EQ(history[1].quantityAfter, 12);
+    EXPECT_EQ(history[2].kind, StockMovementKind::Adjust);
+    EXPECT_EQ(history[2].reason, "");
+    EXPECT_EQ(history[2].quantityAfter, 10);
+}
+
+// 2. AdjustQuantity_RejectsOverdrawWrongSignAndMissingComponent
+TEST_F(StockLedgerTest, AdjustQuantity_RejectsOverdrawWrongSignAndMissingComponent) {
+    const int id = addComponent("NE555", 4);
+    int after = -1;
+
+    EXPECT_FALSE(ledger.adjustQuantity(id, -5, StockMovementKind::Consume, "", after, res));
+    EXPECT_EQ(res.code, SQLITE_CONSTRAINT);
+
+    EXPECT_FALSE(ledger.adjustQuantity(id, -1, StockMovementKind::Receive, "", after, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+    EXPECT_FALSE(ledger.adjustQuantity(id, 0, res));
+    EXPECT_EQ(res.code, SQLITE_MISUSE);
+
+    EXPECT_FALSE(ledger.adjustQuantity(999999, 1, res));
+    EXPECT_EQ(res.code, SQLITE_NOTFOUND);
+
+    // Failed movements leave no trace
+    EXPECT_EQ(quantityOf(id), 4);
+    EXPECT_EQ(db.countRows("StockMovements", ""), 0);
+
+    // Down to exactly zero is fine
+    ASSERT_TRUE(ledger.adjustQuantity(id, -4, StockMovementKind::Consume, "", after, res))
+        << res.toString();
+    EXPECT_EQ(after, 0);
+}
+
+// 3. AdjustBatch_KitIsAllOrNothing
+TEST_F(StockLedgerTest, AdjustBatch_KitIsAllOrNothing) {
+    const int a = addComponent("R10K", 100);
+    const int b = addComponent("C100N", 50);
+    const int c = addComponent("LED-RED", 1);
+
+    const std::vector<StockAdjustment> tooMany = { { a, -10 }, { b, -5 }, { c, -2 } };
+    EXPECT_FALSE(ledger.adjustBatch(tooMany, StockMovementKind::Consume, "kit B", res));
+    EXPECT_EQ(res.code, SQLITE_CONSTRAINT);
+    EXPECT_NE(res.toString().find(std::to_string(c)), std::string::npos) << res.toString();
+    EXPECT_EQ(quantityOf(a), 100);
+    EXPECT_EQ(quantityOf(b), 50);
+    EXPECT_EQ(db.countRows("StockMovements", ""), 0);
+
+    const std::vector<StockAdjustment> kit = { { a, -10 }, { b, -5 }, { c, -1 } };
+    ASSERT_TRUE(ledger.adjustBatch(kit, StockMovementKind::Consume, "kit B", res)) << res.toString();
+    EXPECT_EQ(quantityOf(a), 90);
+    EXPECT_EQ(quantityOf(b), 45);
+    EXPECT_EQ(quantityOf(c), 0);
+    EXPECT_EQ(db.countRows("StockMovements", "Reason = 'kit B'"), 3);
+}
+
+// 4. Ledger_IsAppendOnlyAndFollowsComponentDelete
+TEST_F(StockLedgerTest, Ledger_IsAppendOnlyAndFollowsComponentDelete) {
+    const int id = addComponent("BC547", 0);
+    ASSERT_TRUE(ledger.adjustQuantity(id, 25, res)) << res.toString();
+
+    EXPECT_FALSE(db.exec("UPDATE StockMovements SET Delta = 1000;", res));
+    EXPECT_EQ(db.countRows("StockMovements", "Delta = 25"), 1);
+
+    ASSERT_TRUE(compMgr.remove(id, res)) << res.toString();
+    EXPECT_EQ(db.countRows("StockMovements", ""), 0);
+}
+
+// 5. AdjustQuantity_ConcurrentConnectionsNeverLoseUpdates
+TEST(StockLedgerConcurrencyTest, AdjustQuantity_ConcurrentConnectionsNeverLoseUpdates) {
+    const std::string path = tempDbPath("inventory_stock_test.db");
+
+    DbResult res;
+    int id = 0;
+    {
+        Database db(path, DatabaseOptions::interactive(), res);
+        ASSERT_TRUE(SchemaManager(db).initialize(res)) << res.toString();
+        Component c("PICK-ME", "part", 1, 1, 1000);
+        ASSERT_TRUE(ComponentManager(db).add(c, res)) << res.toString();
+        id = c.id;
+    }
+
+    // Two pick stations, each with its own connection
+    constexpr int kPicks = 200;
+    auto station = [&] {
+        DbResult r;
+        Database db(path, DatabaseOptions::interactive(), r);
+        StockLedger ledger(db);
+        int after = 0;
+        for (int i = 0; i < kPicks; ++i)
+            EXPECT_TRUE(ledger.adjustQuantity(id, -1, StockMovementKind::Consume, "", after, r))
+                << r.toString();
+    };
+    std::thread first(station);
+    std::thread second(station);
+    first.join();
+    second.join();
+
+    Database db(path, DatabaseOptions::interactive(), res);
+    Component c;
+    ASSERT_TRUE(ComponentManager(db).getById(id, c, res)) << res.toString();
+    EXPECT_EQ(c.quantity, 1000 - 2 * kPicks);
+    EXPECT_EQ(db.countRows("StockMovements", ""), 2 * kPicks);
+}
@@ -0,0 +1,127 @@
+#include "BackendTestFixture.h"
+#include "ComponentManager.h"
+#include "Transaction.h"
+
+class TransactionTest : public BackendTestFixture {
+protected:
+    ComponentManager compMgr;
+    TransactionTest() : compMgr(db) {}
+
+    int componentCount() { return db.countRows("Components", ""); }
+};
+
+// 1. Commit_PersistsWrites
+TEST_F(TransactionTest, Commit_PersistsWrites) {
+    {
+        Transaction tx(db, res);
+        ASSERT_TRUE(tx.isActive()) << res.toString();
+        EXPECT_FALSE(tx.isNested());
+
+        Component c("TX1", "Committed", catId, manId, 1);
+        ASSERT_TRUE(compMgr.add(c, res)) << res.toString();
+        ASSERT_TRUE(tx.commit(res)) << res.toString();
+        EXPECT_FALSE(tx.isActive());
+    }
+
+    EXPECT_EQ(componentCount(), 1);
+    EXPECT_FALSE(db.inTransaction());
+}
+
+// 2. Destructor_RollsBackUncommittedWrites
+TEST_F(TransactionTest, Destructor_RollsBackUncommittedWrites) {
+    {
+        Transaction tx(db, res);
+        ASSERT_TRUE(tx.isActive()) << res.toString();
+
+        Component c("TX2", "Rolled back", catId, manId, 1);
+        ASSERT_TRUE(compMgr.add(c, res)) << res.toString();
+    }
+
+    EXPECT_EQ(componentCount(), 0);
+    EXPECT_FALSE(db.inTransaction());
+    EXPECT_EQ(db.transactionDepth(), 0);
+}
+
+// 3. Nested_InnerRollback_KeepsOuterWork
+TEST_F(TransactionTest, Nested_InnerRollback_KeepsOuterWork) {
+    Transaction outer(db, res);
+    ASSERT_TRUE(outer.isActive()) << res.toString();
+
+    Component kept("TX3A", "Outer", catId, manId, 1);
+    ASSERT_TRUE(compMgr.add(kept, res)) << res.toString();
+
+    {
+        Transaction inner(db, res);
+        ASSERT_TRUE(inner.isActive()) << res.toString();
+        EXPECT_TRUE(inner.isNested());
+        EXPECT_EQ(db.transactionDepth(), 2);
+
+        Component dropped("TX3B", "Inner", catId, manId, 1);
+        ASSERT_TRUE(compMgr.add(dropped, res)) << res.toString();
+        // no commit: savepoint rolled back
+    }
+
+    EXPECT_TRUE(db.inTransaction());
+    ASSERT_TRUE(outer.commit(res)) << res.toString();
+
+    EXPECT_EQ(componentCount(), 1);
+    EXPECT_TRUE(db.rowExists("Components", "PartNumber='TX3A'", res));
+}
+
+// 4. Nested_InnerCommit_RolledBackWithOuter
+TEST_F(TransactionTest, Nested_InnerCommit_RolledBackWithOuter) {
+    {
+        Transaction outer(db, res);
+        ASSERT_TRUE(outer.isActive()) << res.toString();
+
+        Transaction inner(db, res);
+        ASSERT_TRUE(inner.isActive()) << res.toString();
+
+        Component c("TX4", "Inner committed", catId, manId, 1);
+        ASSERT_TRUE(compMgr.add(c, res)) << res.toString();
+        ASSERT_TRUE(inner.commit(res)) << res.toString();
+        // outer never commits
+    }
+
+    EXPECT_EQ(componentCount(), 0);
+}
+
+// 5. InsideRawBegin_UsesSavepoint
+TEST_F(TransactionTest, InsideRawBegin_UsesSavepoint) {
+    ASSERT_TRUE(db.exec("BEGIN;", res));
+    {
+        Transaction tx(db, res);
+        ASSERT_TRUE(tx.isActive()) << res.toString();
+        EXPECT_TRUE(tx.isNested());
+        ASSERT_TRUE(tx.commit(res)) << res.toString();
+    }
+    EXPECT_TRUE(db.inTransaction());
+    ASSERT_TRUE(db.exec("COMMIT;", res));
+}
+
+// 6. Commit_WhenInactive_Fails
+TEST_F(TransactionTest, Commit_WhenInactive_Fails) {
+    Transaction tx(db, res);
+    ASSERT_TRUE(tx.isActive());
+    tx.rollback();
+
+    EXPECT_FALSE(tx.commit(res));
+    EXPECT_TRUE(res.hasError());
+}
+
+// 7. AddBatch_InsideTransaction_FailureUndoesOnlyBatch
+TEST_F(TransactionTest, AddBatch_InsideTransaction_FailureUndoesOnlyBatch) {
+    Transaction tx(db, res);
+    ASSERT_TRUE(tx.isActive());
+
+    Component kept("TX7", "Before batch", catId, manId, 1);
+    ASSERT_TRUE(compMgr.add(kept, res)) << res.toString();
+
+    std::vector<Component> batch;
+    batch.emplace_back("TX7A", "Good", catId, manId, 1);
+    batch.emplace_back("TX7B", "Bad category", 999999, manId, 1);
+    EXPECT_FALSE(compMgr.addBatch(batch, res));
+
+    ASSERT_TRUE(tx.commit(res)) << res.toString();
+    EXPECT_EQ(componentCount(), 1);
+}